@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <fstream>
 #include <map>
 #include <string>
@@ -8,6 +9,7 @@
 #include "grid_utilities.h"
 #include "editor_system.h"
 #include "world_system.h"
+#include "world_file.h"
 #include "object_system.h"
 #include "game_state.h"
 #include "game_macros.h"
@@ -35,6 +37,22 @@ static const std::vector<std::string> placeableMeshNames = {
   "column"
 };
 
+// The world file is cooked from the text files, which are
+// kept alongside it for diffing, and which it's reloaded
+// from whenever they change
+#define WORLD_FILE_PATH "./game/world/world.gworld"
+
+static const std::vector<std::string> worldTextFilePaths = {
+  "./game/world/grid_data.txt",
+  "./game/world/mesh_data.txt",
+  "./game/world/static_structure_data.txt",
+  "./game/world/light_data.txt"
+};
+
+// Collected while loading static structure data,
+// so the structures can be saved to the world file
+static std::vector<std::string> staticStructureMeshNames;
+
 #if DEVELOPMENT == 1
   static const std::map<std::string, Vec3f> meshPlacementOffsetMap = {
     { "dirt-floor", Vec3f(0, -HALF_TILE_SIZE, 0) },
@@ -52,26 +70,96 @@ static const std::vector<std::string> placeableMeshNames = {
     }
   }
 
+  // @todo define a map for this
+  static std::string getGridEntityMeshName(EntityType entityType) {
+    if (entityType == GROUND) return "ground";
+    if (entityType == STAIRCASE) return "staircase";
+    if (entityType == SWITCH) return "switch";
+    if (entityType == WORLD_ORIENTATION_CHANGE) return "trigger-indicator";
+    if (entityType == TELEPORTER) return "trigger-indicator";
+
+    return "";
+  }
+
   static void removeGridEntityObjectAtGridCoordinates(Globals, const GridCoordinates& coordinates) {
     auto& grid = state.world.grid;
     auto* entity = grid.get(coordinates);
 
-    if (entity == nullptr) {
+    // Ground doesn't have objects, and is rebuilt from
+    // the grid by updateGroundMesh() instead
+    if (entity == nullptr || entity->type == GROUND) {
       return;
     }
 
     auto objectPosition = gridCoordinatesToWorldPosition(coordinates);
-    std::string meshName;
+    auto* mesh = mesh(getGridEntityMeshName(entity->type));
 
-    // @todo define a map for this
-    if (entity->type == GROUND) meshName = "ground";
-    if (entity->type == STAIRCASE) meshName = "staircase";
-    if (entity->type == SWITCH) meshName = "switch";
-    if (entity->type == WORLD_ORIENTATION_CHANGE) meshName = "trigger-indicator";
+    removeObjectAtPosition(globals, mesh->objects, objectPosition);
+  }
 
-    auto* mesh = mesh(meshName);
+  /**
+   * Removes the objects for all grid entities along a ranged
+   * edit action, with one pass and one removeMany() per pool
+   * rather than a search + removal per grid tile.
+   */
+  static void removeGridEntityObjectsInRange(Globals, const GridCoordinates& start, const GridCoordinates& end) {
+    const static std::vector<std::string> gridEntityMeshNames = {
+      "staircase",
+      "switch",
+      "trigger-indicator"
+    };
 
-    removeObjectAtPosition(globals, mesh->objects, objectPosition);
+    auto& grid = state.world.grid;
+    bool hasEntitiesInRange = false;
+
+    overRange(start, end, {
+      if (grid.has({ x, y, z })) {
+        hasEntitiesInRange = true;
+      }
+    });
+
+    if (!hasEntitiesInRange) {
+      return;
+    }
+
+    // Matches the tiles visited by overRange(), i.e. those
+    // on the boundary of the range
+    auto isWithinRange = [&](const GridCoordinates& coordinates) {
+      return (
+        coordinates.x >= start.x && coordinates.x <= end.x &&
+        coordinates.y >= start.y && coordinates.y <= end.y &&
+        coordinates.z >= start.z && coordinates.z <= end.z && (
+          coordinates.x == start.x || coordinates.x == end.x ||
+          coordinates.y == start.y || coordinates.y == end.y ||
+          coordinates.z == start.z || coordinates.z == end.z
+        )
+      );
+    };
+
+    std::vector<u32> removedObjectIds;
+
+    for (auto& meshName : gridEntityMeshNames) {
+      auto& pool = objects(meshName);
+
+      removedObjectIds.clear();
+
+      for (auto& object : pool) {
+        auto coordinates = worldPositionToGridCoordinates(object.position);
+
+        if (
+          isWithinRange(coordinates) &&
+          grid.has(coordinates) &&
+          // Skip objects offset from the grid tile center,
+          // e.g. the entity placement preview
+          object.position == gridCoordinatesToWorldPosition(coordinates) &&
+          getGridEntityMeshName(grid.get(coordinates)->type) == meshName
+        ) {
+          removedObjectIds.push_back(object._record.id);
+        }
+      }
+
+      pool.removeMany(removedObjectIds);
+    }
   }
 
   static bool findGridEntityPlacementCoordinates(Globals, GridCoordinates& coordinates) {
@@ -151,22 +239,6 @@ static const std::vector<std::string> placeableMeshNames = {
     auto& editor = state.editor;
 
     if (editor.totalEditActions == MAX_EDIT_ACTIONS) {
-      auto& firstEditAction = editor.editActions[0];
-
-      // When shifting the first edit action off the queue,
-      // delete the old entity/replaced entity copies, since
-      // the action can no longer be undone, and those entities
-      // cannot be restored
-      if (firstEditAction.oldEntity != nullptr) {
-        delete firstEditAction.oldEntity;
-      } else if (firstEditAction.replacedEntityRecords.size() > 0) {
-        for (auto& record : firstEditAction.replacedEntityRecords) {
-          delete record.oldEntity;
-        }
-
-        firstEditAction.replacedEntityRecords.clear();
-      }
-
       // Move existing edit actions back one
       for (u8 i = 0; i < MAX_EDIT_ACTIONS - 1; i++) {
         editor.editActions[i] = editor.editActions[i + 1];
@@ -178,35 +250,6 @@ static const std::vector<std::string> placeableMeshNames = {
     editor.editActions[editor.totalEditActions++] = action;
   }
 
-  static GridEntity* copyGridEntity(const GridEntity* source) {
-    if (source == nullptr) {
-      return nullptr;
-    }
-
-    GridEntity* copy = nullptr;
-
-    switch (source->type) {
-      case GROUND:
-        copy = new Ground;
-        break;
-      case STAIRCASE:
-        copy = new Staircase((Staircase*)source);
-        break;
-      case SWITCH:
-        copy = new Switch;
-        break;
-      case WORLD_ORIENTATION_CHANGE:
-        copy = new WorldOrientationChange((WorldOrientationChange*)source);
-        break;
-      case TELEPORTER:
-        copy = new Teleporter((Teleporter*)source);
-      default:
-        break;
-    }
-
-    return copy;
-  }
-
   static void hideEntityPlacementPreview(Globals) {
     object("entity-preview").scale = 0.f;
     commit(object("entity-preview"));
@@ -240,7 +283,7 @@ static const std::vector<std::string> placeableMeshNames = {
     auto& editor = state.editor;
     GridCoordinates targetCoordinates;
     EditAction editAction;
-    GridEntity* newEntity = nullptr;
+    GridEntityRecord newEntity;
 
     if (editor.deleting) {
       if (!findGridEntityDeletionCoordinates(globals, targetCoordinates)) {
@@ -254,38 +297,35 @@ static const std::vector<std::string> placeableMeshNames = {
         return;
       }
 
+      newEntity.type = editor.currentSelectedEntityType;
+
       switch (editor.currentSelectedEntityType) {
-        case GROUND:
-          newEntity = new Ground;
-          break;
         case STAIRCASE:
-          newEntity = new Staircase;
-          ((Staircase*)newEntity)->orientation = editor.currentEntityOrientation;
+          newEntity.staircase = Staircase();
+          newEntity.staircase.orientation = editor.currentEntityOrientation;
           break;
         case SWITCH:
-          newEntity = new Switch;
+          newEntity.switchEntity = Switch();
           break;
         case WORLD_ORIENTATION_CHANGE:
-          newEntity = new WorldOrientationChange;
-          ((WorldOrientationChange*)newEntity)->targetWorldOrientation = editor.currentSelectedWorldOrientation;
+          newEntity.worldOrientationChange.targetWorldOrientation = editor.currentSelectedWorldOrientation;
           break;
         case TELEPORTER:
-          newEntity = new Teleporter;
-          ((Teleporter*)newEntity)->toCoordinates = editor.currentSelectedGridCoordinates;
-          ((Teleporter*)newEntity)->toOrientation = editor.currentSelectedWorldOrientation;
+          newEntity.teleporter.toCoordinates = editor.currentSelectedGridCoordinates;
+          newEntity.teleporter.toOrientation = editor.currentSelectedWorldOrientation;
         default:
           break;
       }
     }
 
-    editAction.oldEntity = copyGridEntity(grid.get(targetCoordinates));
+    editAction.oldEntity = grid.getRecord(targetCoordinates);
     editAction.coordinates = targetCoordinates;
 
     removeGridEntityObjectAtGridCoordinates(globals, targetCoordinates);
     grid.clear(targetCoordinates);
 
-    if (newEntity != nullptr) {
-      grid.set(targetCoordinates, newEntity);
+    if (newEntity.type != EMPTY) {
+      grid.setRecord(targetCoordinates, newEntity);
       createGridObjectFromCoordinates(globals, targetCoordinates);
     }
 
@@ -322,6 +362,8 @@ static const std::vector<std::string> placeableMeshNames = {
     action.rangeFrom = start;
     action.rangeTo = end;
 
+    removeGridEntityObjectsInRange(globals, start, end);
+
     overRange(start, end, {
       GridCoordinates coordinates = { x, y, z };
 
@@ -329,17 +371,15 @@ static const std::vector<std::string> placeableMeshNames = {
       if (grid.has(coordinates)) {
         action.replacedEntityRecords.push_back({
           coordinates,
-          copyGridEntity(grid.get(coordinates))
+          grid.getRecord(coordinates)
         });
       }
 
-      removeGridEntityObjectAtGridCoordinates(globals, coordinates);
-
       if (state.editor.deleting) {
         grid.clear(coordinates);
       } else {
         // @todo use entity corresponding to the current selected entity type
-        grid.set(coordinates, new Ground);
+        grid.set(coordinates, Ground());
         createGridObjectFromCoordinates(globals, coordinates);
       }
     });
@@ -857,31 +897,30 @@ static const std::vector<std::string> placeableMeshNames = {
 
     if (lastEditAction.isRangedPlacementAction) {
       // Remove objects/entities placed over the range
-      overRange(lastEditAction.rangeFrom, lastEditAction.rangeTo, {
-        GridCoordinates coordinates = { x, y, z };
+      removeGridEntityObjectsInRange(globals, lastEditAction.rangeFrom, lastEditAction.rangeTo);
 
-        removeGridEntityObjectAtGridCoordinates(globals, coordinates);
-        grid.clear(coordinates);
+      overRange(lastEditAction.rangeFrom, lastEditAction.rangeTo, {
+        grid.clear({ x, y, z });
       });
 
       // Restore the entities/objects replaced by the edit action
       for (auto& record : lastEditAction.replacedEntityRecords) {
-        grid.set(record.coordinates, record.oldEntity);
+        grid.setRecord(record.coordinates, record.oldEntity);
         createGridObjectFromCoordinates(globals, record.coordinates);
       }
 
       lastEditAction.replacedEntityRecords.clear();
     } else {
       auto& coordinates = lastEditAction.coordinates;
-      auto* oldEntity = lastEditAction.oldEntity;
+      auto& oldEntity = lastEditAction.oldEntity;
 
       // Undo the last entity/object placement
       removeGridEntityObjectAtGridCoordinates(globals, coordinates);
       grid.clear(coordinates);
 
-      if (oldEntity != nullptr) {
+      if (oldEntity.type != EMPTY) {
         // Restore the entity/object which existed before
-        grid.set(coordinates, oldEntity);
+        grid.setRecord(coordinates, oldEntity);
         createGridObjectFromCoordinates(globals, coordinates);
       }
     }
@@ -920,37 +959,36 @@ static const std::vector<std::string> placeableMeshNames = {
   #define wrap(n) n = n > Gm_TAU ? n - Gm_TAU : n < 0.f ? n + Gm_TAU : n
 
   void saveWorldGridData(Globals) {
+    auto& grid = state.world.grid;
     std::string serialized;
 
     serialized += "ground\n";
 
-    for (auto& [ coordinates, entity ] : state.world.grid) {
-      if (entity->type == GROUND) {
+    grid.forEach([&](const GridCoordinates& coordinates, const GridEntity& entity) {
+      if (entity.type == GROUND) {
         serialized += serialize3Vector(coordinates) + "\n";
       }
-    }
+    });
 
     serialized += "staircase\n";
 
-    for (auto& [ coordinates, entity ] : state.world.grid) {
-      if (entity->type == STAIRCASE) {
-        auto orientationAsVec3f = ((Staircase*)entity)->orientation.toVec3f();
+    auto& staircases = grid.getPool<Staircase>();
 
-        wrap(orientationAsVec3f.x);
-        wrap(orientationAsVec3f.y);
-        wrap(orientationAsVec3f.z);
+    for (u32 i = 0; i < staircases.records.size(); i++) {
+      auto orientationAsVec3f = staircases.records[i].orientation.toVec3f();
 
-        serialized += serialize3Vector(coordinates) + ",";
-        serialized += serialize3Vector(orientationAsVec3f) + "\n";
-      }
+      wrap(orientationAsVec3f.x);
+      wrap(orientationAsVec3f.y);
+      wrap(orientationAsVec3f.z);
+
+      serialized += serialize3Vector(staircases.coordinates[i]) + ",";
+      serialized += serialize3Vector(orientationAsVec3f) + "\n";
     }
 
     serialized += "switch\n";
 
-    for (auto& [ coordinates, entity ] : state.world.grid) {
-      if (entity->type == SWITCH) {
-        serialized += serialize3Vector(coordinates) + "\n";
-      }
+    for (auto& coordinates : grid.getPool<Switch>().coordinates) {
+      serialized += serialize3Vector(coordinates) + "\n";
     }
 
     serialized += "woc\n";
@@ -966,26 +1004,26 @@ static const std::vector<std::string> placeableMeshNames = {
       { NEGATIVE_Z_UP, "-Z" }
     };
 
-    for (auto& [ coordinates, entity ] : state.world.grid) {
-      if (entity->type == WORLD_ORIENTATION_CHANGE) {
-        auto worldOrientation = ((WorldOrientationChange*)entity)->targetWorldOrientation;
+    auto& worldOrientationChanges = grid.getPool<WorldOrientationChange>();
 
-        serialized += serialize3Vector(coordinates) + ",";
-        serialized += worldOrientationToString[worldOrientation] + "\n";
-      }
+    for (u32 i = 0; i < worldOrientationChanges.records.size(); i++) {
+      auto worldOrientation = worldOrientationChanges.records[i].targetWorldOrientation;
+
+      serialized += serialize3Vector(worldOrientationChanges.coordinates[i]) + ",";
+      serialized += worldOrientationToString[worldOrientation] + "\n";
     }
 
     serialized += "teleporter\n";
 
-    for (auto& [ coordinates, entity ] : state.world.grid) {
-      if (entity->type == TELEPORTER) {
-        auto toCoordinates = ((Teleporter*)entity)->toCoordinates;
-        auto toOrientation = ((Teleporter*)entity)->toOrientation;
+    auto& teleporters = grid.getPool<Teleporter>();
 
-        serialized += serialize3Vector(coordinates) + ",";
-        serialized += serialize3Vector(toCoordinates) + ",";
-        serialized += worldOrientationToString[toOrientation] + "\n";
-      }
+    for (u32 i = 0; i < teleporters.records.size(); i++) {
+      auto toCoordinates = teleporters.records[i].toCoordinates;
+      auto toOrientation = teleporters.records[i].toOrientation;
+
+      serialized += serialize3Vector(teleporters.coordinates[i]) + ",";
+      serialized += serialize3Vector(toCoordinates) + ",";
+      serialized += worldOrientationToString[toOrientation] + "\n";
     }
 
     Gm_WriteFileContents("./game/world/grid_data.txt", serialized);
@@ -1037,43 +1075,107 @@ static const std::vector<std::string> placeableMeshNames = {
 
     Gm_WriteFileContents("./game/world/light_data.txt", serialized.str());
   }
+
+  /**
+   * Cooks the world file from the world as loaded from the text
+   * files, so it never holds anything they don't. Saving any of
+   * the text files afterward changes their write times, and the
+   * world file is passed over until it's cooked again.
+   */
+  void saveWorldFile(Globals) {
+    WorldFileWriter writer;
+
+    writer.addGrid(state.world.grid);
+
+    for (auto& meshName : placeableMeshNames) {
+      auto& pool = objects(meshName);
+
+      writer.addObjects(WORLD_SECTION_MESH_OBJECTS, meshName, std::vector<Object>(pool.begin(), pool.end()));
+    }
+
+    for (auto& meshName : staticStructureMeshNames) {
+      auto& pool = objects(meshName);
+
+      writer.addObjects(WORLD_SECTION_STATIC_STRUCTURE_OBJECTS, meshName, std::vector<Object>(pool.begin(), pool.end()));
+    }
+
+    std::vector<Light> lights;
+
+    // Only keep what light_data.txt does
+    for (auto* light : context->scene.lights) {
+      if (light->serializable) {
+        Light serialized;
+
+        serialized.position = light->position;
+        serialized.color = light->color;
+        serialized.radius = light->radius;
+
+        lights.push_back(serialized);
+      }
+    }
+
+    writer.addLights(lights);
+    writer.write(WORLD_FILE_PATH, getWorldFileKey(worldTextFilePaths));
+  }
 #endif
 
 // @todo move everything below to world_system
-static void createObjectFromData(Globals, const std::vector<std::string>& data, const std::string& meshName) {
-  Vec3f position = {
-    stof(data[0]),
-    stof(data[1]),
-    stof(data[2])
-  };
+static void createObjectsFromData(Globals, const std::vector<std::string>& lines, const std::string& meshName) {
+  if (lines.size() == 0) {
+    return;
+  }
 
-  Vec3f rotation = {
-    stof(data[3]),
-    stof(data[4]),
-    stof(data[5])
-  };
+  // Create and commit each group of objects in bulk,
+  // rather than growing/updating the pool per line
+  auto span = createMeshObjects(globals, meshName, (u32)lines.size());
 
-  pVec4 color = {
-    (u8)stoi(data[6]),
-    (u8)stoi(data[7]),
-    (u8)stoi(data[8])
-  };
+  for (u32 i = 0; i < span.count; i++) {
+    auto data = Gm_SplitString(lines[i], ",");
+    auto& object = span[i];
 
-  Vec3f scale = stof(data[9]);
+    object.position = {
+      stof(data[0]),
+      stof(data[1]),
+      stof(data[2])
+    };
+
+    object.rotation = {
+      stof(data[3]),
+      stof(data[4]),
+      stof(data[5])
+    };
+
+    object.color = {
+      (u8)stoi(data[6]),
+      (u8)stoi(data[7]),
+      (u8)stoi(data[8])
+    };
 
-  auto& object = createMeshObject(globals, meshName);
+    object.scale = stof(data[9]);
 
-  if (meshName == "rosebush") {
-    // @todo manage this deterministically
-    rotation.y = Gm_Random(0.f, Gm_TAU);
+    if (meshName == "rosebush") {
+      // @todo manage this deterministically
+      object.rotation.y = Gm_Random(0.f, Gm_TAU);
+    }
   }
 
-  object.position = position;
-  object.rotation = rotation;
-  object.color = color;
-  object.scale = scale;
+  commitRange(span);
+}
+
+static void createObjectsFromSection(Globals, const std::string& meshName, const WorldFileObject* sectionObjects, u32 count) {
+  auto span = createMeshObjects(globals, meshName, count);
+
+  for (u32 i = 0; i < span.count; i++) {
+    auto& object = span[i];
+    auto& sectionObject = sectionObjects[i];
 
-  commit(object);
+    object.position = sectionObject.position;
+    object.scale = sectionObject.scale;
+    object.rotation = sectionObject.rotation;
+    object.color = sectionObject.color;
+  }
+
+  commitRange(span);
 }
 
 void loadWorldGridData(Globals) {
@@ -1118,45 +1220,47 @@ void loadWorldGridData(Globals) {
 
       switch (currentEntityType) {
         case GROUND:
-          grid.set({ x, y, z }, new Ground);
+          grid.set({ x, y, z }, Ground());
           break;
         case STAIRCASE: {
           auto pitch = stof(data[3]);
           auto yaw = stof(data[4]);
           auto roll = stof(data[5]);
-          auto* staircase = new Staircase;
+          Staircase staircase;
 
-          staircase->orientation = { roll, pitch, yaw };
+          staircase.orientation = { roll, pitch, yaw };
 
           grid.set({ x, y, z }, staircase);
           break;
         }
         case SWITCH:
-          grid.set({ x, y, z }, new Switch);
+          grid.set({ x, y, z }, Switch());
           break;
         case WORLD_ORIENTATION_CHANGE: {
           auto worldOrientation = stringToWorldOrientation[data[3]];
-          auto* worldOrientationChange = new WorldOrientationChange;
+          WorldOrientationChange worldOrientationChange;
 
-          worldOrientationChange->targetWorldOrientation = worldOrientation;
+          worldOrientationChange.targetWorldOrientation = worldOrientation;
 
           grid.set({ x, y, z }, worldOrientationChange);
           break;
         }
         case TELEPORTER: {
-          auto* teleporter = new Teleporter;
+          Teleporter teleporter;
 
-          teleporter->toCoordinates = {
+          teleporter.toCoordinates = {
             (s16)stoi(data[3]),
             (s16)stoi(data[4]),
             (s16)stoi(data[5])
           };
 
-          teleporter->toOrientation = stringToWorldOrientation[data[6]];
+          teleporter.toOrientation = stringToWorldOrientation[data[6]];
 
           grid.set({ x, y, z }, teleporter);
           break;
         }
+        default:
+          break;
       }
     }
   }
@@ -1173,17 +1277,21 @@ void loadMeshData(Globals) {
 
   std::string line;
   std::string currentMeshName;
+  std::vector<std::string> lines;
 
   while (std::getline(file, line)) {
     if (Gm_VectorContains(placeableMeshNames, line)) {
+      createObjectsFromData(globals, lines, currentMeshName);
+
       currentMeshName = line;
+      lines.clear();
     } else {
-      auto data = Gm_SplitString(line, ",");
-
-      createObjectFromData(globals, data, currentMeshName);
+      lines.push_back(line);
     }
   }
 
+  createObjectsFromData(globals, lines, currentMeshName);
+
   synchronizeCompoundMeshes(globals);
 }
 
@@ -1198,16 +1306,24 @@ void loadStaticStructureData(Globals) {
 
   std::string line;
   std::string currentMeshName;
+  std::vector<std::string> lines;
 
   while (std::getline(file, line)) {
     if (line[0] == '@') {
+      createObjectsFromData(globals, lines, currentMeshName);
+
       currentMeshName = line.substr(1);
-    } else {
-      auto data = Gm_SplitString(line, ",");
+      lines.clear();
 
-      createObjectFromData(globals, data, currentMeshName);
+      if (!Gm_VectorContains(staticStructureMeshNames, currentMeshName)) {
+        staticStructureMeshNames.push_back(currentMeshName);
+      }
+    } else {
+      lines.push_back(line);
     }
   }
+
+  createObjectsFromData(globals, lines, currentMeshName);
 }
 
 void loadLightData(Globals) {
@@ -1244,4 +1360,59 @@ void loadLightData(Globals) {
       light.radius = stof(data[6]);
     }
   }
+}
+
+/**
+ * Loads the world grid, mesh objects, static structures and lights
+ * from the world file, if it's intact and up to date with the text
+ * world data files. Returns false otherwise, in which case the text
+ * files should be loaded instead.
+ */
+bool loadWorldFile(Globals) {
+  if (!std::filesystem::exists(WORLD_FILE_PATH)) {
+    return false;
+  }
+
+  WorldFileReader file(WORLD_FILE_PATH, getWorldFileKey(worldTextFilePaths));
+
+  if (!file.isValid()) {
+    return false;
+  }
+
+  file.forEachSection([&](const WorldFileSection& section, const char* data) {
+    switch (section.type) {
+      case WORLD_SECTION_GRID_CHUNKS:
+      case WORLD_SECTION_GRID_RECORDS:
+        loadGridSection(state.world.grid, section, data);
+        break;
+      case WORLD_SECTION_STATIC_STRUCTURE_OBJECTS:
+        if (!Gm_VectorContains(staticStructureMeshNames, std::string(section.name))) {
+          staticStructureMeshNames.push_back(section.name);
+        }
+
+        createObjectsFromSection(globals, section.name, (const WorldFileObject*)data, section.count);
+        break;
+      case WORLD_SECTION_MESH_OBJECTS:
+        createObjectsFromSection(globals, section.name, (const WorldFileObject*)data, section.count);
+        break;
+      case WORLD_SECTION_LIGHTS: {
+        auto* lights = (const Light*)data;
+
+        // Lights are loaded as with loadLightData()
+        for (u32 i = 0; i < section.count; i++) {
+          auto& light = createLight(LightType::POINT);
+
+          light.position = lights[i].position;
+          light.color = lights[i].color;
+          light.radius = lights[i].radius;
+        }
+
+        break;
+      }
+    }
+  });
+
+  synchronizeCompoundMeshes(globals);
+
+  return true;
 }
\ No newline at end of file
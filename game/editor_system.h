@@ -25,7 +25,7 @@ const static std::vector<u8> editorEntityCycle = {
 
 struct ReplacedEntityRecord {
   GridCoordinates coordinates;
-  GridEntity* oldEntity = nullptr;
+  GridEntityRecord oldEntity;
 };
 
 struct EditAction : ReplacedEntityRecord {
@@ -98,10 +98,12 @@ struct WorldEditor {
   void saveWorldGridData(Globals);
   void saveMeshData(Globals);
   void saveLightData(Globals);
+  void saveWorldFile(Globals);
 #endif
 
 // @todo move these to world_system
 void loadWorldGridData(Globals);
 void loadMeshData(Globals);
 void loadStaticStructureData(Globals);
-void loadLightData(Globals);
\ No newline at end of file
+void loadLightData(Globals);
+bool loadWorldFile(Globals);
\ No newline at end of file
@@ -10,7 +10,9 @@ using namespace Gamma;
 
 #define clamp(value) value = value > 1.f ? 1.f : value < 0.f ? 0.f : value
 
-static void handleSwitchWhenActive(Globals, Switch* entity, float dt) {
+static void handleSwitchWhenActive(Globals, const GridCoordinates& coordinates, float dt) {
+  auto* entity = state.world.grid.get<Switch>(coordinates);
+
   if (
     state.lastPressedSwitch != nullptr &&
     state.lastPressedSwitch != entity
@@ -23,6 +25,7 @@ static void handleSwitchWhenActive(Globals, Switch* entity, float dt) {
   entity->pressedDuration += dt * 5.f;
 
   state.lastPressedSwitch = entity;
+  state.lastPressedSwitchCoordinates = coordinates;
 }
 
 static void handleLastPressedSwitchWhenInactive(Globals, float dt) {
@@ -33,8 +36,8 @@ static void handleLastPressedSwitch(Globals, Switch* entity) {
   clamp(state.lastPressedSwitch->pressedDuration);
 
   auto gridAlignedCameraPosition = getGridAlignedWorldPosition(getCamera().position);
-  auto& switchLight = light("switch-light");
-  auto& switchParticles = mesh("switch-particles")->particleSystem;
+  auto& switchLight = light(state.handles.switchLight);
+  auto& switchParticles = mesh(state.handles.switchParticles)->particleSystem;
   auto alpha = state.lastPressedSwitch->pressedDuration / 1.f;
 
   switchLight.position = gridAlignedCameraPosition;
@@ -52,13 +55,19 @@ static void handleLastPressedSwitch(Globals, Switch* entity) {
 }
 
 static void handleGridEntityBehavior(Globals, float dt) {
+  auto& grid = state.world.grid;
   auto currentGridCoordinates = worldPositionToGridCoordinates(getCamera().position);
   auto downGridCoordinates = getDownGridCoordinates(state.worldOrientationState.worldOrientation);
-  auto* entityBelow = state.world.grid.get(currentGridCoordinates + downGridCoordinates);
+  auto belowGridCoordinates = currentGridCoordinates + downGridCoordinates;
+  auto* entityBelow = grid.get(belowGridCoordinates);
+
+  if (state.lastPressedSwitch != nullptr) {
+    state.lastPressedSwitch = grid.get<Switch>(state.lastPressedSwitchCoordinates);
+  }
 
   // Handle switches
   if (entityBelow != nullptr && entityBelow->type == SWITCH) {
-    handleSwitchWhenActive(globals, (Switch*)entityBelow, dt);
+    handleSwitchWhenActive(globals, belowGridCoordinates, dt);
   } else if (state.lastPressedSwitch != nullptr) {
     handleLastPressedSwitchWhenInactive(globals, dt);
   }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 #include "grid_utilities.h"
 #include "orientation_system.h"
 
@@ -8,63 +10,77 @@ enum EntityType {
   STAIRCASE,
   SWITCH,
   WORLD_ORIENTATION_CHANGE,
-  TELEPORTER
+  TELEPORTER,
+  EMPTY
 };
 
 /**
  * Grid entities
  * -------------
+ *
+ * Each grid cell holds a GridEntity tag, which indexes into
+ * a dense pool of records for the entity's type. Records are
+ * trivially copyable; Ground has no record, and is only ever
+ * represented by its tag.
  */
 struct GridEntity {
-  EntityType type;
-
-  GridEntity(EntityType type): type(type) {};
-  virtual ~GridEntity() = default;
+  EntityType type : 8;
+  // Index into the grid's pool of records for the
+  // entity type (unused for entities without records)
+  u32 index : 24;
 };
 
-struct Ground : GridEntity {
-  Ground(): GridEntity(GROUND) {};
-};
+static_assert(sizeof(GridEntity) == 4, "GridEntity must be 4 bytes");
 
-struct Staircase : GridEntity {
-  Staircase(): GridEntity(STAIRCASE) {};
+struct Ground {
+  constexpr static EntityType TYPE = GROUND;
+};
 
-  Staircase(const Staircase* entity): Staircase() {
-    orientation = entity->orientation;
-  }
+struct Staircase {
+  constexpr static EntityType TYPE = STAIRCASE;
 
   Gamma::Orientation orientation;
 };
 
 // @todo support switches being permanently pressed down
-struct Switch : GridEntity {
-  Switch(): GridEntity(SWITCH) {};
+struct Switch {
+  constexpr static EntityType TYPE = SWITCH;
 
   float pressedDuration = 0.f;
 };
 
-struct WorldOrientationChange : GridEntity {
-  WorldOrientationChange(): GridEntity(WORLD_ORIENTATION_CHANGE) {};
-
-  WorldOrientationChange(const WorldOrientationChange* entity): WorldOrientationChange() {
-    targetWorldOrientation = entity->targetWorldOrientation;
-  }
+struct WorldOrientationChange {
+  constexpr static EntityType TYPE = WORLD_ORIENTATION_CHANGE;
 
   WorldOrientation targetWorldOrientation;
 };
 
-struct Teleporter : GridEntity {
-  Teleporter(): GridEntity(TELEPORTER) {};
-
-  Teleporter(const Teleporter* entity): Teleporter() {
-    toCoordinates = entity->toCoordinates;
-    toOrientation = entity->toOrientation;
-  }
+struct Teleporter {
+  constexpr static EntityType TYPE = TELEPORTER;
 
   GridCoordinates toCoordinates;
   WorldOrientation toOrientation;
 };
 
+/**
+ * A copy of any one grid entity, tagged with its type,
+ * e.g. for restoring replaced entities in the editor.
+ */
+struct GridEntityRecord {
+  EntityType type = EMPTY;
+
+  union {
+    Staircase staircase;
+    Switch switchEntity;
+    WorldOrientationChange worldOrientationChange;
+    Teleporter teleporter;
+  };
+
+  GridEntityRecord() {};
+};
+
+static_assert(std::is_trivially_copyable<GridEntityRecord>::value, "GridEntityRecord must be trivially copyable");
+
 /**
  * Dynamic entities
  * ----------------
@@ -3,9 +3,11 @@
 #include "game_init.h"
 #include "orientation_system.h"
 #include "world_system.h"
+#include "zone_system.h"
 #include "game_world.h"
 #include "object_system.h"
 #include "editor_system.h"
+#include "grid_benchmarks.h"
 #include "grid_utilities.h"
 #include "game_macros.h"
 #include "game_state.h"
@@ -19,9 +21,9 @@ static void addOrientationTestLayout(Globals) {
 
   // @todo define elsewhere
   auto createWorldOrientationChange = [context, &state](const GridCoordinates& coordinates, WorldOrientation target) {
-    auto* trigger = new WorldOrientationChange;
+    WorldOrientationChange trigger;
 
-    trigger->targetWorldOrientation = target;
+    trigger.targetWorldOrientation = target;
 
     state.world.grid.set(coordinates, trigger);
   };
@@ -47,70 +49,70 @@ static void addOrientationTestLayout(Globals) {
   // Pathway outdoors
   grid.clear({ 3, 1, -5 });
   grid.clear({ 3, 0, -5 });
-  grid.set({ 3, -1, -6 }, new Ground);
-  grid.set({ 3, -1, -7 }, new Ground);
-  grid.set({ 2, -1, -7 }, new Ground);
+  grid.set({ 3, -1, -6 }, Ground());
+  grid.set({ 3, -1, -7 }, Ground());
+  grid.set({ 2, -1, -7 }, Ground());
 
   createWorldOrientationChange({ 3, 1, -7 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 2, 1, -7 }, NEGATIVE_Z_UP);
 
   // Back to bottom staircase outdoors
-  grid.set({ 0, -1, -5 }, new Staircase);
+  grid.set({ 0, -1, -5 }, Staircase());
   grid.get<Staircase>({ 0, -1, -5 })->orientation.pitch = Gm_PI + Gm_PI / 2.f;
 
   createWorldOrientationChange({ 0, -1, -6 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ 0, -2, -5 }, NEGATIVE_Y_UP);
 
   // Back to top staircase outdoors
-  grid.set({ 0, 9, -5 }, new Staircase);
+  grid.set({ 0, 9, -5 }, Staircase());
 
   createWorldOrientationChange({ 0, 9, -6 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ 0, 10, -5 }, POSITIVE_Y_UP);
 
   // Back to left staircase outdoors
-  grid.set({ -5, 4, -5 }, new Staircase);
+  grid.set({ -5, 4, -5 }, Staircase());
   grid.get<Staircase>({ -5, 4, -5 })->orientation.roll = -Gm_PI / 2.f;
 
   createWorldOrientationChange({ -5, 4, -6 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ -6, 4, -5 }, NEGATIVE_X_UP);
 
   // Back to right staircase outdoors
-  grid.set({ 5, 4, -5 }, new Staircase);
+  grid.set({ 5, 4, -5 }, Staircase());
   grid.get<Staircase>({ 5, 4, -5 })->orientation.roll = Gm_PI / 2.f;
 
   createWorldOrientationChange({ 5, 4, -6 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ 6, 4, -5 }, POSITIVE_X_UP);
 
   // Top to left staircase outdoors
-  grid.set({ -5, 9, 0 }, new Staircase);
+  grid.set({ -5, 9, 0 }, Staircase());
   grid.get<Staircase>({ -5, 9, 0 })->orientation.yaw = Gm_PI / 2.f;
 
   createWorldOrientationChange({ -5, 10, 0 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ -6, 9, 0 }, NEGATIVE_X_UP);
 
   // Top to right staircase outdoors
-  grid.set({ 5, 9, 0 }, new Staircase);
+  grid.set({ 5, 9, 0 }, Staircase());
   grid.get<Staircase>({ 5, 9, 0 })->orientation.yaw = -Gm_PI / 2.f;
 
   createWorldOrientationChange({ 5, 10, 0 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 6, 9, 0 }, POSITIVE_X_UP);
 
   // Top to front staircase outdoors
-  grid.set({ 0, 9, 5 }, new Staircase);
+  grid.set({ 0, 9, 5 }, Staircase());
   grid.get<Staircase>({ 0, 9, 5 })->orientation.pitch = Gm_PI / 2.f;
 
   createWorldOrientationChange({ 0, 10, 5 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 0, 9, 6 }, POSITIVE_Z_UP);
 
   // Front to bottom staircase outdoors
-  grid.set({ 0, -1, 5 }, new Staircase);
+  grid.set({ 0, -1, 5 }, Staircase());
   grid.get<Staircase>({ 0, -1, 5 })->orientation.pitch = Gm_PI;
 
   createWorldOrientationChange({ 0, -1, 6 }, POSITIVE_Z_UP);
   createWorldOrientationChange({ 0, -2, 5 }, NEGATIVE_Y_UP);
 
   // Bottom to right staircase outdoors
-  grid.set({ 5, -1, 0 }, new Staircase);
+  grid.set({ 5, -1, 0 }, Staircase());
   grid.get<Staircase>({ 5, -1, 0 })->orientation.roll = Gm_PI / 2.f;
   grid.get<Staircase>({ 5, -1, 0 })->orientation.yaw = -Gm_PI / 2.f;
 
@@ -118,7 +120,7 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ 6, -1, 0 }, POSITIVE_X_UP);
 
   // Bottom to left staircase outdoors
-  grid.set({ -5, -1, 0 }, new Staircase);
+  grid.set({ -5, -1, 0 }, Staircase());
   grid.get<Staircase>({ -5, -1, 0 })->orientation.roll = -Gm_PI / 2.f;
   grid.get<Staircase>({ -5, -1, 0 })->orientation.yaw = Gm_PI / 2.f;
 
@@ -126,7 +128,7 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ -6, -1, 0 }, NEGATIVE_X_UP);
 
   // Right to front staircase outdoors
-  grid.set({ 5, 4, 5 }, new Staircase);
+  grid.set({ 5, 4, 5 }, Staircase());
   grid.get<Staircase>({ 5, 4, 5 })->orientation.pitch = Gm_PI / 2.f;
   grid.get<Staircase>({ 5, 4, 5 })->orientation.yaw = -Gm_PI / 2.f;
 
@@ -134,7 +136,7 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ 5, 4, 6 }, POSITIVE_Z_UP);
 
   // Left to front staircase outdoors
-  grid.set({ -5, 4, 5 }, new Staircase);
+  grid.set({ -5, 4, 5 }, Staircase());
   grid.get<Staircase>({ -5, 4, 5 })->orientation.pitch = Gm_PI / 2.f;
   grid.get<Staircase>({ -5, 4, 5 })->orientation.yaw = Gm_PI / 2.f;
 
@@ -142,65 +144,65 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ -5, 4, 6 }, POSITIVE_Z_UP);
 
   // Bottom to front staircase
-  grid.set({ 0, 0, 2 }, new Staircase);
-  grid.set({ 0, 1, 3 }, new Staircase);
-  grid.set({ 0, 2, 4 }, new Staircase);
+  grid.set({ 0, 0, 2 }, Staircase());
+  grid.set({ 0, 1, 3 }, Staircase());
+  grid.set({ 0, 2, 4 }, Staircase());
 
   createWorldOrientationChange({ 0, 1, 2 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 0, 2, 3 }, NEGATIVE_Z_UP);
 
   // Bottom to left staircase
-  grid.set({ -2, 0, 0 }, new Staircase);
+  grid.set({ -2, 0, 0 }, Staircase());
   grid.get<Staircase>({ -2, 0, 0 })->orientation.yaw = -Gm_PI / 2.f;
-  grid.set({ -3, 1, 0 }, new Staircase);
+  grid.set({ -3, 1, 0 }, Staircase());
   grid.get<Staircase>({ -3, 1, 0 })->orientation.yaw = -Gm_PI / 2.f;
-  grid.set({ -4, 2, 0 }, new Staircase);
+  grid.set({ -4, 2, 0 }, Staircase());
   grid.get<Staircase>({ -4, 2, 0 })->orientation.yaw = -Gm_PI / 2.f;
 
   createWorldOrientationChange({ -2, 1, 0 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ -3, 2, 0 }, POSITIVE_X_UP);
 
   // Bottom to right staircase
-  grid.set({ 2, 0, 0 }, new Staircase);
+  grid.set({ 2, 0, 0 }, Staircase());
   grid.get<Staircase>({ 2, 0, 0 })->orientation.yaw = Gm_PI / 2.f;
-  grid.set({ 3, 1, 0 }, new Staircase);
+  grid.set({ 3, 1, 0 }, Staircase());
   grid.get<Staircase>({ 3, 1, 0 })->orientation.yaw = Gm_PI / 2.f;
-  grid.set({ 4, 2, 0 }, new Staircase);
+  grid.set({ 4, 2, 0 }, Staircase());
   grid.get<Staircase>({ 4, 2, 0 })->orientation.yaw = Gm_PI / 2.f;
 
   createWorldOrientationChange({ 2, 1, 0 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 3, 2, 0 }, NEGATIVE_X_UP);
 
   // Bottom to back staircase
-  grid.set({ 0, 0, -2 }, new Staircase);
+  grid.set({ 0, 0, -2 }, Staircase());
   grid.get<Staircase>({ 0, 0, -2 })->orientation.yaw = Gm_PI;
-  grid.set({ 0, 1, -3 }, new Staircase);
+  grid.set({ 0, 1, -3 }, Staircase());
   grid.get<Staircase>({ 0, 1, -3 })->orientation.yaw = Gm_PI;
-  grid.set({ 0, 2, -4 }, new Staircase);
+  grid.set({ 0, 2, -4 }, Staircase());
   grid.get<Staircase>({ 0, 2, -4 })->orientation.yaw = Gm_PI;
 
   createWorldOrientationChange({ 0, 1, -2 }, POSITIVE_Y_UP);
   createWorldOrientationChange({ 0, 2, -3 }, POSITIVE_Z_UP);
 
   // Left to front staircase
-  grid.set({ -4, 4, 2 }, new Staircase);
+  grid.set({ -4, 4, 2 }, Staircase());
   grid.get<Staircase>({ -4, 4, 2 })->orientation.roll = Gm_PI / 2.f;
-  grid.set({ -3, 4, 3 }, new Staircase);
+  grid.set({ -3, 4, 3 }, Staircase());
   grid.get<Staircase>({ -3, 4, 3 })->orientation.roll = Gm_PI / 2.f;
-  grid.set({ -2, 4, 4 }, new Staircase);
+  grid.set({ -2, 4, 4 }, Staircase());
   grid.get<Staircase>({ -2, 4, 4 })->orientation.roll = Gm_PI / 2.f;
 
   createWorldOrientationChange({ -2, 4, 3 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ -3, 4, 2 }, POSITIVE_X_UP);
 
   // Left to back staircase
-  grid.set({ -4, 4, -2 }, new Staircase);
+  grid.set({ -4, 4, -2 }, Staircase());
   grid.get<Staircase>({ -4, 4, -2 })->orientation.roll = Gm_PI / 2.f;
   grid.get<Staircase>({ -4, 4, -2 })->orientation.yaw = Gm_PI;
-  grid.set({ -3, 4, -3 }, new Staircase);
+  grid.set({ -3, 4, -3 }, Staircase());
   grid.get<Staircase>({ -3, 4, -3 })->orientation.roll = Gm_PI / 2.f;
   grid.get<Staircase>({ -3, 4, -3 })->orientation.yaw = Gm_PI;
-  grid.set({ -2, 4, -4 }, new Staircase);
+  grid.set({ -2, 4, -4 }, Staircase());
   grid.get<Staircase>({ -2, 4, -4 })->orientation.roll = Gm_PI / 2.f;
   grid.get<Staircase>({ -2, 4, -4 })->orientation.yaw = Gm_PI;
 
@@ -208,13 +210,13 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ -2, 4, -3 }, POSITIVE_Z_UP);
 
   // Left to top staircase
-  grid.set({ -4, 6, 0 }, new Staircase);
+  grid.set({ -4, 6, 0 }, Staircase());
   grid.get<Staircase>({ -4, 6, 0 })->orientation.yaw = -Gm_PI / 2.f;
   grid.get<Staircase>({ -4, 6, 0 })->orientation.roll = Gm_PI / 2.f;
-  grid.set({ -3, 7, 0 }, new Staircase);
+  grid.set({ -3, 7, 0 }, Staircase());
   grid.get<Staircase>({ -3, 7, 0 })->orientation.yaw = -Gm_PI / 2.f;
   grid.get<Staircase>({ -3, 7, 0 })->orientation.roll = Gm_PI / 2.f;
-  grid.set({ -2, 8, 0 }, new Staircase);
+  grid.set({ -2, 8, 0 }, Staircase());
   grid.get<Staircase>({ -2, 8, 0 })->orientation.yaw = -Gm_PI / 2.f;
   grid.get<Staircase>({ -2, 8, 0 })->orientation.roll = Gm_PI / 2.f;
 
@@ -222,35 +224,35 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ -2, 7, 0 }, NEGATIVE_Y_UP);
 
   // Front to right staircase
-  grid.set({ 2, 4, 4 }, new Staircase);
+  grid.set({ 2, 4, 4 }, Staircase());
   grid.get<Staircase>({ 2, 4, 4 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 3, 4, 3 }, new Staircase);
+  grid.set({ 3, 4, 3 }, Staircase());
   grid.get<Staircase>({ 3, 4, 3 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 4, 4, 2 }, new Staircase);
+  grid.set({ 4, 4, 2 }, Staircase());
   grid.get<Staircase>({ 4, 4, 2 })->orientation.roll = -Gm_PI / 2.f;
 
   createWorldOrientationChange({ 3, 4, 2 }, NEGATIVE_X_UP);
   createWorldOrientationChange({ 2, 4, 3 }, NEGATIVE_Z_UP);
 
   // Front to top staircase
-  grid.set({ 0, 6, 4 }, new Staircase);
+  grid.set({ 0, 6, 4 }, Staircase());
   grid.get<Staircase>({ 0, 6, 4 })->orientation.pitch = -Gm_PI / 2.f;
-  grid.set({ 0, 7, 3 }, new Staircase);
+  grid.set({ 0, 7, 3 }, Staircase());
   grid.get<Staircase>({ 0, 7, 3 })->orientation.pitch = -Gm_PI / 2.f;
-  grid.set({ 0, 8, 2 }, new Staircase);
+  grid.set({ 0, 8, 2 }, Staircase());
   grid.get<Staircase>({ 0, 8, 2 })->orientation.pitch = -Gm_PI / 2.f;
 
   createWorldOrientationChange({ 0, 6, 3 }, NEGATIVE_Z_UP);
   createWorldOrientationChange({ 0, 7, 2 }, NEGATIVE_Y_UP);
 
   // Right to top staircase
-  grid.set({ 4, 6, 0 }, new Staircase);
+  grid.set({ 4, 6, 0 }, Staircase());
   grid.get<Staircase>({ 4, 6, 0 })->orientation.yaw = Gm_PI / 2.f;
   grid.get<Staircase>({ 4, 6, 0 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 3, 7, 0 }, new Staircase);
+  grid.set({ 3, 7, 0 }, Staircase());
   grid.get<Staircase>({ 3, 7, 0 })->orientation.yaw = Gm_PI / 2.f;
   grid.get<Staircase>({ 3, 7, 0 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 2, 8, 0 }, new Staircase);
+  grid.set({ 2, 8, 0 }, Staircase());
   grid.get<Staircase>({ 2, 8, 0 })->orientation.yaw = Gm_PI / 2.f;
   grid.get<Staircase>({ 2, 8, 0 })->orientation.roll = -Gm_PI / 2.f;
 
@@ -258,13 +260,13 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ 2, 7, 0 }, NEGATIVE_Y_UP);
 
   // Back to top staircase
-  grid.set({ 0, 6, -4 }, new Staircase);
+  grid.set({ 0, 6, -4 }, Staircase());
   grid.get<Staircase>({ 0, 6, -4 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 0, 6, -4 })->orientation.pitch = Gm_PI / 2.f;
-  grid.set({ 0, 7, -3 }, new Staircase);
+  grid.set({ 0, 7, -3 }, Staircase());
   grid.get<Staircase>({ 0, 7, -3 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 0, 7, -3 })->orientation.pitch = Gm_PI / 2.f;
-  grid.set({ 0, 8, -2 }, new Staircase);
+  grid.set({ 0, 8, -2 }, Staircase());
   grid.get<Staircase>({ 0, 8, -2 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 0, 8, -2 })->orientation.pitch = Gm_PI / 2.f;
 
@@ -272,13 +274,13 @@ static void addOrientationTestLayout(Globals) {
   createWorldOrientationChange({ 0, 6, -3 }, POSITIVE_Z_UP);
 
   // Back to right staircase
-  grid.set({ 2, 4, -4 }, new Staircase);
+  grid.set({ 2, 4, -4 }, Staircase());
   grid.get<Staircase>({ 2, 4, -4 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 2, 4, -4 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 3, 4, -3 }, new Staircase);
+  grid.set({ 3, 4, -3 }, Staircase());
   grid.get<Staircase>({ 3, 4, -3 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 3, 4, -3 })->orientation.roll = -Gm_PI / 2.f;
-  grid.set({ 4, 4, -2 }, new Staircase);
+  grid.set({ 4, 4, -2 }, Staircase());
   grid.get<Staircase>({ 4, 4, -2 })->orientation.yaw = Gm_PI;
   grid.get<Staircase>({ 4, 4, -2 })->orientation.roll = -Gm_PI / 2.f;
 
@@ -328,6 +330,23 @@ static void addParticles(Globals) {
   particles.spawn = gridCoordinatesToWorldPosition({ 2, -2, -7 });
 }
 
+static void resolveSceneHandles(Globals) {
+  auto& handles = state.handles;
+
+  handles.tulips = meshHandle("tulips");
+  handles.tulipPetals = meshHandle("tulip-petals");
+  handles.archVines = meshHandle("arch-vines");
+  handles.rosebush = meshHandle("rosebush");
+  handles.rosebushFlowers = meshHandle("rosebush-flowers");
+  handles.switchParticles = meshHandle("switch-particles");
+  handles.switchLight = lightHandle("switch-light");
+
+  #if DEVELOPMENT == 1
+    handles.triggerIndicator = meshHandle("trigger-indicator");
+    handles.lightIndicator = meshHandle("light-indicator");
+  #endif
+}
+
 static void addKeyHandlers(Globals) {
   auto& input = getInput();
 
@@ -355,9 +374,9 @@ static void addKeyHandlers(Globals) {
 static void createGridEntityObjects(Globals) {
   auto& grid = state.world.grid;
 
-  for (auto& [ coordinates, entity ] : grid) {
+  grid.forEach([&](const GridCoordinates& coordinates, const GridEntity& entity) {
     createGridObjectFromCoordinates(globals, coordinates);
-  }
+  });
 
   #if DEVELOPMENT == 1
     // @todo move to editor_system
@@ -367,6 +386,23 @@ static void createGridEntityObjects(Globals) {
 
     saveObject("entity-preview", preview);
     commit(preview);
+
+    // Ground geometry is built in world space,
+    // so it only needs a single object at the origin
+    auto& ground = createObjectFrom("ground-chunks");
+
+    ground.position = Vec3f(0.f);
+    ground.scale = Vec3f(1.f);
+    ground.color = getGridObjectParameters(GROUND).color;
+
+    commit(ground);
+
+    updateGroundMesh(globals);
+
+    Console::log(
+      "Built ground mesh:", state.world.groundMesher.getTotalTriangles(), "triangles",
+      "(" + std::to_string(grid.count<Ground>() * 12), "as cubes)"
+    );
   #endif
 }
 
@@ -471,7 +507,7 @@ void initializeGame(Globals) {
       }
 
       if (key == Key::M) {
-        mesh("ground")->disabled = !mesh("ground")->disabled;
+        mesh("ground-chunks")->disabled = !mesh("ground-chunks")->disabled;
 
         context->renderer->resetShadowMaps();
       }
@@ -644,6 +680,21 @@ void initializeGame(Globals) {
 
           state.editor.currentSelectedGridCoordinates = { x, y, z };
         }
+      } else if (Gm_StringStartsWith(command, "benchmark")) {
+        // @todo handleBenchmarkCommand()
+        auto parts = Gm_SplitString(command, " ");
+
+        if (parts.size() > 1 && parts[1] == "culling") {
+          Gm_BenchmarkCulling();
+        } else if (parts.size() > 1 && parts[1] == "obj") {
+          Gm_BenchmarkObjLoading({
+            "./game/models/rosebush-flowers.obj",
+            "./game/models/rock.obj",
+            "./game/models/tulips.obj"
+          });
+        } else if (parts.size() > 1 && parts[1] == "grid") {
+          benchmarkGridLookups(globals);
+        }
       }
     });
   #endif
@@ -653,15 +704,29 @@ void initializeGame(Globals) {
   addSwitchEntityEffects(globals);
   addParticles(globals);  // @temporary
   addKeyHandlers(globals);
+  resolveSceneHandles(globals);
   // addOrientationTestLayout(globals);
 
-  loadWorldGridData(globals);
-  loadMeshData(globals);
-  loadStaticStructureData(globals);
-  loadLightData(globals);
+  if (!loadWorldFile(globals)) {
+    loadWorldGridData(globals);
+    loadMeshData(globals);
+    loadStaticStructureData(globals);
+    loadLightData(globals);
+
+    #if DEVELOPMENT == 1
+      // Cook the text world data, so it can be
+      // loaded directly from now on
+      saveWorldFile(globals);
+    #endif
+  }
 
   createGridEntityObjects(globals);
 
+  // Release any excess pool capacity left over from loading
+  for (auto* mesh : context->scene.meshes) {
+    mesh->objects.shrinkToFit();
+  }
+
   auto& moonlight = createLight(DIRECTIONAL_SHADOWCASTER);
 
   moonlight.direction = Vec3f(0.3f, 0.5f, 1.f).invert();
@@ -671,6 +736,11 @@ void initializeGame(Globals) {
   camera.position = gridCoordinatesToWorldPosition({ 2, -2, -14 });
   camera.fov = 55.f;
 
+  // Load the zones around the starting position before
+  // the first frame, leaving the rest to stream in
+  handleZonesOnUpdate(globals);
+  Gm_WaitForStreamedMeshes(context);
+
   auto& cameraLight = createLight(POINT);
 
   cameraLight.color = Vec3f(1.f, 0.8f, 0.5f);
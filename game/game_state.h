@@ -16,6 +16,22 @@ struct CameraState {
   Gamma::Orientation orientationTo;
 };
 
+/**
+ * Scene handles resolved during initialization,
+ * for name-free mesh/light access in update code
+ */
+struct SceneHandles {
+  Gamma::MeshHandle tulips;
+  Gamma::MeshHandle tulipPetals;
+  Gamma::MeshHandle archVines;
+  Gamma::MeshHandle rosebush;
+  Gamma::MeshHandle rosebushFlowers;
+  Gamma::MeshHandle triggerIndicator;
+  Gamma::MeshHandle lightIndicator;
+  Gamma::MeshHandle switchParticles;
+  Gamma::LightHandle switchLight;
+};
+
 struct GameState {
   // Tracking variables
   float lastMoveInputTime = 0.f;
@@ -28,9 +44,14 @@ struct GameState {
   CameraState cameraState;
 
   // Entity behavior
+  // Switch records may move as the grid is edited, so the
+  // last pressed switch is found again by its coordinates
   Switch* lastPressedSwitch = nullptr;
+  GridCoordinates lastPressedSwitchCoordinates;
   Gamma::Light* cameraLight = nullptr;
 
+  SceneHandles handles;
+
   #if DEVELOPMENT == 1
     WorldEditor editor;
     Gamma::Vec3f cameraStartPosition;
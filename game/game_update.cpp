@@ -6,12 +6,16 @@
 #include "entity_system.h"
 #include "zone_system.h"
 #include "editor_system.h"
+#include "object_system.h"
 #include "game_state.h"
 #include "game_macros.h"
 #include "build_flags.h"
 
 using namespace Gamma;
 
+// Distance covered by each level of detail for foliage meshes
+constexpr static float FOLIAGE_LOD_DISTANCE = TILE_SIZE * 4.f;
+
 #if DEVELOPMENT == 1
   static std::string worldOrientationToString(WorldOrientation worldOrientation) {
     switch (worldOrientation) {
@@ -83,6 +87,21 @@ static void handleCameraLightOnUpdate(Globals) {
   state.cameraLight->position = position;
 }
 
+static void handleLevelsOfDetailOnUpdate(Globals) {
+  auto& handles = state.handles;
+
+  // Foliage meshes are given generated levels of detail
+  // (see game_world.cpp); this runs after any visibility
+  // culling so only visible objects are partitioned
+  useLodByDistance(FOLIAGE_LOD_DISTANCE, {
+    handles.tulips,
+    handles.tulipPetals,
+    handles.archVines,
+    handles.rosebush,
+    handles.rosebushFlowers
+  });
+}
+
 void updateGame(Globals, float dt) {
   #if DEVELOPMENT == 1
     if (Gm_IsFlagEnabled(FREE_CAMERA_MODE)) {
@@ -121,19 +140,24 @@ void updateGame(Globals, float dt) {
       }
     }
 
+    // Pick up any grid edits made by the editor
+    updateGroundMesh(globals);
+
     // @todo create a separate routine for object/visibility culling behaviors
+    auto& handles = state.handles;
+
     if (state.editor.enabled) {
-      objects("tulips").showAll();
-      objects("tulip-petals").showAll();
+      objects(handles.tulips).showAll();
+      objects(handles.tulipPetals).showAll();
     } else {
       useFrustumCulling({
-        "tulips",
-        "tulip-petals"
+        handles.tulips,
+        handles.tulipPetals
       });
     }
 
-    mesh("trigger-indicator")->disabled = !state.editor.enabled;
-    mesh("light-indicator")->disabled = !state.editor.enabled;
+    mesh(handles.triggerIndicator)->disabled = !state.editor.enabled;
+    mesh(handles.lightIndicator)->disabled = !state.editor.enabled;
 
     // @todo we may actually have use for camera warp-to behavior
     // during gameplay, so it may be useful to extract this into
@@ -152,4 +176,6 @@ void updateGame(Globals, float dt) {
 
     addDebugMessages(globals);
   #endif
+
+  handleLevelsOfDetailOnUpdate(globals);
 }
\ No newline at end of file
@@ -15,11 +15,40 @@ using namespace Gamma;
 
 struct MeshBuilder {
   std::string meshName;
-  u16 maxInstances;
+  u32 maxInstances;
   std::function<Mesh*()> createMesh;
   std::function<void(Mesh&)> configureMesh = nullptr;
 };
 
+// Untextured models can weld together vertices split by UV seams
+const static ModelOptions untexturedModelOptions = []() {
+  ModelOptions options;
+
+  options.weldDistance = 0.001f;
+
+  return options;
+}();
+
+// Foliage is numerous and finely detailed, so generate
+// lower levels of detail to draw at a distance, and pack
+// its vertices into the quantized format
+const static ModelOptions foliageModelOptions = []() {
+  ModelOptions options;
+
+  options.lodRatios = { 0.5f, 0.25f };
+  options.quantizeVertices = true;
+
+  return options;
+}();
+
+const static ModelOptions untexturedFoliageModelOptions = []() {
+  ModelOptions options = foliageModelOptions;
+
+  options.weldDistance = untexturedModelOptions.weldDistance;
+
+  return options;
+}();
+
 const static std::vector<MeshBuilder> meshBuilders = {
   {
     "dirt-floor", 0xffff, create(Plane(2)),
@@ -42,7 +71,7 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "rock", 1000, create(Model("./game/models/rock.obj"))
+    "rock", 1000, create(Model("./game/models/rock.obj", untexturedModelOptions))
   },
   {
     "arch", 1000, create(Model("./game/models/arch.obj")),
@@ -52,7 +81,7 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "arch-vines", 1000, create(Model("./game/models/arch-vines.obj")),
+    "arch-vines", 1000, create(Model("./game/models/arch-vines.obj", untexturedFoliageModelOptions)),
     configure() {
       m.type = MeshType::FOLIAGE;
       m.foliage.type = FoliageType::LEAF;
@@ -60,14 +89,14 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "tulips", 1000, create(Model("./game/models/tulips.obj")),
+    "tulips", 1000, create(Model("./game/models/tulips.obj", foliageModelOptions)),
     configure() {
       m.type = MeshType::FOLIAGE;
       m.foliage.type = FoliageType::FLOWER;
     }
   },
   {
-    "tulip-petals", 1000, create(Model("./game/models/tulip-petals.obj")),
+    "tulip-petals", 1000, create(Model("./game/models/tulip-petals.obj", untexturedFoliageModelOptions)),
     configure() {
       m.type = MeshType::FOLIAGE;
       m.foliage.type = FoliageType::FLOWER;
@@ -81,10 +110,10 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "stone-tile", 1000, create(Model("./game/models/stone-tile.obj"))
+    "stone-tile", 1000, create(Model("./game/models/stone-tile.obj", untexturedModelOptions))
   },
   {
-    "rosebush", 1000, create(Model("./game/models/rosebush-leaves.obj")),
+    "rosebush", 1000, create(Model("./game/models/rosebush-leaves.obj", foliageModelOptions)),
     configure() {
       m.type = MeshType::FOLIAGE;
       m.foliage.type = FoliageType::FLOWER;
@@ -93,7 +122,7 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "rosebush-flowers", 1000, create(Model("./game/models/rosebush-flowers.obj")),
+    "rosebush-flowers", 1000, create(Model("./game/models/rosebush-flowers.obj", foliageModelOptions)),
     configure() {
       m.type = MeshType::FOLIAGE;
       m.foliage.type = FoliageType::FLOWER;
@@ -110,7 +139,7 @@ const static std::vector<MeshBuilder> meshBuilders = {
     }
   },
   {
-    "gate", 250, create(Model("./game/models/gate.obj"))
+    "gate", 250, create(Model("./game/models/gate.obj", untexturedModelOptions))
   },
   {
     "tile-1", 0xffff, create(Plane(2)),
@@ -124,42 +153,10 @@ const static std::vector<MeshBuilder> meshBuilders = {
   }
 };
 
-void addMeshes(Globals) {
-  // Grid entity objects
-  addMesh("ground", 0xffff, Mesh::Cube());
-  mesh("ground")->canCastShadows = false;
-  addMesh("staircase", 0xffff, Mesh::Model("./game/models/staircase.obj"));
-  addMesh("switch", 1000, Mesh::Model("./game/models/switch.obj"));
-
-  // Placeable meshes
-  for (auto& builder : meshBuilders) {
-    addMesh(builder.meshName, builder.maxInstances, builder.createMesh());
-
-    if (builder.configureMesh != nullptr) {
-      builder.configureMesh(*mesh(builder.meshName));
-    }
-  }
-
-  // Static world structures
-  addMesh("potm-facade", 1, Mesh::Model("./game/models/potm-facade.obj"));
-
-  #if DEVELOPMENT == 1
-    // Trigger entity indicators
-    addMesh("trigger-indicator", 0xffff, Mesh::Cube());
-    mesh("trigger-indicator")->disabled = true;
-
-    // Light indicators
-    addMesh("light-indicator", 1000, Mesh::Cube());  // @todo Mesh::Sphere()
-    mesh("light-indicator")->type = MeshType::EMISSIVE;
-    mesh("light-indicator")->disabled = true;
-
-    // Ranged placement preview
-    addMesh("range-preview", 0xffff, Mesh::Cube());
-  #endif
-}
-
-void addZones(Globals) {
-  Zone z1 = {
+// Meshes belonging to a zone are streamed in
+// and out as the camera approaches/leaves it
+const static std::vector<Zone> zones = {
+  {
     "Lunar Garden",
     { -5, -5, -20 },
     { 10, 7, 26 },
@@ -180,9 +177,8 @@ void addZones(Globals) {
       "gate",
       "potm-facade"
     }
-  };
-
-  Zone z2 = {
+  },
+  {
     "Palace of the Moon",
     { -17, -32, 6 },
     { 17, 27, 67 },
@@ -190,8 +186,86 @@ void addZones(Globals) {
       "tile-1",
       "column"
     }
+  }
+};
+
+static bool isZoneMesh(const std::string& meshName) {
+  for (auto& zone : zones) {
+    for (auto& zoneMeshName : zone.meshNames) {
+      if (zoneMeshName == meshName) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void addMeshes(Globals) {
+  std::vector<GmMeshRequest> requests = {
+    // Grid entity objects. Ground is drawn as chunk geometry,
+    // so its cube is only used by the entity placement preview
+    { "ground", 1, create(Cube()) },
+    { "staircase", 0xffff, create(Model("./game/models/staircase.obj")) },
+    { "switch", 1000, create(Model("./game/models/switch.obj")) }
   };
 
-  state.world.zones.push_back(z1);
-  state.world.zones.push_back(z2);
+  // Placeable meshes
+  for (auto& builder : meshBuilders) {
+    requests.push_back({ builder.meshName, builder.maxInstances, builder.createMesh });
+  }
+
+  // Static world structures
+  requests.push_back({ "potm-facade", 1, create(Model("./game/models/potm-facade.obj")) });
+
+  for (auto& request : requests) {
+    request.isStreamed = isZoneMesh(request.meshName);
+  }
+
+  // Load models in parallel, adding them in the above order
+  Gm_AddMeshes(context, requests);
+
+  mesh("ground")->canCastShadows = false;
+
+  for (auto& builder : meshBuilders) {
+    if (builder.configureMesh != nullptr) {
+      builder.configureMesh(*mesh(builder.meshName));
+    }
+  }
+
+  #if DEVELOPMENT == 1
+    // Ground, as built from the grid by updateGroundMesh()
+    addMesh("ground-chunks", 1, new Mesh());
+    mesh("ground-chunks")->canCastShadows = false;
+
+    // Trigger entity indicators
+    addMesh("trigger-indicator", 0xffff, Mesh::Cube());
+    mesh("trigger-indicator")->disabled = true;
+
+    // Light indicators
+    addMesh("light-indicator", 1000, Mesh::Cube());  // @todo Mesh::Sphere()
+    mesh("light-indicator")->type = MeshType::EMISSIVE;
+    mesh("light-indicator")->disabled = true;
+
+    // Ranged placement preview
+    addMesh("range-preview", 0xffff, Mesh::Cube());
+  #endif
+}
+
+void addZones(Globals) {
+  for (auto& zone : zones) {
+    state.world.zones.push_back(zone);
+  }
+
+  // Resolve zone mesh handles up front, so zones
+  // can be toggled without any per-frame lookups
+  for (auto& zone : state.world.zones) {
+    for (auto& meshName : zone.meshNames) {
+      zone.meshHandles.push_back(meshHandle(meshName));
+    }
+
+    // Draw each zone's meshes together once they've all
+    // been streamed in; unbatchable ones are left out
+    Gm_AddStaticBatch(context, zone.name, zone.meshNames);
+  }
 }
\ No newline at end of file
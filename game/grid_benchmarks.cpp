@@ -0,0 +1,216 @@
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Gamma.h"
+
+#include "grid_benchmarks.h"
+#include "game_state.h"
+#include "world_system.h"
+
+#define GRID_BENCHMARK_ITERATIONS 10
+#define GRID_BENCHMARK_POINT_LOOKUPS 1000000
+#define GRID_BENCHMARK_NEIGHBORHOOD_CELLS 100000
+// 216³ ~= 10M cells
+#define SYNTHETIC_WORLD_SIZE 216
+
+using namespace Gamma;
+
+/**
+ * The grid hasher, map and heap-allocated polymorphic
+ * entities used before GridMap was chunked, kept here
+ * for comparison.
+ */
+struct LegacyGridEntity {
+  EntityType type;
+
+  LegacyGridEntity(EntityType type): type(type) {};
+  virtual ~LegacyGridEntity() = default;
+};
+
+struct LegacyGridCoordinatesHasher {
+  std::size_t operator()(const GridCoordinates& coordinates) const {
+    u32 ux = u32(coordinates.x + 32768) & 0xFFFF;
+    u32 uy = u32(coordinates.y + 32768) & 0xFFFF;
+    u32 uz = u32(coordinates.z + 32768) & 0xFFFF;
+
+    return (ux << 16 | uy) + uz;
+  }
+};
+
+struct LegacyGridMap : std::unordered_map<GridCoordinates, LegacyGridEntity*, LegacyGridCoordinatesHasher> {
+  ~LegacyGridMap() {
+    for (auto& [ coordinates, entity ] : *this) {
+      delete entity;
+    }
+  }
+
+  LegacyGridEntity* get(const GridCoordinates& coordinates) const {
+    auto entry = find(coordinates);
+
+    return entry == end() ? nullptr : entry->second;
+  }
+};
+
+static const GridCoordinates neighborOffsets[] = {
+  { 1, 0, 0 }, { -1, 0, 0 },
+  { 0, 1, 0 }, { 0, -1, 0 },
+  { 0, 0, 1 }, { 0, 0, -1 },
+  // Two tiles below, as in isNextMoveValid()
+  { 0, -2, 0 }
+};
+
+static u32 nextRandom(u32& seed) {
+  seed = seed * 1664525 + 1013904223;
+
+  return seed >> 8;
+}
+
+static float timeAverageMicroseconds(const std::function<void()>& test) {
+  // Warmup run
+  test();
+
+  u64 start = Gm_GetMicroseconds();
+
+  for (u32 i = 0; i < GRID_BENCHMARK_ITERATIONS; i++) {
+    test();
+  }
+
+  return float(Gm_GetMicroseconds() - start) / float(GRID_BENCHMARK_ITERATIONS);
+}
+
+static u32 getTotalRecordBytes(const GridMap& grid) {
+  return (
+    grid.count<Staircase>() * (sizeof(Staircase) + sizeof(GridCoordinates)) +
+    grid.count<Switch>() * (sizeof(Switch) + sizeof(GridCoordinates)) +
+    grid.count<WorldOrientationChange>() * (sizeof(WorldOrientationChange) + sizeof(GridCoordinates)) +
+    grid.count<Teleporter>() * (sizeof(Teleporter) + sizeof(GridCoordinates))
+  );
+}
+
+static void compareGridLookups(const std::string& label, const GridMap& grid, const LegacyGridMap& legacyGrid) {
+  GridCoordinates minimum(32767, 32767, 32767);
+  GridCoordinates maximum(-32768, -32768, -32768);
+  std::vector<GridCoordinates> occupied;
+
+  grid.forEach([&](const GridCoordinates& coordinates, const GridEntity& entity) {
+    minimum = { std::min(minimum.x, coordinates.x), std::min(minimum.y, coordinates.y), std::min(minimum.z, coordinates.z) };
+    maximum = { std::max(maximum.x, coordinates.x), std::max(maximum.y, coordinates.y), std::max(maximum.z, coordinates.z) };
+
+    occupied.push_back(coordinates);
+  });
+
+  // Random lookups within the grid bounds, plus the
+  // neighborhoods of randomly-chosen occupied cells
+  std::vector<GridCoordinates> points;
+  std::vector<GridCoordinates> neighborhoods;
+  u32 seed = 12345;
+
+  for (u32 i = 0; i < GRID_BENCHMARK_POINT_LOOKUPS; i++) {
+    points.push_back({
+      s16(minimum.x + nextRandom(seed) % (maximum.x - minimum.x + 1)),
+      s16(minimum.y + nextRandom(seed) % (maximum.y - minimum.y + 1)),
+      s16(minimum.z + nextRandom(seed) % (maximum.z - minimum.z + 1))
+    });
+  }
+
+  for (u32 i = 0; i < GRID_BENCHMARK_NEIGHBORHOOD_CELLS; i++) {
+    neighborhoods.push_back(occupied[nextRandom(seed) % occupied.size()]);
+  }
+
+  u32 totalHits = 0;
+  u32 totalLegacyHits = 0;
+
+  float pointTime = timeAverageMicroseconds([&]() {
+    totalHits = 0;
+
+    for (auto& point : points) {
+      totalHits += grid.get(point) != nullptr;
+    }
+  });
+
+  float legacyPointTime = timeAverageMicroseconds([&]() {
+    totalLegacyHits = 0;
+
+    for (auto& point : points) {
+      totalLegacyHits += legacyGrid.get(point) != nullptr;
+    }
+  });
+
+  bool isPointMatch = totalHits == totalLegacyHits;
+
+  float neighborhoodTime = timeAverageMicroseconds([&]() {
+    totalHits = 0;
+
+    for (auto& cell : neighborhoods) {
+      for (auto& offset : neighborOffsets) {
+        totalHits += grid.get(cell + offset) != nullptr;
+      }
+    }
+  });
+
+  float legacyNeighborhoodTime = timeAverageMicroseconds([&]() {
+    totalLegacyHits = 0;
+
+    for (auto& cell : neighborhoods) {
+      for (auto& offset : neighborOffsets) {
+        totalLegacyHits += legacyGrid.get(cell + offset) != nullptr;
+      }
+    }
+  });
+
+  bool isNeighborhoodMatch = totalHits == totalLegacyHits;
+
+  // Estimate memory use, counting a node, bucket and heap
+  // entity per legacy map entry (ignoring allocator overhead),
+  // against chunks plus entity records
+  u32 legacyBytes = legacyGrid.size() * (sizeof(void*) + sizeof(std::size_t) + sizeof(LegacyGridMap::value_type) + sizeof(LegacyGridEntity)) + legacyGrid.bucket_count() * sizeof(void*);
+  u32 chunkedBytes = grid.totalChunks() * sizeof(GridChunk) + getTotalRecordBytes(grid);
+  u32 maxBucketSize = 0;
+
+  for (u32 i = 0; i < legacyGrid.bucket_count(); i++) {
+    maxBucketSize = std::max(maxBucketSize, (u32)legacyGrid.bucket_size(i));
+  }
+
+  Console::log("Grid lookups (" + label + "):", grid.size(), "entities,", grid.totalChunks(), "chunks", isPointMatch && isNeighborhoodMatch ? "(results match)" : "(RESULTS MISMATCH)");
+  Console::log("  Point lookups (map):", legacyPointTime, "us");
+  Console::log("  Point lookups (chunked):", pointTime, "us");
+  Console::log("  Neighborhood lookups (map):", legacyNeighborhoodTime, "us");
+  Console::log("  Neighborhood lookups (chunked):", neighborhoodTime, "us");
+  Console::log("  Memory (map):", legacyBytes / 1000, "KB | max bucket size", maxBucketSize);
+  Console::log("  Memory (chunked):", chunkedBytes / 1000, "KB");
+}
+
+void benchmarkGridLookups(Globals) {
+  // Loaded world
+  {
+    LegacyGridMap legacyGrid;
+
+    state.world.grid.forEach([&](const GridCoordinates& coordinates, const GridEntity& entity) {
+      legacyGrid.insert({ coordinates, new LegacyGridEntity(entity.type) });
+    });
+
+    compareGridLookups("world", state.world.grid, legacyGrid);
+  }
+
+  // Synthetic world, with a quarter of its cells occupied
+  {
+    GridMap grid;
+    LegacyGridMap legacyGrid;
+    u32 seed = 54321;
+    s16 half = SYNTHETIC_WORLD_SIZE / 2;
+
+    for (s16 x = -half; x < half; x++) {
+      for (s16 y = -half; y < half; y++) {
+        for (s16 z = -half; z < half; z++) {
+          if (nextRandom(seed) % 4 == 0) {
+            grid.set({ x, y, z }, Ground());
+            legacyGrid.insert({ { x, y, z }, new LegacyGridEntity(GROUND) });
+          }
+        }
+      }
+    }
+
+    compareGridLookups("synthetic", grid, legacyGrid);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "game_macros.h"
+
+struct GmContext;
+struct GameState;
+
+/**
+ * Compares chunked GridMap lookups against the previous
+ * unordered_map-based grid, on the loaded world grid and
+ * on a synthetic ~10M cell world.
+ */
+void benchmarkGridLookups(Globals);
\ No newline at end of file
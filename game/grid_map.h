@@ -0,0 +1,523 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "grid_utilities.h"
+#include "game_entities.h"
+
+// Chunks span 16 tiles along each axis
+constexpr static s16 GRID_CHUNK_BITS = 4;
+constexpr static s16 GRID_CHUNK_SIZE = 1 << GRID_CHUNK_BITS;
+constexpr static s16 GRID_CHUNK_MASK = GRID_CHUNK_SIZE - 1;
+constexpr static u32 GRID_CHUNK_VOLUME = GRID_CHUNK_SIZE * GRID_CHUNK_SIZE * GRID_CHUNK_SIZE;
+
+/**
+ * GridChunk
+ * ---------
+ *
+ * A dense block of grid cells, each holding the tag for
+ * the entity in that cell (or EMPTY), so a chunk is a
+ * fixed 16KB.
+ */
+struct GridChunk {
+  GridCoordinates origin;
+  GridEntity cells[GRID_CHUNK_VOLUME];
+  u32 totalOccupied = 0;
+  // Incremented whenever a cell in the chunk changes
+  u32 revision = 0;
+
+  GridChunk(const GridCoordinates& origin): origin(origin) {
+    for (auto& cell : cells) {
+      cell.type = EMPTY;
+      cell.index = 0;
+    }
+  }
+};
+
+/**
+ * GridChunkSlot
+ * -------------
+ *
+ * An entry in a GridMap's chunk directory, which is an
+ * open-addressed table keyed by packed chunk coordinates.
+ */
+struct GridChunkSlot {
+  u64 key = ~0ull;
+  GridChunk* chunk = nullptr;
+};
+
+/**
+ * GridEntityPool
+ * --------------
+ *
+ * A dense array of grid entity records of one type, along
+ * with the coordinates of each, so all entities of a type
+ * can be visited without walking the grid.
+ */
+template<typename E>
+struct GridEntityPool {
+  std::vector<E> records;
+  std::vector<GridCoordinates> coordinates;
+};
+
+/**
+ * GridMap
+ * -------
+ *
+ * Maps grid coordinates to entities. Cells are stored in 16³
+ * chunks, found through a chunk directory keyed by chunk
+ * coordinates. Chunks are kept once created, even if they
+ * are emptied, so memory use grows only with the extent of
+ * the world rather than with edits. The most recently used
+ * chunk is cached, so the neighborhood lookups made by
+ * movement and entity behavior resolve to array offsets
+ * within the same chunk.
+ *
+ * Entity records are stored in per-type pools, which the
+ * cell tags index into. Records may move within their pool
+ * when other entities of their type are removed, so they
+ * should be looked up again rather than held onto.
+ */
+struct GridMap {
+  GridMap() {};
+  GridMap(const GridMap&) = delete;
+  GridMap& operator=(const GridMap&) = delete;
+
+  ~GridMap() {
+    for (auto& slot : directory) {
+      delete slot.chunk;
+    }
+  }
+
+  void clear(const GridCoordinates& coordinates) {
+    auto* chunk = findChunk(coordinates);
+
+    if (chunk == nullptr) {
+      return;
+    }
+
+    auto& cell = chunk->cells[getCellIndex(coordinates)];
+
+    switch (cell.type) {
+      case EMPTY:
+        return;
+      case STAIRCASE:
+        removeRecord<Staircase>(cell.index);
+        break;
+      case SWITCH:
+        removeRecord<Switch>(cell.index);
+        break;
+      case WORLD_ORIENTATION_CHANGE:
+        removeRecord<WorldOrientationChange>(cell.index);
+        break;
+      case TELEPORTER:
+        removeRecord<Teleporter>(cell.index);
+        break;
+      default:
+        break;
+    }
+
+    cell.type = EMPTY;
+    cell.index = 0;
+
+    chunk->totalOccupied--;
+    chunk->revision++;
+    totalEntities--;
+    revision++;
+  }
+
+  template<typename E>
+  u32 count() const {
+    if constexpr (std::is_empty<E>::value) {
+      u32 totalRecords = 0;
+
+      std::apply([&](auto&... pool) {
+        ((totalRecords += pool.records.size()), ...);
+      }, pools);
+
+      return totalEntities - totalRecords;
+    } else {
+      return getPool<E>().records.size();
+    }
+  }
+
+  /**
+   * Calls a function with the coordinates and tag
+   * of every entity in the grid.
+   */
+  template<typename F>
+  void forEach(F fn) const {
+    for (auto& slot : directory) {
+      auto* chunk = slot.chunk;
+
+      if (chunk == nullptr || chunk->totalOccupied == 0) {
+        continue;
+      }
+
+      for (u32 i = 0; i < GRID_CHUNK_VOLUME; i++) {
+        auto& cell = chunk->cells[i];
+
+        if (cell.type != EMPTY) {
+          fn(getCellCoordinates(*chunk, i), cell);
+        }
+      }
+    }
+  }
+
+  /**
+   * Calls a function with every chunk in the grid
+   * which has at least one entity in it.
+   */
+  template<typename F>
+  void forEachChunk(F fn) const {
+    for (auto& slot : directory) {
+      if (slot.chunk != nullptr && slot.chunk->totalOccupied > 0) {
+        fn(*slot.chunk);
+      }
+    }
+  }
+
+  const GridEntity* get(const GridCoordinates& coordinates) const {
+    auto* chunk = findChunk(coordinates);
+
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+
+    auto& cell = chunk->cells[getCellIndex(coordinates)];
+
+    return cell.type == EMPTY ? nullptr : &cell;
+  }
+
+  /**
+   * Returns the record for the entity at the given coordinates,
+   * or nullptr if there isn't an entity of type E there.
+   */
+  template<typename E>
+  E* get(const GridCoordinates& coordinates) {
+    auto* entity = get(coordinates);
+
+    if (entity == nullptr || entity->type != E::TYPE) {
+      return nullptr;
+    }
+
+    return &getMutablePool<E>().records[entity->index];
+  }
+
+  /**
+   * Returns the chunk containing the given coordinates,
+   * or nullptr if one hasn't been created.
+   */
+  const GridChunk* getChunk(const GridCoordinates& coordinates) const {
+    return findChunk(coordinates);
+  }
+
+  template<typename E>
+  const GridEntityPool<E>& getPool() const {
+    return std::get<GridEntityPool<E>>(pools);
+  }
+
+  /**
+   * Returns a copy of the entity at the given coordinates,
+   * with type EMPTY if there isn't one.
+   */
+  GridEntityRecord getRecord(const GridCoordinates& coordinates) const {
+    GridEntityRecord record;
+    auto* entity = get(coordinates);
+
+    if (entity == nullptr) {
+      return record;
+    }
+
+    record.type = entity->type;
+
+    switch (entity->type) {
+      case STAIRCASE:
+        record.staircase = getPool<Staircase>().records[entity->index];
+        break;
+      case SWITCH:
+        record.switchEntity = getPool<Switch>().records[entity->index];
+        break;
+      case WORLD_ORIENTATION_CHANGE:
+        record.worldOrientationChange = getPool<WorldOrientationChange>().records[entity->index];
+        break;
+      case TELEPORTER:
+        record.teleporter = getPool<Teleporter>().records[entity->index];
+        break;
+      default:
+        break;
+    }
+
+    return record;
+  }
+
+  /**
+   * Returns a counter which changes whenever any
+   * cell in the grid changes, as with the revision
+   * of each chunk.
+   */
+  u32 getRevision() const {
+    return revision;
+  }
+
+  bool has(const GridCoordinates& coordinates) const {
+    return get(coordinates) != nullptr;
+  }
+
+  template<typename E>
+  void set(const GridCoordinates& coordinates, const E& record) {
+    clear(coordinates);
+
+    auto* chunk = findChunk(coordinates);
+
+    if (chunk == nullptr) {
+      chunk = createChunk(coordinates);
+    }
+
+    auto& cell = chunk->cells[getCellIndex(coordinates)];
+
+    cell.type = E::TYPE;
+    cell.index = 0;
+
+    if constexpr (!std::is_empty<E>::value) {
+      auto& pool = getMutablePool<E>();
+
+      cell.index = pool.records.size();
+
+      pool.records.push_back(record);
+      pool.coordinates.push_back(coordinates);
+    }
+
+    chunk->totalOccupied++;
+    chunk->revision++;
+    totalEntities++;
+    revision++;
+  }
+
+  /**
+   * Sets the entity at the given coordinates from a copy
+   * made by getRecord(), or clears it if the copy is EMPTY.
+   */
+  void setRecord(const GridCoordinates& coordinates, const GridEntityRecord& record) {
+    switch (record.type) {
+      case GROUND:
+        set(coordinates, Ground());
+        break;
+      case STAIRCASE:
+        set(coordinates, record.staircase);
+        break;
+      case SWITCH:
+        set(coordinates, record.switchEntity);
+        break;
+      case WORLD_ORIENTATION_CHANGE:
+        set(coordinates, record.worldOrientationChange);
+        break;
+      case TELEPORTER:
+        set(coordinates, record.teleporter);
+        break;
+      default:
+        clear(coordinates);
+        break;
+    }
+  }
+
+  /**
+   * Sets a run of cells within the chunk at the given origin
+   * to entities of type E, in cell order, e.g. when loading
+   * chunk-encoded grid data. Only entities without records
+   * can be set in runs.
+   */
+  template<typename E>
+  void setRun(const GridCoordinates& origin, u32 start, u32 length) {
+    static_assert(std::is_empty<E>::value, "Only entities without records can be set in runs");
+
+    auto* chunk = findChunk(origin);
+
+    if (chunk == nullptr) {
+      chunk = createChunk(origin);
+    }
+
+    for (u32 i = start; i < start + length; i++) {
+      auto& cell = chunk->cells[i];
+
+      if (cell.type != EMPTY) {
+        clear(getCellCoordinates(*chunk, i));
+      }
+
+      cell.type = E::TYPE;
+      cell.index = 0;
+
+      chunk->totalOccupied++;
+      totalEntities++;
+    }
+
+    chunk->revision++;
+    revision++;
+  }
+
+  u32 size() const {
+    return totalEntities;
+  }
+
+  u32 totalChunks() const {
+    return totalDirectoryChunks;
+  }
+
+private:
+  std::vector<GridChunkSlot> directory;
+  u32 totalDirectoryChunks = 0;
+  u32 totalEntities = 0;
+  u32 revision = 0;
+  mutable u64 cachedChunkKey = ~0ull;
+  mutable GridChunk* cachedChunk = nullptr;
+
+  std::tuple<
+    GridEntityPool<Staircase>,
+    GridEntityPool<Switch>,
+    GridEntityPool<WorldOrientationChange>,
+    GridEntityPool<Teleporter>
+  > pools;
+
+  static u64 getChunkKey(const GridCoordinates& coordinates) {
+    // Arithmetic shifts floor negative coordinates
+    // into the chunk below them
+    u64 cx = u16(coordinates.x >> GRID_CHUNK_BITS);
+    u64 cy = u16(coordinates.y >> GRID_CHUNK_BITS);
+    u64 cz = u16(coordinates.z >> GRID_CHUNK_BITS);
+
+    return cx | (cy << 16) | (cz << 32);
+  }
+
+  static u32 getCellIndex(const GridCoordinates& coordinates) {
+    u32 x = coordinates.x & GRID_CHUNK_MASK;
+    u32 y = coordinates.y & GRID_CHUNK_MASK;
+    u32 z = coordinates.z & GRID_CHUNK_MASK;
+
+    return x | (y << GRID_CHUNK_BITS) | (z << (GRID_CHUNK_BITS * 2));
+  }
+
+  static GridCoordinates getCellCoordinates(const GridChunk& chunk, u32 index) {
+    return {
+      s16(chunk.origin.x + s16(index & GRID_CHUNK_MASK)),
+      s16(chunk.origin.y + s16((index >> GRID_CHUNK_BITS) & GRID_CHUNK_MASK)),
+      s16(chunk.origin.z + s16(index >> (GRID_CHUNK_BITS * 2)))
+    };
+  }
+
+  template<typename E>
+  GridEntityPool<E>& getMutablePool() {
+    return std::get<GridEntityPool<E>>(pools);
+  }
+
+  static u32 hashChunkKey(u64 key) {
+    // Mix the packed chunk coordinates so that nearby
+    // chunks don't land in neighboring slots
+    key ^= key >> 31;
+    key *= 0x9E3779B97F4A7C15ull;
+    key ^= key >> 29;
+
+    return u32(key);
+  }
+
+  /**
+   * Removes a record from its pool, moving the last record
+   * into the vacated slot to keep the pool dense.
+   */
+  template<typename E>
+  void removeRecord(u32 index) {
+    auto& pool = getMutablePool<E>();
+
+    if (index != pool.records.size() - 1) {
+      pool.records[index] = pool.records.back();
+      pool.coordinates[index] = pool.coordinates.back();
+
+      auto* chunk = findChunk(pool.coordinates[index]);
+
+      chunk->cells[getCellIndex(pool.coordinates[index])].index = index;
+    }
+
+    pool.records.pop_back();
+    pool.coordinates.pop_back();
+  }
+
+  GridChunk* createChunk(const GridCoordinates& coordinates) {
+    // Keep the directory at most half full
+    if ((totalDirectoryChunks + 1) * 2 > directory.size()) {
+      resizeDirectory(directory.size() == 0 ? 64 : directory.size() * 2);
+    }
+
+    u64 key = getChunkKey(coordinates);
+
+    GridCoordinates origin = {
+      s16(coordinates.x & ~GRID_CHUNK_MASK),
+      s16(coordinates.y & ~GRID_CHUNK_MASK),
+      s16(coordinates.z & ~GRID_CHUNK_MASK)
+    };
+
+    auto* chunk = new GridChunk(origin);
+
+    insertChunk(key, chunk);
+
+    totalDirectoryChunks++;
+    cachedChunkKey = key;
+    cachedChunk = chunk;
+
+    return chunk;
+  }
+
+  GridChunk* findChunk(const GridCoordinates& coordinates) const {
+    u64 key = getChunkKey(coordinates);
+
+    if (key == cachedChunkKey) {
+      return cachedChunk;
+    }
+
+    cachedChunkKey = key;
+    cachedChunk = nullptr;
+
+    if (directory.size() == 0) {
+      return nullptr;
+    }
+
+    u32 mask = directory.size() - 1;
+
+    for (u32 i = hashChunkKey(key) & mask;; i = (i + 1) & mask) {
+      auto& slot = directory[i];
+
+      if (slot.key == key) {
+        cachedChunk = slot.chunk;
+
+        break;
+      } else if (slot.chunk == nullptr) {
+        break;
+      }
+    }
+
+    return cachedChunk;
+  }
+
+  void insertChunk(u64 key, GridChunk* chunk) {
+    u32 mask = directory.size() - 1;
+    u32 i = hashChunkKey(key) & mask;
+
+    while (directory[i].chunk != nullptr) {
+      i = (i + 1) & mask;
+    }
+
+    directory[i] = { key, chunk };
+  }
+
+  void resizeDirectory(u32 size) {
+    auto previousDirectory = std::move(directory);
+
+    directory = std::vector<GridChunkSlot>(size);
+
+    for (auto& slot : previousDirectory) {
+      if (slot.chunk != nullptr) {
+        insertChunk(slot.key, slot.chunk);
+      }
+    }
+  }
+};
\ No newline at end of file
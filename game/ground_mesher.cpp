@@ -0,0 +1,284 @@
+#include <cstring>
+
+#include "ground_mesher.h"
+#include "grid_utilities.h"
+
+using namespace Gamma;
+
+/**
+ * Returns whether the cell at the given chunk-local coordinates
+ * is Ground, looking into neighboring chunks for coordinates
+ * outside of the chunk.
+ */
+static bool isGroundCell(const GridMap& grid, const GridChunk& chunk, const s16 (&local)[3]) {
+  if (
+    local[0] >= 0 && local[0] < GRID_CHUNK_SIZE &&
+    local[1] >= 0 && local[1] < GRID_CHUNK_SIZE &&
+    local[2] >= 0 && local[2] < GRID_CHUNK_SIZE
+  ) {
+    u32 index = local[0] | (local[1] << GRID_CHUNK_BITS) | (local[2] << (GRID_CHUNK_BITS * 2));
+
+    return chunk.cells[index].type == GROUND;
+  }
+
+  GridCoordinates coordinates = {
+    s16(chunk.origin.x + local[0]),
+    s16(chunk.origin.y + local[1]),
+    s16(chunk.origin.z + local[2])
+  };
+
+  auto* entity = grid.get(coordinates);
+
+  return entity != nullptr && entity->type == GROUND;
+}
+
+/**
+ * Adds a quad on the plane at the given position along an axis,
+ * spanning [u0, u1] and [v0, v1] (in tiles) along the two axes
+ * following it, and facing in the given direction along it.
+ */
+static void addQuad(GroundChunkGeometry& geometry, u32 axis, s16 direction, float plane, s16 u0, s16 v0, s16 u1, s16 v1) {
+  const s16 corners[4][2] = {
+    { u0, v0 },
+    { u1, v0 },
+    { u1, v1 },
+    { u0, v1 }
+  };
+
+  u32 uAxis = (axis + 1) % 3;
+  u32 vAxis = (axis + 2) % 3;
+  u32 base = geometry.vertices.size();
+
+  for (auto& corner : corners) {
+    float position[3];
+    float normal[3] = { 0.f, 0.f, 0.f };
+    float tangent[3] = { 0.f, 0.f, 0.f };
+    Vertex vertex;
+
+    position[axis] = plane;
+    position[uAxis] = corner[0] * TILE_SIZE;
+    position[vAxis] = corner[1] * TILE_SIZE;
+    normal[axis] = float(direction);
+    tangent[uAxis] = 1.f;
+
+    vertex.position = Vec3f(position[0], position[1], position[2]);
+    vertex.normal = Vec3f(normal[0], normal[1], normal[2]);
+    vertex.tangent = Vec3f(tangent[0], tangent[1], tangent[2]);
+    // Repeat textures once per tile
+    vertex.uv = Vec2f(float(corner[0] - u0), float(corner[1] - v0));
+
+    geometry.vertices.push_back(vertex);
+  }
+
+  // Wind the quad the same way as Mesh::Cube() faces,
+  // so it faces outward along the given direction
+  const u32 positiveElements[6] = { 0, 1, 2, 0, 2, 3 };
+  const u32 negativeElements[6] = { 0, 2, 1, 0, 3, 2 };
+
+  for (u32 element : direction > 0 ? positiveElements : negativeElements) {
+    geometry.faceElements.push_back(base + element);
+  }
+}
+
+/**
+ * Builds the exposed Ground faces in a chunk, one layer of cells
+ * at a time along each axis and direction. Exposed faces in each
+ * layer are merged greedily: each unmerged face is extended into
+ * a row of faces, and then into as many rows of the same length
+ * as possible, before the resulting quad is added.
+ */
+void buildGroundChunkGeometry(const GridMap& grid, const GridChunk& chunk, GroundChunkGeometry& geometry) {
+  geometry.vertices.clear();
+  geometry.faceElements.clear();
+
+  if (chunk.totalOccupied == 0) {
+    return;
+  }
+
+  const s16 origin[3] = { chunk.origin.x, chunk.origin.y, chunk.origin.z };
+  bool exposed[GRID_CHUNK_SIZE][GRID_CHUNK_SIZE];
+
+  for (u32 axis = 0; axis < 3; axis++) {
+    u32 uAxis = (axis + 1) % 3;
+    u32 vAxis = (axis + 2) % 3;
+
+    for (s16 direction : { -1, 1 }) {
+      for (s16 layer = 0; layer < GRID_CHUNK_SIZE; layer++) {
+        bool hasExposedFaces = false;
+
+        for (s16 v = 0; v < GRID_CHUNK_SIZE; v++) {
+          for (s16 u = 0; u < GRID_CHUNK_SIZE; u++) {
+            s16 cell[3];
+            s16 neighbor[3];
+
+            cell[axis] = layer;
+            cell[uAxis] = u;
+            cell[vAxis] = v;
+
+            neighbor[axis] = layer + direction;
+            neighbor[uAxis] = u;
+            neighbor[vAxis] = v;
+
+            exposed[v][u] = isGroundCell(grid, chunk, cell) && !isGroundCell(grid, chunk, neighbor);
+            hasExposedFaces |= exposed[v][u];
+          }
+        }
+
+        if (!hasExposedFaces) {
+          continue;
+        }
+
+        float plane = (origin[axis] + layer + (direction > 0 ? 1 : 0)) * TILE_SIZE;
+
+        for (s16 v = 0; v < GRID_CHUNK_SIZE; v++) {
+          for (s16 u = 0; u < GRID_CHUNK_SIZE; u++) {
+            if (!exposed[v][u]) {
+              continue;
+            }
+
+            s16 width = 1;
+            s16 height = 1;
+
+            while (u + width < GRID_CHUNK_SIZE && exposed[v][u + width]) {
+              width++;
+            }
+
+            while (v + height < GRID_CHUNK_SIZE) {
+              bool isRowExposed = true;
+
+              for (s16 i = u; i < u + width && isRowExposed; i++) {
+                isRowExposed = exposed[v + height][i];
+              }
+
+              if (!isRowExposed) {
+                break;
+              }
+
+              height++;
+            }
+
+            for (s16 j = v; j < v + height; j++) {
+              for (s16 i = u; i < u + width; i++) {
+                exposed[j][i] = false;
+              }
+            }
+
+            s16 u0 = origin[uAxis] + u;
+            s16 v0 = origin[vAxis] + v;
+
+            addQuad(geometry, axis, direction, plane, u0, v0, u0 + width, v0 + height);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Combines the geometry of every chunk into a new Mesh,
+ * in world space, for a single object at the origin.
+ */
+Mesh* GroundMesher::createMesh() const {
+  auto* mesh = new Mesh();
+  u32 totalVertices = 0;
+  u32 totalFaceElements = 0;
+
+  for (auto& [ _, groundChunk ] : chunks) {
+    totalVertices += groundChunk.geometry.vertices.size();
+    totalFaceElements += groundChunk.geometry.faceElements.size();
+  }
+
+  mesh->vertices.reserve(totalVertices);
+  mesh->faceElements.reserve(totalFaceElements);
+
+  for (auto& [ _, groundChunk ] : chunks) {
+    auto& geometry = groundChunk.geometry;
+    u32 base = mesh->vertices.size();
+
+    mesh->vertices.insert(mesh->vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+
+    for (u32 element : geometry.faceElements) {
+      mesh->faceElements.push_back(base + element);
+    }
+  }
+
+  Gm_ComputeBounds(mesh);
+
+  return mesh;
+}
+
+u32 GroundMesher::getTotalTriangles() const {
+  u32 totalTriangles = 0;
+
+  for (auto& [ _, groundChunk ] : chunks) {
+    totalTriangles += groundChunk.geometry.faceElements.size() / 3;
+  }
+
+  return totalTriangles;
+}
+
+/**
+ * Rebuilds the geometry of any chunks in the grid which have
+ * changed since the previous update, along with that of their
+ * neighbors, whose exposed faces may have changed with them.
+ * Returns whether any geometry was rebuilt. The mesher should
+ * only be used with one grid, since it tracks chunks by address.
+ */
+bool GroundMesher::update(const GridMap& grid) {
+  if (grid.getRevision() == gridRevision) {
+    return false;
+  }
+
+  bool hasChanged = false;
+
+  gridRevision = grid.getRevision();
+
+  grid.forEachChunk([&](const GridChunk& chunk) {
+    const GridCoordinates neighborOrigins[6] = {
+      { s16(chunk.origin.x - GRID_CHUNK_SIZE), chunk.origin.y, chunk.origin.z },
+      { s16(chunk.origin.x + GRID_CHUNK_SIZE), chunk.origin.y, chunk.origin.z },
+      { chunk.origin.x, s16(chunk.origin.y - GRID_CHUNK_SIZE), chunk.origin.z },
+      { chunk.origin.x, s16(chunk.origin.y + GRID_CHUNK_SIZE), chunk.origin.z },
+      { chunk.origin.x, chunk.origin.y, s16(chunk.origin.z - GRID_CHUNK_SIZE) },
+      { chunk.origin.x, chunk.origin.y, s16(chunk.origin.z + GRID_CHUNK_SIZE) }
+    };
+
+    u32 revisions[7];
+
+    revisions[0] = chunk.revision;
+
+    for (u32 i = 0; i < 6; i++) {
+      auto* neighbor = grid.getChunk(neighborOrigins[i]);
+
+      // Chunks are always changed as they're created, so
+      // missing neighbors can't be mistaken for new ones
+      revisions[i + 1] = neighbor == nullptr ? 0 : neighbor->revision;
+    }
+
+    auto entry = chunks.find(&chunk);
+
+    if (entry != chunks.end() && memcmp(entry->second.revisions, revisions, sizeof(revisions)) == 0) {
+      return;
+    }
+
+    auto& groundChunk = chunks[&chunk];
+
+    memcpy(groundChunk.revisions, revisions, sizeof(revisions));
+
+    buildGroundChunkGeometry(grid, chunk, groundChunk.geometry);
+
+    hasChanged = true;
+  });
+
+  // Chunks emptied since the previous update
+  // aren't visited by forEachChunk()
+  for (auto& [ chunk, groundChunk ] : chunks) {
+    if (chunk->totalOccupied == 0 && groundChunk.geometry.vertices.size() > 0) {
+      groundChunk.geometry = GroundChunkGeometry();
+
+      hasChanged = true;
+    }
+  }
+
+  return hasChanged;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Gamma.h"
+
+#include "grid_map.h"
+
+/**
+ * GroundChunkGeometry
+ * -------------------
+ *
+ * The exposed faces of the Ground within a grid chunk, in
+ * world space, with coplanar neighboring faces merged into
+ * larger quads. Faces between two Ground cells are hidden,
+ * and left out entirely.
+ */
+struct GroundChunkGeometry {
+  std::vector<Gamma::Vertex> vertices;
+  std::vector<u32> faceElements;
+};
+
+/**
+ * GroundMesher
+ * ------------
+ *
+ * Builds the Ground in a grid into a single mesh, made up
+ * of the geometry of each chunk. Only chunks which have
+ * changed since the previous update, or whose neighbors
+ * have, are rebuilt; the mesh itself is always created
+ * from every chunk (see updateGroundMesh()).
+ */
+struct GroundMesher {
+  Gamma::Mesh* createMesh() const;
+  u32 getTotalTriangles() const;
+  bool update(const GridMap& grid);
+
+private:
+  struct GroundChunk {
+    // The revisions of the chunk and its six neighbors
+    // when its geometry was last built
+    u32 revisions[7];
+    GroundChunkGeometry geometry;
+  };
+
+  std::unordered_map<const GridChunk*, GroundChunk> chunks;
+  u32 gridRevision = ~0u;
+};
+
+void buildGroundChunkGeometry(const GridMap& grid, const GridChunk& chunk, GroundChunkGeometry& geometry);
\ No newline at end of file
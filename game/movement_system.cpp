@@ -187,7 +187,8 @@ static Vec3f getImmediateTeleportationPosition(Globals, const Teleporter* telepo
 }
 
 static void handleTriggerEntitiesBeforeMove(Globals, const GridCoordinates& targetGridCoordinates, Vec3f& targetCameraPosition) {
-  auto* targetEntity = state.world.grid.get(targetGridCoordinates);
+  auto& grid = state.world.grid;
+  auto* targetEntity = grid.get(targetGridCoordinates);
 
   if (targetEntity == nullptr) {
     return;
@@ -195,11 +196,11 @@ static void handleTriggerEntitiesBeforeMove(Globals, const GridCoordinates& targ
 
   switch (targetEntity->type) {
     case WORLD_ORIENTATION_CHANGE:
-      setWorldOrientation(globals, ((WorldOrientationChange*)targetEntity)->targetWorldOrientation);
+      setWorldOrientation(globals, grid.get<WorldOrientationChange>(targetGridCoordinates)->targetWorldOrientation);
       break;
     case TELEPORTER: {
       auto& camera = getCamera();
-      auto* teleporter = (Teleporter*)targetEntity;
+      auto* teleporter = grid.get<Teleporter>(targetGridCoordinates);
 
       camera.position = getImmediateTeleportationPosition(globals, teleporter, targetCameraPosition);
       targetCameraPosition = gridCoordinatesToWorldPosition(teleporter->toCoordinates);
@@ -218,6 +219,8 @@ static void handleTriggerEntitiesBeforeMove(Globals, const GridCoordinates& targ
 
       break;
     }
+    default:
+      break;
   }
 }
 
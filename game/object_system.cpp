@@ -69,17 +69,6 @@ const static std::map<std::string, std::vector<std::string>> compoundMeshMap = {
   {"rosebush", { "rosebush-flowers" }}
 };
 
-static void createGroundObject(Globals, const GridCoordinates& coordinates) {
-  auto& object = createObjectFrom("ground");
-  auto& params = getGridObjectParameters(GROUND);
-
-  object.position = gridCoordinatesToWorldPosition(coordinates);
-  object.scale = params.scale;
-  object.color = params.color;
-
-  commit(object);
-}
-
 static void createStaircaseObject(Globals, const GridCoordinates& coordinates, const Orientation& orientation) {
   auto& object = createObjectFrom("staircase");
   auto& params = getGridObjectParameters(STAIRCASE);
@@ -145,7 +134,8 @@ const ObjectParameters& getMeshObjectParameters(const std::string& meshName) {
 }
 
 void createGridObjectFromCoordinates(Globals, const GridCoordinates& coordinates) {
-  auto* entity = state.world.grid.get(coordinates);
+  auto& grid = state.world.grid;
+  auto* entity = grid.get(coordinates);
 
   if (entity == nullptr) {
     return;
@@ -153,12 +143,12 @@ void createGridObjectFromCoordinates(Globals, const GridCoordinates& coordinates
 
   switch (entity->type) {
     case GROUND:
-      #if DEVELOPMENT == 1
-        createGroundObject(globals, coordinates);
-      #endif
+      // Ground is drawn as merged chunk geometry
+      // rather than as individual objects; see
+      // updateGroundMesh()
       break;
     case STAIRCASE:
-      createStaircaseObject(globals, coordinates, ((Staircase*)entity)->orientation);        
+      createStaircaseObject(globals, coordinates, grid.get<Staircase>(coordinates)->orientation);
       break;
     case SWITCH:
       createSwitchObject(globals, coordinates);
@@ -178,6 +168,26 @@ void createGridObjectFromCoordinates(Globals, const GridCoordinates& coordinates
   }
 }
 
+/**
+ * Rebuilds the "ground-chunks" mesh from any grid chunks
+ * changed since the previous update. Cheap to call every
+ * frame, since it returns right away if the grid hasn't
+ * changed.
+ *
+ * Only changed chunks are re-meshed, but the combined mesh
+ * is replaced and re-uploaded as a whole. This is deliberate:
+ * the grid only changes with editor edits, and keeping the
+ * Ground in one mesh draws it with one call per pass, rather
+ * than one per chunk.
+ */
+void updateGroundMesh(Globals) {
+  auto& mesher = state.world.groundMesher;
+
+  if (mesher.update(state.world.grid)) {
+    Gm_ReplaceMeshGeometry(context, "ground-chunks", mesher.createMesh());
+  }
+}
+
 Object& createMeshObject(Globals, const std::string& meshName) {
   auto& object = createObjectFrom(meshName);
   auto& params = getMeshObjectParameters(meshName);
@@ -198,6 +208,28 @@ Object& createMeshObject(Globals, const std::string& meshName) {
   return object;
 }
 
+ObjectSpan createMeshObjects(Globals, const std::string& meshName, u32 count) {
+  auto span = createObjectsFrom(meshName, count);
+  auto& params = getMeshObjectParameters(meshName);
+
+  for (auto& object : span) {
+    object.scale = params.scale;
+    object.color = params.color;
+  }
+
+  commitRange(span);
+
+  if (compoundMeshMap.find(meshName) != compoundMeshMap.end()) {
+    auto& extensionMeshNames = compoundMeshMap.at(meshName);
+
+    for (auto& extensionMeshName : extensionMeshNames) {
+      createMeshObjects(globals, extensionMeshName, count);
+    }
+  }
+
+  return span;
+}
+
 void synchronizeCompoundMeshes(Globals) {
   for (auto& [ meshName, _ ] : compoundMeshMap) {
     synchronizeCompoundMeshes(globals, meshName);
@@ -218,16 +250,18 @@ void synchronizeCompoundMeshes(Globals, const std::string& meshName) {
         removeObject(extensions[extensions.totalActive() - 1]);
       }
 
-      for (u8 i = 0; i < baseObjects.totalActive(); i++) {
+      for (u32 i = 0; i < baseObjects.totalActive(); i++) {
         auto& object = baseObjects[i];
         auto& extension = extensions[i];
 
         extension.position = object.position;
         extension.rotation = object.rotation;
         extension.scale = object.scale;
-
-        commit(extension);
       }
+
+      ObjectSpan span = { extensions.begin(), extensions.totalActive() };
+
+      commitRange(span);
     }
   }
 }
@@ -18,7 +18,9 @@ struct ObjectParameters {
 const ObjectParameters& getGridObjectParameters(EntityType entityType);
 const ObjectParameters& getMeshObjectParameters(const std::string& meshName);
 void createGridObjectFromCoordinates(Globals, const GridCoordinates& coordinates);
+void updateGroundMesh(Globals);
 Gamma::Object& createMeshObject(Globals, const std::string& meshName);
+Gamma::ObjectSpan createMeshObjects(Globals, const std::string& meshName, u32 count);
 void synchronizeCompoundMeshes(Globals);
 void synchronizeCompoundMeshes(Globals, const std::string& meshName);
 Gamma::Object* findObjectByPosition(Gamma::ObjectPool& objects, const Gamma::Vec3f& position);
\ No newline at end of file
@@ -0,0 +1,393 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "system/assert.h"
+
+#include "world_file.h"
+
+/**
+ * "PWLD", as little-endian bytes
+ */
+#define WORLD_FILE_MAGIC 0x444C5750
+/**
+ * Bump whenever the layout of world files, or of
+ * any of the data stored in them, changes
+ */
+#define WORLD_FILE_VERSION 2
+
+using namespace Gamma;
+
+/**
+ * WorldFileHeader
+ * ---------------
+ *
+ * Precedes the contents of a world file, which are laid out as:
+ *
+ *  [header]
+ *  [source key, padded to 4 bytes]
+ *  [WorldFileSection * totalSections]
+ *  [section data, each padded to 4 bytes]
+ */
+struct WorldFileHeader {
+  u32 magic = WORLD_FILE_MAGIC;
+  u32 version = WORLD_FILE_VERSION;
+  u32 objectSize = sizeof(WorldFileObject);
+  u32 lightSize = sizeof(Light);
+  u32 keyLength = 0;
+  u32 totalSections = 0;
+};
+
+static_assert(sizeof(WorldFileGridChunk) == 8, "WorldFileGridChunk must be 8 bytes");
+
+inline static u32 alignTo4(u32 size) {
+  return (size + 3) & ~3;
+}
+
+/**
+ * Returns the size of a grid record section with
+ * a given number of entities of type E.
+ */
+template<typename E>
+static u32 getGridRecordsSize(u32 count) {
+  return alignTo4(count * sizeof(GridCoordinates)) + count * sizeof(E);
+}
+
+template<typename E>
+static void loadGridRecords(GridMap& grid, const WorldFileSection& section, const char* data) {
+  auto* coordinates = (const GridCoordinates*)data;
+  auto* records = (const E*)(data + alignTo4(section.count * sizeof(GridCoordinates)));
+
+  for (u32 i = 0; i < section.count; i++) {
+    grid.set(coordinates[i], records[i]);
+  }
+}
+
+/**
+ * Returns whether a section's size matches the
+ * data it should contain, e.g. so object arrays
+ * can be copied out of it without further checks.
+ */
+static bool isSectionSizeValid(const WorldFileSection& section) {
+  switch (section.type) {
+    case WORLD_SECTION_GRID_CHUNKS:
+      // Checked as chunks are decoded
+      return true;
+    case WORLD_SECTION_GRID_RECORDS:
+      switch (section.entityType) {
+        case STAIRCASE:
+          return section.size == getGridRecordsSize<Staircase>(section.count);
+        case SWITCH:
+          return section.size == getGridRecordsSize<Switch>(section.count);
+        case WORLD_ORIENTATION_CHANGE:
+          return section.size == getGridRecordsSize<WorldOrientationChange>(section.count);
+        case TELEPORTER:
+          return section.size == getGridRecordsSize<Teleporter>(section.count);
+        default:
+          return false;
+      }
+    case WORLD_SECTION_MESH_OBJECTS:
+    case WORLD_SECTION_STATIC_STRUCTURE_OBJECTS:
+      return section.size == section.count * sizeof(Object) && section.name[sizeof(section.name) - 1] == 0;
+    case WORLD_SECTION_LIGHTS:
+      return section.size == section.count * sizeof(Light);
+    default:
+      return false;
+  }
+}
+
+template<typename E>
+void WorldFileWriter::addGridRecords(const GridEntityPool<E>& pool) {
+  std::string recordData;
+  u32 count = (u32)pool.records.size();
+  u32 coordinatesSize = count * sizeof(GridCoordinates);
+
+  recordData.append((const char*)pool.coordinates.data(), coordinatesSize);
+  recordData.append(alignTo4(coordinatesSize) - coordinatesSize, '\0');
+  recordData.append((const char*)pool.records.data(), count * sizeof(E));
+
+  addSection(WORLD_SECTION_GRID_RECORDS, E::TYPE, "", count, recordData.data(), (u32)recordData.size());
+}
+
+void WorldFileWriter::addGrid(const GridMap& grid) {
+  std::string chunkData;
+  std::vector<u16> runs;
+  u32 totalChunks = 0;
+
+  grid.forEachChunk([&](const GridChunk& chunk) {
+    bool isGround = false;
+    u16 length = 0;
+
+    runs.clear();
+
+    for (auto& cell : chunk.cells) {
+      if ((cell.type == GROUND) != isGround) {
+        runs.push_back(length);
+
+        isGround = !isGround;
+        length = 0;
+      }
+
+      length++;
+    }
+
+    runs.push_back(length);
+
+    // Skip chunks without any Ground, which
+    // are encoded as a single non-Ground run
+    if (runs.size() == 1) {
+      return;
+    }
+
+    WorldFileGridChunk header;
+    u32 runsSize = runs.size() * sizeof(u16);
+
+    header.origin = chunk.origin;
+    header.totalRuns = (u16)runs.size();
+
+    chunkData.append((const char*)&header, sizeof(WorldFileGridChunk));
+    chunkData.append((const char*)runs.data(), runsSize);
+    chunkData.append(alignTo4(runsSize) - runsSize, '\0');
+
+    totalChunks++;
+  });
+
+  addSection(WORLD_SECTION_GRID_CHUNKS, EMPTY, "", totalChunks, chunkData.data(), (u32)chunkData.size());
+
+  addGridRecords(grid.getPool<Staircase>());
+  addGridRecords(grid.getPool<WorldOrientationChange>());
+  addGridRecords(grid.getPool<Teleporter>());
+
+  // Switch state is transient, so switches are always
+  // saved in their initial, unpressed state
+  auto& switches = grid.getPool<Switch>();
+
+  addGridRecords(GridEntityPool<Switch>{
+    std::vector<Switch>(switches.records.size()),
+    switches.coordinates
+  });
+}
+
+void WorldFileWriter::addLights(const std::vector<Light>& lights) {
+  addSection(WORLD_SECTION_LIGHTS, EMPTY, "", (u32)lights.size(), lights.data(), u32(lights.size() * sizeof(Light)));
+}
+
+void WorldFileWriter::addObjects(WorldFileSectionType type, const std::string& meshName, const std::vector<Object>& objects) {
+  if (objects.size() == 0) {
+    return;
+  }
+
+  std::vector<WorldFileObject> fileObjects(objects.size());
+
+  for (u32 i = 0; i < objects.size(); i++) {
+    auto& object = objects[i];
+    auto& fileObject = fileObjects[i];
+
+    fileObject.position = object.position;
+    fileObject.scale = object.scale;
+    fileObject.rotation = object.rotation;
+    fileObject.color = object.color;
+  }
+
+  addSection(type, EMPTY, meshName, (u32)fileObjects.size(), fileObjects.data(), u32(fileObjects.size() * sizeof(WorldFileObject)));
+}
+
+void WorldFileWriter::addSection(WorldFileSectionType type, u32 entityType, const std::string& name, u32 count, const void* bytes, u32 size) {
+  assert(name.size() < sizeof(WorldFileSection::name), "World file section names must be shorter than 32 characters");
+
+  WorldFileSection section;
+
+  section.type = type;
+  section.entityType = entityType;
+  // Offsets are relative to the start of the section
+  // data until the file is written
+  section.offset = (u32)data.size();
+  section.size = size;
+  section.count = count;
+
+  memcpy(section.name, name.data(), name.size());
+
+  sections.push_back(section);
+
+  data.append((const char*)bytes, size);
+  data.append(alignTo4(size) - size, '\0');
+}
+
+/**
+ * Writes the collected sections to a world file, tagged
+ * with a key identifying the sources the world data was
+ * loaded from. Returns false if the file couldn't be
+ * written.
+ */
+bool WorldFileWriter::write(const char* path, const std::string& key) const {
+  WorldFileHeader header;
+  auto temporaryPath = std::string(path) + ".tmp";
+  const char padding[4] = { 0 };
+
+  header.keyLength = (u32)key.size();
+  header.totalSections = (u32)sections.size();
+
+  u32 dataOffset = sizeof(WorldFileHeader) + alignTo4(header.keyLength) + header.totalSections * sizeof(WorldFileSection);
+  auto fileSections = sections;
+
+  for (auto& section : fileSections) {
+    section.offset += dataOffset;
+  }
+
+  bool isWritten = false;
+  std::error_code error;
+
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    file.write((const char*)&header, sizeof(WorldFileHeader));
+    file.write(key.data(), key.size());
+    file.write(padding, alignTo4(header.keyLength) - header.keyLength);
+    file.write((const char*)fileSections.data(), fileSections.size() * sizeof(WorldFileSection));
+    file.write(data.data(), data.size());
+
+    isWritten = file.good();
+  }
+
+  // Swap in the complete file, so a partially-written
+  // one is never picked up by a later load
+  if (isWritten) {
+    std::filesystem::rename(temporaryPath, path, error);
+  }
+
+  if (!isWritten || error) {
+    Console::log("Failed to write world file:", path);
+
+    std::filesystem::remove(temporaryPath, error);
+
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Maps a world file and checks it against the current format
+ * and the given source key. An empty key skips the source check,
+ * e.g. when the world file is all there is to load.
+ */
+WorldFileReader::WorldFileReader(const char* path, const std::string& key): file(path) {
+  if (!file.isOpen() || file.size() < sizeof(WorldFileHeader)) {
+    return;
+  }
+
+  WorldFileHeader header;
+
+  memcpy(&header, file.data(), sizeof(WorldFileHeader));
+
+  u64 keyOffset = sizeof(WorldFileHeader);
+  u64 sectionsOffset = keyOffset + alignTo4(header.keyLength);
+  u64 dataOffset = sectionsOffset + u64(header.totalSections) * sizeof(WorldFileSection);
+
+  if (
+    header.magic != WORLD_FILE_MAGIC ||
+    header.version != WORLD_FILE_VERSION ||
+    header.objectSize != sizeof(WorldFileObject) ||
+    header.lightSize != sizeof(Light) ||
+    file.size() < dataOffset ||
+    (key.size() > 0 && (header.keyLength != key.size() || memcmp(file.data() + keyOffset, key.data(), key.size()) != 0))
+  ) {
+    return;
+  }
+
+  sections = (const WorldFileSection*)(file.data() + sectionsOffset);
+  totalSections = header.totalSections;
+
+  for (u32 i = 0; i < totalSections; i++) {
+    auto& section = sections[i];
+
+    if (
+      section.offset < dataOffset ||
+      section.offset % 4 != 0 ||
+      u64(section.offset) + section.size > file.size() ||
+      !isSectionSizeValid(section)
+    ) {
+      return;
+    }
+  }
+
+  isIntact = true;
+}
+
+bool WorldFileReader::isValid() const {
+  return isIntact;
+}
+
+/**
+ * Builds a key identifying the last write times of the text
+ * files a world file was exported alongside, so a world file
+ * is passed over in favor of any text files changed since.
+ * Missing text files are left out of the key.
+ */
+std::string getWorldFileKey(const std::vector<std::string>& sourcePaths) {
+  std::string key;
+
+  for (auto& path : sourcePaths) {
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(path, error);
+
+    if (!error) {
+      key += path + "|" + std::to_string(writeTime.time_since_epoch().count()) + "\n";
+    }
+  }
+
+  return key;
+}
+
+/**
+ * Loads the entities in a grid chunks or grid records
+ * section into a grid. Ground cells are set run by run,
+ * and other entities are copied out of their records.
+ */
+void loadGridSection(GridMap& grid, const WorldFileSection& section, const char* data) {
+  if (section.type == WORLD_SECTION_GRID_CHUNKS) {
+    const char* cursor = data;
+    const char* end = data + section.size;
+
+    for (u32 i = 0; i < section.count && cursor + sizeof(WorldFileGridChunk) <= end; i++) {
+      WorldFileGridChunk header;
+
+      memcpy(&header, cursor, sizeof(WorldFileGridChunk));
+
+      auto* runs = (const u16*)(cursor + sizeof(WorldFileGridChunk));
+      u32 cellIndex = 0;
+
+      cursor += sizeof(WorldFileGridChunk) + alignTo4(header.totalRuns * sizeof(u16));
+
+      if (cursor > end) {
+        break;
+      }
+
+      for (u32 r = 0; r < header.totalRuns && cellIndex + runs[r] <= GRID_CHUNK_VOLUME; r++) {
+        // Odd runs are Ground
+        if (r % 2 == 1) {
+          grid.setRun<Ground>(header.origin, cellIndex, runs[r]);
+        }
+
+        cellIndex += runs[r];
+      }
+    }
+  } else if (section.type == WORLD_SECTION_GRID_RECORDS) {
+    switch (section.entityType) {
+      case STAIRCASE:
+        loadGridRecords<Staircase>(grid, section, data);
+        break;
+      case SWITCH:
+        loadGridRecords<Switch>(grid, section, data);
+        break;
+      case WORLD_ORIENTATION_CHANGE:
+        loadGridRecords<WorldOrientationChange>(grid, section, data);
+        break;
+      case TELEPORTER:
+        loadGridRecords<Teleporter>(grid, section, data);
+        break;
+      default:
+        break;
+    }
+  }
+}
\ No newline at end of file
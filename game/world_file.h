@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Gamma.h"
+#include "system/MappedFile.h"
+
+#include "grid_map.h"
+
+enum WorldFileSectionType {
+  WORLD_SECTION_GRID_CHUNKS,
+  WORLD_SECTION_GRID_RECORDS,
+  WORLD_SECTION_MESH_OBJECTS,
+  WORLD_SECTION_STATIC_STRUCTURE_OBJECTS,
+  WORLD_SECTION_LIGHTS
+};
+
+/**
+ * WorldFileSection
+ * ----------------
+ *
+ * An entry in a world file's section table, describing
+ * a typed block of data within the file.
+ */
+struct WorldFileSection {
+  u32 type = 0;
+  // The entity type of grid record sections
+  u32 entityType = EMPTY;
+  u32 offset = 0;
+  u32 size = 0;
+  u32 count = 0;
+  // The mesh name of object sections
+  char name[32] = { 0 };
+};
+
+/**
+ * WorldFileGridChunk
+ * ------------------
+ *
+ * Precedes the cell runs of each chunk in a grid chunks section.
+ * Runs are u16 lengths of alternating non-Ground and Ground cells
+ * in cell order, starting with non-Ground cells, and are padded
+ * to 4 bytes. Entities with records are stored in their own
+ * grid record sections instead.
+ */
+struct WorldFileGridChunk {
+  GridCoordinates origin;
+  u16 totalRuns = 0;
+};
+
+/**
+ * WorldFileObject
+ * ---------------
+ *
+ * The placement of an object in a mesh object or static
+ * structure objects section. Objects are recreated from
+ * these, since object records belong to their pools.
+ */
+struct WorldFileObject {
+  Gamma::Vec3f position;
+  Gamma::Vec3f scale;
+  Gamma::Vec3f rotation;
+  Gamma::pVec4 color;
+};
+
+/**
+ * WorldFileWriter
+ * ---------------
+ *
+ * Collects sections of world data, and writes them out
+ * to a world file along with a section table.
+ */
+struct WorldFileWriter {
+  void addGrid(const GridMap& grid);
+  void addLights(const std::vector<Gamma::Light>& lights);
+  void addObjects(WorldFileSectionType type, const std::string& meshName, const std::vector<Gamma::Object>& objects);
+  bool write(const char* path, const std::string& key) const;
+
+private:
+  std::vector<WorldFileSection> sections;
+  std::string data;
+
+  void addSection(WorldFileSectionType type, u32 entityType, const std::string& name, u32 count, const void* bytes, u32 size);
+
+  template<typename E>
+  void addGridRecords(const GridEntityPool<E>& pool);
+};
+
+/**
+ * WorldFileReader
+ * ---------------
+ *
+ * A memory-mapped view of a world file, valid only if
+ * the file exists, is intact, and was written with the
+ * same format version and source key.
+ */
+struct WorldFileReader {
+  WorldFileReader(const char* path, const std::string& key);
+
+  bool isValid() const;
+
+  /**
+   * Calls a function with each section in the file,
+   * in the order they were written, along with a
+   * pointer to the section's data.
+   */
+  template<typename F>
+  void forEachSection(F fn) const {
+    for (u32 i = 0; i < totalSections; i++) {
+      fn(sections[i], file.data() + sections[i].offset);
+    }
+  }
+
+private:
+  Gamma::MappedFile file;
+  const WorldFileSection* sections = nullptr;
+  u32 totalSections = 0;
+  bool isIntact = false;
+};
+
+std::string getWorldFileKey(const std::vector<std::string>& sourcePaths);
+void loadGridSection(GridMap& grid, const WorldFileSection& section, const char* data);
\ No newline at end of file
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "grid_map.h"
+#include "ground_mesher.h"
 #include "grid_utilities.h"
 #include "game_entities.h"
 
@@ -33,63 +34,6 @@
 struct GmContext;
 struct GameState;
 
-struct GridCoordinatesHasher {
-  std::size_t operator()(const GridCoordinates& coordinates) const {
-    u32 ux = u32(coordinates.x + 32768) & 0xFFFF;
-    u32 uy = u32(coordinates.y + 32768) & 0xFFFF;
-    u32 uz = u32(coordinates.z + 32768) & 0xFFFF;
-
-    // @todo check the frequency of hash collisions in actual level layouts
-    return (ux << 16 | uy) + uz;
-  }
-};
-
-template<typename T>
-struct GridMap : std::unordered_map<GridCoordinates, T*, GridCoordinatesHasher> {
-  void operator[](const GridCoordinates& coordinates) = delete;
-
-  void clear(const GridCoordinates& coordinates) {
-    if (find(coordinates) != end()) {
-      T* t = at(coordinates);
-
-      delete t;
-
-      erase(coordinates);
-    }
-  }
-
-  template<typename E>
-  u32 count() const {
-    u32 total = 0;
-
-    for (auto& [ coordinates, entity ] : *this) {
-      if (dynamic_cast<E*>(entity) != nullptr) {
-        total++;
-      }
-    }
-
-    return total;
-  }
-
-  template<typename E = T>
-  E* get(const GridCoordinates& coordinates) const {
-    if (find(coordinates) != end()) {
-      return (E*)at(coordinates);
-    }
-
-    return nullptr; 
-  }
-
-  bool has(const GridCoordinates& coordinates) const {
-    return find(coordinates) != end();
-  }
-
-  void set(const GridCoordinates& coordinates, T* value) {
-    clear(coordinates);
-    insert({ coordinates, value });
-  }
-};
-
 struct DynamicEntityManager {
   DynamicEntity* entities = nullptr;
 };
@@ -99,10 +43,15 @@ struct Zone {
   GridCoordinates start;
   GridCoordinates end;
   std::vector<std::string> meshNames;
+  std::vector<Gamma::MeshHandle> meshHandles;
+  // Whether the zone's meshes are retained, i.e. whether
+  // the camera is within the zone's prefetch margin
+  bool isLoaded = false;
 };
 
 struct World {
-  GridMap<GridEntity> grid;
+  GridMap grid;
+  GroundMesher groundMesher;
   DynamicEntityManager entities;
   std::vector<Zone> zones;
 };
@@ -113,6 +62,6 @@ void setGridEntityOverRange(GmContext* context, GameState& state, const GridCoor
   auto& grid = state.world.grid;
 
   overRange(start, end, {
-    grid.set({ x, y, z }, new E);
+    grid.set({ x, y, z }, E());
   });
 }
\ No newline at end of file
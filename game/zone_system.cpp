@@ -5,38 +5,71 @@
 
 using namespace Gamma;
 
-static bool cameraIsWithinZoneBoundaries(const Zone& zone, const Camera& camera) {
+// How far outside of a zone's boundaries (in tiles)
+// the camera can be before its meshes are loaded
+constexpr static s16 ZONE_PREFETCH_MARGIN = 8;
+// How long (in seconds) zone meshes remain loaded
+// after the camera leaves the prefetch margin, so
+// moving back and forth doesn't reload them
+constexpr static float ZONE_UNLOAD_GRACE_PERIOD = 10.f;
+
+static bool cameraIsWithinZoneBoundaries(const Zone& zone, const Camera& camera, s16 margin = 0) {
   auto coordinates = worldPositionToGridCoordinates(camera.position);
   auto& start = zone.start;
   auto& end = zone.end;
 
   return (
-    coordinates.x >= start.x && coordinates.x <= end.x &&
-    coordinates.y >= start.y && coordinates.y <= end.y &&
-    coordinates.z >= start.z && coordinates.z <= end.z
+    coordinates.x >= start.x - margin && coordinates.x <= end.x + margin &&
+    coordinates.y >= start.y - margin && coordinates.y <= end.y + margin &&
+    coordinates.z >= start.z - margin && coordinates.z <= end.z + margin
   );
 }
 
 static void toggleMeshesWithinZone(Globals, const Zone& zone, bool enabled) {
-  for (auto& meshName : zone.meshNames) {
-    mesh(meshName)->disabled = !enabled;
+  for (auto handle : zone.meshHandles) {
+    mesh(handle)->disabled = !enabled;
+  }
+}
+
+static void loadZone(Globals, Zone& zone) {
+  for (auto handle : zone.meshHandles) {
+    Gm_RetainMesh(context, handle);
   }
+
+  zone.isLoaded = true;
+}
+
+static void unloadZone(Globals, Zone& zone) {
+  // Meshes shared with other loaded zones are
+  // retained by them, and stay loaded
+  for (auto handle : zone.meshHandles) {
+    Gm_ReleaseMesh(context, handle, ZONE_UNLOAD_GRACE_PERIOD);
+  }
+
+  zone.isLoaded = false;
 }
 
 void handleZonesOnUpdate(Globals) {
   auto& camera = getCamera();
   auto& zones = state.world.zones;
-  auto coordinates = worldPositionToGridCoordinates(camera.position);
 
   for (auto& zone : zones) {
     bool isActiveZone = cameraIsWithinZoneBoundaries(zone, camera);
+    bool isNearbyZone = cameraIsWithinZoneBoundaries(zone, camera, ZONE_PREFETCH_MARGIN);
 
     #if DEVELOPMENT == 1
       if (state.editor.enabled) {
         isActiveZone = true;
+        isNearbyZone = true;
       }
     #endif
 
+    if (isNearbyZone && !zone.isLoaded) {
+      loadZone(globals, zone);
+    } else if (!isNearbyZone && zone.isLoaded) {
+      unloadZone(globals, zone);
+    }
+
     toggleMeshesWithinZone(globals, zone, isActiveZone);
   }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "math/utilities.h"
 #include "math/vector.h"
 #include "performance/benchmark.h"
+#include "performance/engine_benchmarks.h"
 #include "system/console.h"
 #include "system/context.h"
 #include "system/entities.h"
@@ -0,0 +1,73 @@
+#include <math.h>
+
+#include "math/frustum.h"
+
+namespace Gamma {
+  static Vec4f Gm_NormalizePlane(float a, float b, float c, float d) {
+    float length = sqrtf(a * a + b * b + c * c);
+
+    return Vec4f(a / length, b / length, c / length, d / length);
+  }
+
+  /**
+   * Frustum::box()
+   * --------------
+   *
+   * Creates an axis-aligned cube volume around a center point,
+   * e.g. to bound the range of a point light.
+   */
+  Frustum Frustum::box(const Vec3f& center, float halfSize) {
+    Frustum frustum;
+
+    frustum.planes[LEFT_PLANE] = Vec4f(1.f, 0, 0, halfSize - center.x);
+    frustum.planes[RIGHT_PLANE] = Vec4f(-1.f, 0, 0, halfSize + center.x);
+    frustum.planes[BOTTOM_PLANE] = Vec4f(0, 1.f, 0, halfSize - center.y);
+    frustum.planes[TOP_PLANE] = Vec4f(0, -1.f, 0, halfSize + center.y);
+    frustum.planes[NEAR_PLANE] = Vec4f(0, 0, 1.f, halfSize - center.z);
+    frustum.planes[FAR_PLANE] = Vec4f(0, 0, -1.f, halfSize + center.z);
+
+    return frustum;
+  }
+
+  /**
+   * Frustum::fromViewProjectionGL()
+   * -------------------------------
+   *
+   * Extracts frustum planes from a transposed (GL-layout)
+   * view-projection matrix, as passed to shaders, using the
+   * Gribb/Hartmann method. The matrix operates on GL space
+   * positions, so the z term of each plane is inverted to
+   * produce planes in engine space.
+   */
+  Frustum Frustum::fromViewProjectionGL(const Matrix4f& matViewProjection) {
+    auto& m = matViewProjection.m;
+    Frustum frustum;
+
+    // Rows of the untransposed matrix are the columns of the GL-layout one
+    Vec4f r0 = Vec4f(m[0], m[4], m[8], m[12]);
+    Vec4f r1 = Vec4f(m[1], m[5], m[9], m[13]);
+    Vec4f r2 = Vec4f(m[2], m[6], m[10], m[14]);
+    Vec4f r3 = Vec4f(m[3], m[7], m[11], m[15]);
+
+    frustum.planes[LEFT_PLANE] = Gm_NormalizePlane(r3.x + r0.x, r3.y + r0.y, -(r3.z + r0.z), r3.w + r0.w);
+    frustum.planes[RIGHT_PLANE] = Gm_NormalizePlane(r3.x - r0.x, r3.y - r0.y, -(r3.z - r0.z), r3.w - r0.w);
+    frustum.planes[BOTTOM_PLANE] = Gm_NormalizePlane(r3.x + r1.x, r3.y + r1.y, -(r3.z + r1.z), r3.w + r1.w);
+    frustum.planes[TOP_PLANE] = Gm_NormalizePlane(r3.x - r1.x, r3.y - r1.y, -(r3.z - r1.z), r3.w - r1.w);
+    frustum.planes[NEAR_PLANE] = Gm_NormalizePlane(r3.x + r2.x, r3.y + r2.y, -(r3.z + r2.z), r3.w + r2.w);
+    frustum.planes[FAR_PLANE] = Gm_NormalizePlane(r3.x - r2.x, r3.y - r2.y, -(r3.z - r2.z), r3.w - r2.w);
+
+    return frustum;
+  }
+
+  bool Frustum::isSphereVisible(const Vec3f& center, float radius) const {
+    for (u32 i = 0; i < 6; i++) {
+      auto& plane = planes[i];
+
+      if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "math/matrix.h"
+#include "math/vector.h"
+
+namespace Gamma {
+  /**
+   * Frustum
+   * -------
+   *
+   * A convex view volume bounded by six planes, stored as
+   * (a, b, c, d) with normalized (a, b, c) so that points
+   * satisfying ax + by + cz + d >= 0 lie on the inner side.
+   * Planes are expressed in engine (world) space.
+   */
+  struct Frustum {
+    enum Plane {
+      LEFT_PLANE,
+      RIGHT_PLANE,
+      BOTTOM_PLANE,
+      TOP_PLANE,
+      NEAR_PLANE,
+      FAR_PLANE
+    };
+
+    Vec4f planes[6];
+
+    static Frustum box(const Vec3f& center, float halfSize);
+    static Frustum fromViewProjectionGL(const Matrix4f& matViewProjection);
+
+    bool isSphereVisible(const Vec3f& center, float radius) const;
+  };
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "opengl/errors.h"
 #include "opengl/indirect_buffer.h"
+#include "opengl/instance_buffer.h"
 #include "opengl/OpenGLMesh.h"
+#include "opengl/texture_cache.h"
+#include "system/assert.h"
 #include "system/console.h"
 #include "system/flags.h"
 
@@ -18,13 +21,41 @@ namespace Gamma {
     VERTEX_NORMAL,
     VERTEX_TANGENT,
     VERTEX_UV,
-    MODEL_COLOR,
-    MODEL_MATRIX
+    INSTANCE_INDEX,
+    VERTEX_POSITION_OFFSET,
+    VERTEX_POSITION_SCALE
+  };
+
+  /**
+   * Shader storage binding points for per-instance
+   * data, matching shaders/utils/instances.glsl.
+   */
+  const enum GLStorageBinding {
+    INSTANCE_COLORS,
+    INSTANCE_MATRICES
   };
 
   OpenGLMesh::OpenGLMesh(const Mesh* mesh) {
     sourceMesh = mesh;
 
+    if (mesh->isResident) {
+      createBuffers();
+    }
+  }
+
+  OpenGLMesh::~OpenGLMesh() {
+    if (hasBuffers) {
+      destroyBuffers();
+    }
+  }
+
+  /**
+   * Creates the VAO and buffers for the source mesh,
+   * and buffers its geometry.
+   */
+  void OpenGLMesh::createBuffers() {
+    auto* mesh = sourceMesh;
+
     glGenVertexArrays(1, &vao);
     glGenBuffers(3, &buffers[0]);
     glGenBuffers(1, &ebo);
@@ -33,79 +64,179 @@ namespace Gamma {
     auto& vertices = mesh->vertices;
     auto& faceElements = mesh->faceElements;
 
-    // Buffer vertex data
-    glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::VERTEX]);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-    
     // Buffer vertex element data
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, faceElements.size() * sizeof(u32), faceElements.data(), GL_STATIC_DRAW);
 
-    // Define vertex attributes
+    // Buffer vertex data and define vertex attributes
     glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::VERTEX]);
 
     glEnableVertexAttribArray(GLAttribute::VERTEX_POSITION);
-    glVertexAttribPointer(GLAttribute::VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-
     glEnableVertexAttribArray(GLAttribute::VERTEX_NORMAL);
-    glVertexAttribPointer(GLAttribute::VERTEX_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-
     glEnableVertexAttribArray(GLAttribute::VERTEX_TANGENT);
-    glVertexAttribPointer(GLAttribute::VERTEX_TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
-
     glEnableVertexAttribArray(GLAttribute::VERTEX_UV);
-    glVertexAttribPointer(GLAttribute::VERTEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
 
-    // Define color attributes
-    glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::COLOR]);
-    glEnableVertexAttribArray(GLAttribute::MODEL_COLOR);
-    glVertexAttribIPointer(GLAttribute::MODEL_COLOR, 1, GL_UNSIGNED_INT, sizeof(pVec4), (void*)0);
-    glVertexAttribDivisor(GLAttribute::MODEL_COLOR, 1);
+    if (mesh->useQuantizedVertices) {
+      quantizedMinimum = mesh->minimumBounds;
+      quantizedMaximum = mesh->maximumBounds;
+
+      bufferQuantizedVertices(vertices, GL_STATIC_DRAW);
 
-    // Define matrix attributes
-    glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::MATRIX]);
+      #if GAMMA_DEVELOPER_MODE
+        auto error = Gm_MeasureQuantizationError(vertices.data(), quantizedVertices.data(), vertices.size(), quantizedMinimum, quantizedMaximum);
+
+        Console::log(
+          "[Gamma] Quantized mesh vertices:", vertices.size() * sizeof(Vertex), "->", quantizedVertices.size() * sizeof(QuantizedVertex), "bytes",
+          "| Max error: position", error.position, "normal", error.normal, "tangent", error.tangent, "uv", error.uv
+        );
+
+        assert(Gm_IsWithinQuantizationBounds(error, quantizedMinimum, quantizedMaximum), "Quantized vertex error out of bounds");
+      #endif
 
-    for (u32 i = 0; i < 4; i++) {
-      glEnableVertexAttribArray(GLAttribute::MODEL_MATRIX + i);
-      glVertexAttribPointer(GLAttribute::MODEL_MATRIX + i, 4, GL_FLOAT, GL_FALSE, sizeof(Matrix4f), (void*)(i * 4 * sizeof(float)));
-      glVertexAttribDivisor(GLAttribute::MODEL_MATRIX + i, 1);
+      // Static geometry doesn't need the staging buffer once
+      // uploaded, whereas transformed vertices reuse it
+      if (mesh->transformedVertices.size() == 0) {
+        std::vector<QuantizedVertex>().swap(quantizedVertices);
+      }
+
+      glVertexAttribPointer(GLAttribute::VERTEX_POSITION, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, position));
+      glVertexAttribPointer(GLAttribute::VERTEX_NORMAL, 2, GL_BYTE, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, normal));
+      glVertexAttribPointer(GLAttribute::VERTEX_TANGENT, 2, GL_BYTE, GL_TRUE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, tangent));
+      glVertexAttribPointer(GLAttribute::VERTEX_UV, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, uv));
+    } else {
+      glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+      glVertexAttribPointer(GLAttribute::VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+      glVertexAttribPointer(GLAttribute::VERTEX_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+      glVertexAttribPointer(GLAttribute::VERTEX_TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
+      glVertexAttribPointer(GLAttribute::VERTEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
     }
+
+    // Define instance index attributes. Instance colors/matrices
+    // are stored in pool order and read from shader storage using
+    // these indices, so each view can draw its own set of visible
+    // instances. The index buffer is bound per draw call.
+    glEnableVertexAttribArray(GLAttribute::INSTANCE_INDEX);
+    glVertexAttribIFormat(GLAttribute::INSTANCE_INDEX, 1, GL_UNSIGNED_INT, 0);
+    glVertexAttribBinding(GLAttribute::INSTANCE_INDEX, GLAttribute::INSTANCE_INDEX);
+    glVertexBindingDivisor(GLAttribute::INSTANCE_INDEX, 1);
+
+    hasBuffers = true;
+    bufferedGeometryVersion = mesh->geometryVersion;
   }
 
-  OpenGLMesh::~OpenGLMesh() {
-    // @todo
+  /**
+   * Frees the VAO, buffers and textures for the source
+   * mesh. Instance data is re-buffered in full if the
+   * buffers are created again.
+   */
+  void OpenGLMesh::destroyBuffers() {
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(3, &buffers[0]);
+    glDeleteBuffers(1, &ebo);
+
+    for (auto** texture : { &glTexture, &glNormalMap, &glSpecularityMap }) {
+      if (*texture != nullptr) {
+        Gm_ReleaseTexture(*texture);
+
+        *texture = nullptr;
+      }
+    }
+
+    std::vector<QuantizedVertex>().swap(quantizedVertices);
+
+    totalBufferedInstances = 0;
+    hasBuffers = false;
   }
 
-  void OpenGLMesh::checkAndLoadTexture(const std::string& path, OpenGLTexture*& texture, GLenum unit) {
+  /**
+   * Quantizes vertices against the mesh bounds captured at
+   * creation, and uploads them to the bound vertex buffer.
+   */
+  void OpenGLMesh::bufferQuantizedVertices(const std::vector<Vertex>& vertices, GLenum usage) {
+    Gm_QuantizeVertices(vertices.data(), vertices.size(), quantizedMinimum, quantizedMaximum, quantizedVertices);
+
+    glBufferData(GL_ARRAY_BUFFER, quantizedVertices.size() * sizeof(QuantizedVertex), quantizedVertices.data(), usage);
+  }
+
+  void OpenGLMesh::checkAndLoadTexture(const std::string& path, OpenGLTexture*& texture, GLenum unit, TextureType type) {
     #if GAMMA_DEVELOPER_MODE
       if (texture != nullptr && texture->getPath() != path) {
-        Console::log("[Gamma] Destroying OpenGLTexture:", texture->getPath());
-
-        delete texture;
+        Gm_ReleaseTexture(texture);
 
         texture = nullptr;
       }
     #endif
 
     if (path.size() > 0 && texture == nullptr) {
-      // @todo use a texture factory/cache
-      texture = new OpenGLTexture(path.c_str(), unit);
-
-      #if GAMMA_DEVELOPER_MODE
-        Console::log("[Gamma] OpenGLTexture created:", path);
-      #endif
+      texture = Gm_AcquireTexture(path, type);
     }
 
     if (texture != nullptr) {
-      texture->bind();
+      if (texture->isLoaded()) {
+        texture->bind(unit);
+      } else {
+        Gm_BindPlaceholderTexture(type, unit);
+      }
+    }
+  }
+
+  /**
+   * Uploads the instance colors/matrices which have changed since
+   * the last frame, or all of them when the pool's storage has
+   * been resized. Returns the number of bytes uploaded.
+   */
+  u32 OpenGLMesh::bufferInstances() {
+    auto& objects = sourceMesh->objects;
+    u32 totalBytes = 0;
+
+    if (!hasBuffers) {
+      return 0;
+    }
+
+    if (sourceMesh->type == MeshType::PARTICLE_SYSTEM) {
+      // Particles are positioned entirely in the vertex shader
+      return 0;
+    }
+
+    if (objects.capacity() != totalBufferedInstances) {
+      // Reallocate buffer storage to match the pool
+      totalBufferedInstances = objects.capacity();
+
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::COLOR]);
+      glBufferData(GL_SHADER_STORAGE_BUFFER, totalBufferedInstances * sizeof(pVec4), nullptr, GL_DYNAMIC_DRAW);
+
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::MATRIX]);
+      glBufferData(GL_SHADER_STORAGE_BUFFER, totalBufferedInstances * sizeof(Matrix4f), nullptr, GL_DYNAMIC_DRAW);
+
+      dirtyRanges.clear();
+      dirtyRanges.push_back({ 0, objects.totalActive() });
+    } else {
+      objects.getDirtyRanges(dirtyRanges);
+    }
+
+    for (auto& range : dirtyRanges) {
+      if (range.count == 0) {
+        continue;
+      }
+
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::COLOR]);
+      glBufferSubData(GL_SHADER_STORAGE_BUFFER, range.start * sizeof(pVec4), range.count * sizeof(pVec4), objects.getColors() + range.start);
+
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::MATRIX]);
+      glBufferSubData(GL_SHADER_STORAGE_BUFFER, range.start * sizeof(Matrix4f), range.count * sizeof(Matrix4f), objects.getMatrices() + range.start);
+
+      totalBytes += range.count * (sizeof(pVec4) + sizeof(Matrix4f));
     }
+
+    return totalBytes;
   }
 
   u16 OpenGLMesh::getId() const {
     return sourceMesh->id;
   }
 
-  u16 OpenGLMesh::getObjectCount() const {
+  u32 OpenGLMesh::getObjectCount() const {
     return sourceMesh->objects.totalActive();
   }
 
@@ -125,12 +256,46 @@ namespace Gamma {
     return sourceMesh->type == type;
   }
 
-  // @todo provide a parameter to render total visible vs. total active
-  void OpenGLMesh::render(GLenum primitiveMode, bool useLowestLevelOfDetail) {
+  bool OpenGLMesh::isStaticBatched() const {
+    return staticBatched;
+  }
+
+  void OpenGLMesh::setStaticBatched(bool staticBatched) {
+    if (this->staticBatched && !staticBatched) {
+      // Instances weren't buffered while the mesh was batched,
+      // so reallocate and buffer all of them on the next frame
+      totalBufferedInstances = 0;
+    }
+
+    this->staticBatched = staticBatched;
+  }
+
+  /**
+   * Creates or destroys GPU resources for streamed
+   * meshes as they are loaded or unloaded, and
+   * recreates them for meshes whose geometry
+   * has been replaced.
+   */
+  void OpenGLMesh::updateResidency() {
+    if (sourceMesh->isResident && !hasBuffers) {
+      createBuffers();
+    } else if (!sourceMesh->isResident && hasBuffers) {
+      destroyBuffers();
+    } else if (hasBuffers && bufferedGeometryVersion != sourceMesh->geometryVersion) {
+      destroyBuffers();
+      createBuffers();
+    }
+  }
+
+  /**
+   * Draws the mesh's instances in a given range, returning
+   * the number of draw calls issued.
+   */
+  u32 OpenGLMesh::render(GLenum primitiveMode, const GlInstanceRange& instances, bool useLowestLevelOfDetail) {
     auto& mesh = *sourceMesh;
 
-    if (mesh.objects.totalVisible() == 0 || mesh.disabled) {
-      return;
+    if (instances.count == 0 || mesh.disabled || !hasBuffers) {
+      return 0;
     }
 
     if (mesh.type != MeshType::REFRACTIVE) {
@@ -140,9 +305,9 @@ namespace Gamma {
       //
       // @todo if we use texture units which won't conflict with
       // the G-Buffer, we can have textured refractive objects.
-      checkAndLoadTexture(mesh.texture, glTexture, GL_TEXTURE0);
-      checkAndLoadTexture(mesh.normalMap, glNormalMap, GL_TEXTURE1);
-      checkAndLoadTexture(mesh.specularityMap, glSpecularityMap, GL_TEXTURE2);
+      checkAndLoadTexture(mesh.texture, glTexture, GL_TEXTURE0, TextureType::COLOR);
+      checkAndLoadTexture(mesh.normalMap, glNormalMap, GL_TEXTURE1, TextureType::NORMAL);
+      checkAndLoadTexture(mesh.specularityMap, glSpecularityMap, GL_TEXTURE2, TextureType::LINEAR);
     }
 
     if (sourceMesh->transformedVertices.size() > 0) {
@@ -150,39 +315,54 @@ namespace Gamma {
       auto& transformedVertices = sourceMesh->transformedVertices;
 
       glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::VERTEX]);
-      // @todo glMapBuffer (?)
-      glBufferData(GL_ARRAY_BUFFER, transformedVertices.size() * sizeof(Vertex), transformedVertices.data(), GL_DYNAMIC_DRAW);
-    }
 
-    if (!hasCreatedInstanceBuffers || mesh.type != MeshType::PARTICLE_SYSTEM) {
-      // Buffer instance colors/matrices
-      glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::COLOR]);
-      glBufferData(GL_ARRAY_BUFFER, mesh.objects.totalVisible() * sizeof(pVec4), mesh.objects.getColors(), GL_DYNAMIC_DRAW);
+      if (mesh.useQuantizedVertices) {
+        // Transformed vertices outside of the original
+        // bounds are clamped to them when quantized
+        bufferQuantizedVertices(transformedVertices, GL_DYNAMIC_DRAW);
+      } else {
+        // @todo glMapBuffer (?)
+        glBufferData(GL_ARRAY_BUFFER, transformedVertices.size() * sizeof(Vertex), transformedVertices.data(), GL_DYNAMIC_DRAW);
+      }
+    }
 
-      glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::MATRIX]);
-      glBufferData(GL_ARRAY_BUFFER, mesh.objects.totalVisible() * sizeof(Matrix4f), mesh.objects.getMatrices(), GL_DYNAMIC_DRAW);
+    // Supply vertex decoding parameters as constant attribute
+    // values, read by shaders/utils/vertex.glsl. Quantized
+    // positions are rescaled from the mesh bounds.
+    if (mesh.useQuantizedVertices) {
+      Vec3f extent = quantizedMaximum - quantizedMinimum;
 
-      hasCreatedInstanceBuffers = true;
+      glVertexAttrib4f(GLAttribute::VERTEX_POSITION_OFFSET, quantizedMinimum.x, quantizedMinimum.y, quantizedMinimum.z, 1.f);
+      glVertexAttrib3f(GLAttribute::VERTEX_POSITION_SCALE, extent.x, extent.y, extent.z);
+    } else {
+      glVertexAttrib4f(GLAttribute::VERTEX_POSITION_OFFSET, 0.f, 0.f, 0.f, 0.f);
+      glVertexAttrib3f(GLAttribute::VERTEX_POSITION_SCALE, 1.f, 1.f, 1.f);
     }
 
-    // Bind VAO/EBO and draw instances
+    // Bind instance data, VAO/EBO and visible
+    // instance indices, and draw instances
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GLStorageBinding::INSTANCE_COLORS, buffers[GLBuffer::COLOR]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GLStorageBinding::INSTANCE_MATRICES, buffers[GLBuffer::MATRIX]);
     glBindVertexArray(vao);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
+    Gm_BindInstanceRange(GLAttribute::INSTANCE_INDEX, instances);
+
     if (mesh.lods.size() > 0) {
-      if (useLowestLevelOfDetail) {
-        // Render all instances using the last LOD
-        auto& lod = mesh.lods.back();
+      if (useLowestLevelOfDetail || !instances.hasLodGroups) {
+        // Render all instances using a single LOD: the lowest
+        // where requested, or otherwise the highest, since the
+        // instances haven't been grouped by LOD for this view
+        auto& lod = useLowestLevelOfDetail ? mesh.lods.back() : mesh.lods[0];
 
-        glDrawElementsInstanced(primitiveMode, lod.elementCount, GL_UNSIGNED_INT, (void*)(lod.elementOffset * sizeof(u32)), mesh.objects.totalVisible());
+        glDrawElementsInstanced(primitiveMode, lod.elementCount, GL_UNSIGNED_INT, (void*)(lod.elementOffset * sizeof(u32)), instances.count);
       } else {
         // Generate draw commands for mesh instances at each
         // level of detail, and dispatch them all together
-        //
-        // @todo preallocate draw commands array
-        auto* commands = new GlDrawElementsIndirectCommand[mesh.lods.size()];
+        GlDrawElementsIndirectCommand commands[MAX_LOD_LEVELS];
+        u32 totalCommands = mesh.lods.size();
 
-        for (u32 i = 0; i < mesh.lods.size(); i++) {
+        for (u32 i = 0; i < totalCommands; i++) {
           auto& command = commands[i];
           auto& lod = mesh.lods[i];
 
@@ -196,21 +376,21 @@ namespace Gamma {
           command.baseVertex = 0;
         }
 
-        Gm_BufferDrawElementsIndirectCommands(commands, 2);
+        Gm_BufferDrawElementsIndirectCommands(commands, totalCommands);
 
-        glMultiDrawElementsIndirect(primitiveMode, GL_UNSIGNED_INT, 0, 2, 0);
-
-        delete[] commands;
+        glMultiDrawElementsIndirect(primitiveMode, GL_UNSIGNED_INT, 0, totalCommands, 0);
       }
     } else if (mesh.type == MeshType::PARTICLE_SYSTEM) {
       // @todo description
       glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::VERTEX]);
 
-      glDrawArraysInstanced(GL_POINTS, 0, 1, mesh.objects.totalVisible());
+      glDrawArraysInstanced(GL_POINTS, 0, 1, instances.count);
     } else {
       // No distinct level of detail meshes defined;
       // draw all mesh instances together
-      glDrawElementsInstanced(primitiveMode, mesh.faceElements.size(), GL_UNSIGNED_INT, (void*)0, mesh.objects.totalVisible());
+      glDrawElementsInstanced(primitiveMode, mesh.faceElements.size(), GL_UNSIGNED_INT, (void*)0, instances.count);
     }
+
+    return 1;
   }
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
+#include "opengl/instance_buffer.h"
 #include "opengl/OpenGLTexture.h"
+#include "opengl/texture_cache.h"
 #include "system/entities.h"
 #include "system/type_aliases.h"
+#include "system/vertex_quantization.h"
 
 namespace Gamma {
   class OpenGLMesh {
@@ -12,31 +16,55 @@ namespace Gamma {
     OpenGLMesh(const Mesh* mesh);
     ~OpenGLMesh();
 
+    u32 bufferInstances();
     u16 getId() const;
-    u16 getObjectCount() const;
+    u32 getObjectCount() const;
     const Mesh* getSourceMesh() const;
     bool hasNormalMap() const;
     bool hasTexture() const;
     bool isMeshType(MeshType type) const;
-    void render(GLenum primitiveMode, bool useLowestLevelOfDetail = false);
+    bool isStaticBatched() const;
+    void setStaticBatched(bool staticBatched);
+    void updateResidency();
+    u32 render(GLenum primitiveMode, const GlInstanceRange& instances, bool useLowestLevelOfDetail = false);
 
   private:
     const Mesh* sourceMesh = nullptr;
     GLuint vao;
     /**
-     * Buffers for instanced object attributes.
+     * Buffers for vertices and per-instance data.
      *
      * [0] Vertex
-     * [1] Color
-     * [2] Matrix
+     * [1] Color (shader storage)
+     * [2] Matrix (shader storage)
      */
     GLuint buffers[3];
     GLuint ebo;
+    bool hasBuffers = false;
+    /**
+     * Whether the mesh is currently drawn as part of
+     * a static batch, rather than on its own.
+     */
+    bool staticBatched = false;
+    u32 bufferedGeometryVersion = 0;
     OpenGLTexture* glTexture = nullptr;
     OpenGLTexture* glNormalMap = nullptr;
     OpenGLTexture* glSpecularityMap = nullptr;
-    bool hasCreatedInstanceBuffers = false;
+    u32 totalBufferedInstances = 0;
+    std::vector<ObjectRange> dirtyRanges;
+    /**
+     * Bounds which quantized vertex positions are normalized
+     * to, and a staging buffer for quantized vertices. The
+     * buffer is only kept for meshes with transformed vertices,
+     * which are re-quantized and re-uploaded as they change.
+     */
+    Vec3f quantizedMinimum;
+    Vec3f quantizedMaximum;
+    std::vector<QuantizedVertex> quantizedVertices;
 
-    void checkAndLoadTexture(const std::string& path, OpenGLTexture*& texture, GLenum unit);
+    void createBuffers();
+    void destroyBuffers();
+    void bufferQuantizedVertices(const std::vector<Vertex>& vertices, GLenum usage);
+    void checkAndLoadTexture(const std::string& path, OpenGLTexture*& texture, GLenum unit, TextureType type);
   };
 }
\ No newline at end of file
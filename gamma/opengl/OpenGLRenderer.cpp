@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <map>
 
 #include "SDL.h"
@@ -9,13 +10,16 @@
 
 #include "opengl/errors.h"
 #include "opengl/indirect_buffer.h"
+#include "opengl/instance_buffer.h"
 #include "opengl/OpenGLRenderer.h"
 #include "opengl/OpenGLScreenQuad.h"
 #include "opengl/renderer_setup.h"
+#include "opengl/texture_cache.h"
 #include "math/utilities.h"
 #include "system/camera.h"
 #include "system/console.h"
 #include "system/context.h"
+#include "system/culling.h"
 #include "system/entities.h"
 #include "system/flags.h"
 #include "system/scene.h"
@@ -24,6 +28,7 @@
 namespace Gamma {
   const static u32 MAX_LIGHTS = 1000;
   const static Vec4f FULL_SCREEN_TRANSFORM = { 0.0f, 0.0f, 1.0f, 1.0f };
+  const static u32 MAIN_VIEW = 0;
 
   const static Vec3f CUBE_MAP_DIRECTIONS[6] = {
     Vec3f(-1.0f, 0.0f, 0.0f),
@@ -67,6 +72,8 @@ namespace Gamma {
 
     // Initialize global buffers
     Gm_InitDrawIndirectBuffer();
+    Gm_InitInstanceBuffers();
+    Gm_InitTextureCache();
 
     // Initialize screen texture
     glGenTextures(1, &screenTexture);
@@ -128,6 +135,8 @@ namespace Gamma {
   void OpenGLRenderer::destroy() {
     Gm_DestroyRendererResources(buffers, shaders);
     Gm_DestroyDrawIndirectBuffer();
+    Gm_DestroyInstanceBuffers();
+    Gm_DestroyTextureCache();
 
     lightDisc.destroy();
 
@@ -139,16 +148,24 @@ namespace Gamma {
   void OpenGLRenderer::render() {
     auto& scene = gmContext->scene;
 
+    stats.instanceBytesUploaded = 0;
+    stats.drawCalls = 0;
+
+    // Textures are decoded in the background, and
+    // uploaded over the course of several frames
+    Gm_UploadLoadedTextures();
+
     // @todo consider moving this out of render() and
     // initializing probes before the rendering loop
     if (
       !areProbesRendered &&
-      // @hack make sure all mesh textures are loaded in from the
-      // initial rendered frame.
+      // Mesh textures are requested during the initial rendered
+      // frame, so wait until they've all finished loading
       //
       // @todo properly initialize meshes, then render probes,
       // then proceed to render the scene normally.
       frame > 0 &&
+      !Gm_IsLoadingTextures() &&
       scene.probeMap.size() > 0
     ) {
       Gm_SavePreviousFlags();
@@ -179,6 +196,7 @@ namespace Gamma {
     handleSettingsChanges();
     initializeRendererContext();
     initializeLightArrays();
+    initializeInstances();
     renderToAccumulationBuffer();
     renderPostEffects();
 
@@ -349,6 +367,282 @@ namespace Gamma {
     }
   }
 
+  /**
+   * Buffers instance data for each mesh, and determines the
+   * instances of each mesh visible to the main view and each
+   * shadowcaster view, packing any visible index lists into
+   * a single buffer for the frame.
+   */
+  void OpenGLRenderer::initializeInstances() {
+    auto& indices = visibility.indices;
+    auto& ranges = visibility.ranges;
+    u32 totalMeshes = glMeshes.size();
+    u32 totalViews = getPointShadowView(glPointShadowMaps.size());
+    // Pool visibility lists are determined by game code against
+    // the scene camera, and don't apply to other cameras (probes)
+    bool useSceneVisibility = ctx.activeCamera == &gmContext->scene.camera;
+
+    initializeViews();
+    initializeStaticBatches();
+
+    indices.clear();
+    ranges.resize(totalViews * totalMeshes);
+
+    for (u32 meshIndex = 0; meshIndex < totalMeshes; meshIndex++) {
+      auto* glMesh = glMeshes[meshIndex];
+      auto* sourceMesh = glMesh->getSourceMesh();
+      auto& objects = sourceMesh->objects;
+      auto* visibleIndices = objects.getVisibleIndices();
+
+      glMesh->updateResidency();
+
+      // Streamed meshes which aren't loaded have nothing to draw
+      if (!sourceMesh->isResident) {
+        for (u32 view = MAIN_VIEW; view < totalViews; view++) {
+          ranges[view * totalMeshes + meshIndex] = GlInstanceRange();
+        }
+
+        continue;
+      }
+
+      // Batched instances are buffered with their static batch
+      if (!glMesh->isStaticBatched()) {
+        stats.instanceBytesUploaded += glMesh->bufferInstances();
+      }
+
+      GlInstanceRange allInstances;
+
+      allInstances.count = objects.totalActive();
+
+      // Particle systems position their particles in shaders,
+      // so their objects can't be culled on the CPU
+      if (sourceMesh->type == MeshType::PARTICLE_SYSTEM) {
+        for (u32 view = MAIN_VIEW; view < totalViews; view++) {
+          ranges[view * totalMeshes + meshIndex] = allInstances;
+        }
+
+        continue;
+      }
+
+      // Main view
+      auto& mainViewRange = ranges[MAIN_VIEW * totalMeshes + meshIndex];
+
+      if (useSceneVisibility && visibleIndices != nullptr) {
+        mainViewRange.offset = indices.size();
+        mainViewRange.count = objects.totalVisible();
+        mainViewRange.isSequential = false;
+        mainViewRange.hasLodGroups = sourceMesh->lods.size() > 0;
+
+        indices.insert(indices.end(), visibleIndices, visibleIndices + objects.totalVisible());
+      } else if (useSceneVisibility) {
+        mainViewRange = allInstances;
+      } else {
+        mainViewRange = cullInstances(visibility.views[MAIN_VIEW], sourceMesh);
+      }
+
+      // Shadowcaster views
+      for (u32 view = MAIN_VIEW + 1; view < totalViews; view++) {
+        auto& range = ranges[view * totalMeshes + meshIndex];
+
+        if (sourceMesh->canCastShadows) {
+          range = cullInstances(visibility.views[view], sourceMesh);
+        } else {
+          range = GlInstanceRange();
+        }
+      }
+    }
+
+    visibility.totalMeshes = totalMeshes;
+
+    Gm_BufferVisibleInstances(indices.data(), indices.size());
+
+    initializeStaticBatchCommands();
+  }
+
+  /**
+   * Builds, rebuilds or frees static batches as their meshes
+   * are loaded, unloaded or changed, and buffers the instance
+   * data of those which are built. Meshes in built batches are
+   * drawn by their batch rather than on their own, which only
+   * changes when a batch is built, rebuilt or freed.
+   */
+  void OpenGLRenderer::initializeStaticBatches() {
+    for (auto* glStaticBatch : glStaticBatches) {
+      auto& batch = *glStaticBatch->getSourceBatch();
+
+      if (glStaticBatch->updateResidency()) {
+        for (auto* mesh : batch.meshes) {
+          glMeshes[mesh->index]->setStaticBatched(false);
+        }
+
+        if (glStaticBatch->isResident()) {
+          for (auto& draw : batch.draws) {
+            glMeshes[draw.mesh->index]->setStaticBatched(true);
+          }
+        }
+      }
+
+      stats.instanceBytesUploaded += glStaticBatch->bufferInstances();
+    }
+  }
+
+  /**
+   * Generates and buffers the draw commands for each built
+   * static batch in every view, using the visible instances
+   * determined for each of its meshes. Shadowcaster views draw
+   * the lowest level of detail, as with individual meshes.
+   */
+  void OpenGLRenderer::initializeStaticBatchCommands() {
+    auto& instances = visibility.staticBatchInstances;
+    auto& indices = visibility.staticBatchIndices;
+    auto& commands = visibility.staticBatchCommands;
+    u32 totalViews = visibility.views.size();
+    u32 firstDirectionalShadowView = getDirectionalShadowView(0, 0);
+    u32 firstSpotShadowView = getSpotShadowView(0);
+
+    for (auto* glStaticBatch : glStaticBatches) {
+      auto& batch = *glStaticBatch->getSourceBatch();
+
+      if (!glStaticBatch->isResident()) {
+        continue;
+      }
+
+      indices.clear();
+      commands.clear();
+      instances.resize(batch.draws.size());
+
+      for (u32 view = MAIN_VIEW; view < totalViews; view++) {
+        bool isDirectionalShadowView = view >= firstDirectionalShadowView && view < firstSpotShadowView;
+        u32 cascade = (view - firstDirectionalShadowView) % 3;
+
+        for (u32 i = 0; i < batch.draws.size(); i++) {
+          auto* mesh = batch.draws[i].mesh;
+          auto& range = visibility.ranges[view * visibility.totalMeshes + mesh->index];
+
+          instances[i].indices = range.isSequential ? nullptr : visibility.indices.data() + range.offset;
+          instances[i].count = range.count;
+
+          if (isDirectionalShadowView && mesh->maxCascade < cascade) {
+            instances[i].count = 0;
+          }
+        }
+
+        Gm_GenerateStaticBatchCommands(batch, instances.data(), view != MAIN_VIEW, indices, commands);
+      }
+
+      glStaticBatch->bufferCommands(indices, commands);
+    }
+  }
+
+  /**
+   * Determines the view volume for the main view and each
+   * shadowcaster view, mirroring the view-projection matrices
+   * used to render them.
+   */
+  void OpenGLRenderer::initializeViews() {
+    auto& views = visibility.views;
+    auto& camera = *ctx.activeCamera;
+
+    views.resize(getPointShadowView(glPointShadowMaps.size()));
+
+    // Main view
+    views[MAIN_VIEW].frustum = Frustum::fromViewProjectionGL(ctx.matView * ctx.matProjection);
+    views[MAIN_VIEW].isActive = true;
+
+    // Directional shadowcaster cascades
+    for (u32 mapIndex = 0; mapIndex < glDirectionalShadowMaps.size(); mapIndex++) {
+      auto& light = *ctx.directionalShadowcasters[mapIndex];
+
+      for (u32 cascade = 0; cascade < 3; cascade++) {
+        auto& view = views[getDirectionalShadowView(mapIndex, cascade)];
+
+        view.frustum = Frustum::fromViewProjectionGL(Gm_CreateCascadedLightViewProjectionMatrixGL(cascade, light.direction, camera));
+        view.isActive = true;
+      }
+    }
+
+    // Spot shadowcasters
+    for (u32 mapIndex = 0; mapIndex < glSpotShadowMaps.size(); mapIndex++) {
+      auto& glShadowMap = *glSpotShadowMaps[mapIndex];
+      auto& light = *glShadowMap.light;
+      auto& view = views[getSpotShadowView(mapIndex)];
+
+      view.isActive = !light.isStatic || !glShadowMap.isRendered;
+
+      if (view.isActive) {
+        Matrix4f matLightProjection = Matrix4f::glPerspective({ 1024, 1024 }, 120.0f, 1.0f, light.radius);
+        Matrix4f matLightView = Matrix4f::lookAt(light.position.gl(), light.direction.invert().gl(), Vec3f(0.0f, 1.0f, 0.0f));
+
+        view.frustum = Frustum::fromViewProjectionGL((matLightProjection * matLightView).transpose());
+      }
+    }
+
+    // Point shadowcasters, bounded by the light radius
+    // in every direction (the union of all cube faces)
+    for (u32 mapIndex = 0; mapIndex < glPointShadowMaps.size(); mapIndex++) {
+      auto& glShadowMap = *glPointShadowMaps[mapIndex];
+      auto& light = *ctx.pointShadowcasters[mapIndex];
+      auto& view = views[getPointShadowView(mapIndex)];
+
+      view.isActive = !light.isStatic || !glShadowMap.isRendered;
+      view.frustum = Frustum::box(light.position, light.radius);
+    }
+  }
+
+  GlInstanceRange OpenGLRenderer::cullInstances(const RendererView& view, const Mesh* mesh) {
+    auto& indices = visibility.indices;
+    auto& objects = mesh->objects;
+    GlInstanceRange range;
+
+    if (!view.isActive) {
+      return range;
+    }
+
+    range.offset = indices.size();
+    range.isSequential = false;
+
+    // Cull directly into the shared index buffer, then
+    // trim it down to the visible instances
+    indices.resize(range.offset + objects.totalActive());
+
+    range.count = Gm_CullSpheres(view.frustum, objects.getPositions(), objects.getScales(), mesh->boundingRadius, objects.totalActive(), indices.data() + range.offset);
+
+    indices.resize(range.offset + range.count);
+
+    return range;
+  }
+
+  u32 OpenGLRenderer::getDirectionalShadowView(u32 mapIndex, u32 cascade) const {
+    return MAIN_VIEW + 1 + mapIndex * 3 + cascade;
+  }
+
+  u32 OpenGLRenderer::getSpotShadowView(u32 mapIndex) const {
+    return getDirectionalShadowView(glDirectionalShadowMaps.size(), 0) + mapIndex;
+  }
+
+  u32 OpenGLRenderer::getPointShadowView(u32 mapIndex) const {
+    return getSpotShadowView(glSpotShadowMaps.size()) + mapIndex;
+  }
+
+  const GlInstanceRange& OpenGLRenderer::getVisibleInstances(u32 view, const OpenGLMesh* glMesh) const {
+    return visibility.ranges[view * visibility.totalMeshes + glMesh->getSourceMesh()->index];
+  }
+
+  /**
+   * Draws each built static batch in a given view with a
+   * static batch shader, assigning batch texture units to
+   * its staticBatchTextures samplers.
+   */
+  void OpenGLRenderer::renderStaticBatches(OpenGLShader& shader, u32 view) {
+    for (u32 slot = 0; slot < MAX_STATIC_BATCH_TEXTURES; slot++) {
+      shader.setInt("staticBatchTextures[" + std::to_string(slot) + "]", STATIC_BATCH_TEXTURE_UNIT + slot);
+    }
+
+    for (auto* glStaticBatch : glStaticBatches) {
+      stats.drawCalls += glStaticBatch->render(ctx.primitiveMode, view);
+    }
+  }
+
   /**
    * @todo description
    */
@@ -466,7 +760,7 @@ namespace Gamma {
         shaders.geometry.setBool("hasTexture", glMesh->hasTexture());
         shaders.geometry.setBool("hasNormalMap", glMesh->hasNormalMap());
 
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -478,7 +772,7 @@ namespace Gamma {
         shaders.geometry.setBool("hasTexture", glMesh->hasTexture());
         shaders.geometry.setBool("hasNormalMap", glMesh->hasNormalMap());
 
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -486,15 +780,23 @@ namespace Gamma {
     glStencilMask(MeshType::DEFAULT);
 
     for (auto* glMesh : glMeshes) {
-      if (glMesh->isMeshType(MeshType::DEFAULT)) {
+      if (glMesh->isMeshType(MeshType::DEFAULT) && !glMesh->isStaticBatched()) {
         shaders.geometry.setBool("hasTexture", glMesh->hasTexture());
         shaders.geometry.setBool("hasNormalMap", glMesh->hasNormalMap());
         shaders.geometry.setFloat("meshEmissivity", glMesh->getSourceMesh()->emissivity);
 
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
+    // Render static batches, which are made up of
+    // meshes of the default type
+    shaders.staticGeometry.use();
+    shaders.staticGeometry.setMatrix4f("matProjection", ctx.matProjection);
+    shaders.staticGeometry.setMatrix4f("matView", ctx.matView);
+
+    renderStaticBatches(shaders.staticGeometry, MAIN_VIEW);
+
     // Render foliage
     shaders.foliage.use();
     shaders.foliage.setMatrix4f("matProjection", ctx.matProjection);
@@ -513,7 +815,7 @@ namespace Gamma {
         shaders.foliage.setBool("hasNormalMap", glMesh->hasNormalMap());
         shaders.foliage.setFloat("meshEmissivity", glMesh->getSourceMesh()->emissivity);
 
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -543,7 +845,7 @@ namespace Gamma {
           if (glProbes.find(probeName) != glProbes.end()) {
             glProbes[probeName]->read();
 
-            glMesh->render(ctx.primitiveMode);
+            stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
           }
         }
       }
@@ -558,6 +860,10 @@ namespace Gamma {
   void OpenGLRenderer::renderDirectionalShadowMaps() {
     auto& camera = *ctx.activeCamera;
     auto& shader = shaders.shadowLightView;
+    auto& staticShader = shaders.staticShadowLightView;
+
+    staticShader.use();
+    staticShader.setInt("foliage.type", FoliageType::NONE);
 
     shader.use();
     shader.setFloat("time", gmContext->scene.runningTime);
@@ -573,24 +879,36 @@ namespace Gamma {
         glShadowMap.buffer.writeToAttachment(cascade);
         Matrix4f matLightViewProjection = Gm_CreateCascadedLightViewProjectionMatrixGL(cascade, light.direction, camera);
 
-        shader.setMatrix4f("matLightViewProjection", matLightViewProjection);
+        u32 view = getDirectionalShadowView(mapIndex, cascade);
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // @todo glMultiDrawElementsIndirect for static world geometry
-        // (will require a handful of other changes to mesh organization/data buffering)
+        shader.use();
+        shader.setMatrix4f("matLightViewProjection", matLightViewProjection);
+
         for (auto* glMesh : glMeshes) {
           auto* sourceMesh = glMesh->getSourceMesh();
           auto& foliage = sourceMesh->foliage;
 
+          if (glMesh->isStaticBatched()) {
+            continue;
+          }
+
           shader.setInt("foliage.type", foliage.type);
           shader.setFloat("foliage.speed", foliage.speed);
           shader.setBool("hasTexture", glMesh->hasTexture());
 
           if (sourceMesh->canCastShadows && sourceMesh->maxCascade >= cascade) {
-            glMesh->render(ctx.primitiveMode, true);
+            stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(view, glMesh), true);
           }
         }
+
+        // Static batch commands already leave out meshes
+        // which don't cast shadows into this cascade
+        staticShader.use();
+        staticShader.setMatrix4f("matLightViewProjection", matLightViewProjection);
+
+        renderStaticBatches(staticShader, view);
       }
     }
   }
@@ -600,6 +918,10 @@ namespace Gamma {
    */
   void OpenGLRenderer::renderSpotShadowMaps() {
     auto& shader = shaders.shadowLightView;
+    auto& staticShader = shaders.staticShadowLightView;
+
+    staticShader.use();
+    staticShader.setInt("foliage.type", FoliageType::NONE);
 
     shader.use();
     shader.setInt("meshTexture", 0);
@@ -620,25 +942,33 @@ namespace Gamma {
 
       glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+      shader.use();
       shader.setMatrix4f("matLightViewProjection", matLightViewProjection);
 
-      // @todo glMultiDrawElementsIndirect for static world geometry
-      // (will require a handful of other changes to mesh organization/data buffering)
       // @todo allow specific meshes to be associated with spot lights + rendered to shadow maps
       for (auto* glMesh : glMeshes) {
         auto* sourceMesh = glMesh->getSourceMesh();
         // @todo check foliage behavior for correctness
         auto& foliage = sourceMesh->foliage;
 
+        if (glMesh->isStaticBatched()) {
+          continue;
+        }
+
         shader.setInt("foliage.type", foliage.type);
         shader.setFloat("foliage.speed", foliage.speed);
         shader.setBool("hasTexture", glMesh->hasTexture());
 
         if (sourceMesh->canCastShadows) {
-          glMesh->render(ctx.primitiveMode, true);
+          stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(getSpotShadowView(mapIndex), glMesh), true);
         }
       }
 
+      staticShader.use();
+      staticShader.setMatrix4f("matLightViewProjection", matLightViewProjection);
+
+      renderStaticBatches(staticShader, getSpotShadowView(mapIndex));
+
       glShadowMap.isRendered = true;
     }
   }
@@ -678,19 +1008,23 @@ namespace Gamma {
       shader.setVec3f("lightPosition", light.position.gl());
       shader.setFloat("farPlane", light.radius);
 
-      // @todo glMultiDrawElementsIndirect for static world geometry
-      // (will require a handful of other changes to mesh organization/data buffering)
       // @todo allow specific meshes to be associated with point lights + rendered to shadow maps
       for (auto* glMesh : glMeshes) {
         auto* sourceMesh = glMesh->getSourceMesh();
 
         // @todo handle foliage (requires point shadowcaster view shader updates)
 
-        if (sourceMesh->canCastShadows) {
-          glMesh->render(ctx.primitiveMode, true);
+        if (sourceMesh->canCastShadows && !glMesh->isStaticBatched()) {
+          stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(getPointShadowView(mapIndex), glMesh), true);
         }
       }
 
+      // Point shadowcaster views don't sample textures,
+      // so static batches can be drawn with the same shader
+      for (auto* glStaticBatch : glStaticBatches) {
+        stats.drawCalls += glStaticBatch->render(ctx.primitiveMode, getPointShadowView(mapIndex));
+      }
+
       glShadowMap.isRendered = true;
     }
   }
@@ -1045,7 +1379,7 @@ namespace Gamma {
         shaders.particles.setInt("path.total", totalPathPoints);
         shaders.particles.setBool("path.is_circuit", particles.isCircuit);
 
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -1085,7 +1419,7 @@ namespace Gamma {
 
       for (auto* glMesh : glMeshes) {
         if (glMesh->isMeshType(MeshType::REFRACTIVE)) {
-          glMesh->render(ctx.primitiveMode);
+          stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
         }
       }
 
@@ -1175,7 +1509,7 @@ namespace Gamma {
 
     for (auto* glMesh : glMeshes) {
       if (glMesh->isMeshType(MeshType::REFRACTIVE)) {
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -1243,7 +1577,7 @@ namespace Gamma {
 
     for (auto* glMesh : glMeshes) {
       if (glMesh->isMeshType(MeshType::WATER)) {
-        glMesh->render(ctx.primitiveMode);
+        stats.drawCalls += glMesh->render(ctx.primitiveMode, getVisibleInstances(MAIN_VIEW, glMesh));
       }
     }
 
@@ -1329,6 +1663,10 @@ namespace Gamma {
     #endif
   }
 
+  void OpenGLRenderer::createStaticBatch(StaticBatch* batch) {
+    glStaticBatches.push_back(new OpenGLStaticBatch(batch));
+  }
+
   void OpenGLRenderer::createShadowMap(const Light* light) {
     switch (light->type) {
       case LightType::DIRECTIONAL_SHADOWCASTER:
@@ -1459,6 +1797,7 @@ namespace Gamma {
       ctx.matInverseProjection = ctx.matProjection.inverse();
       ctx.matInverseView = ctx.matView.inverse();
 
+      initializeInstances();
       renderToAccumulationBuffer();
 
       ctx.accumulationSource->read();
@@ -5,10 +5,13 @@
 #include "SDL.h"
 #include "SDL_ttf.h"
 
+#include "math/frustum.h"
 #include "math/vector.h"
 #include "opengl/framebuffer.h"
+#include "opengl/instance_buffer.h"
 #include "opengl/OpenGLLightDisc.h"
 #include "opengl/OpenGLMesh.h"
+#include "opengl/OpenGLStaticBatch.h"
 #include "opengl/shader.h"
 #include "opengl/shadowmaps.h"
 #include "system/AbstractRenderer.h"
@@ -27,6 +30,7 @@ namespace Gamma {
   struct RendererShaders {
     // Rendering pipeline shaders
     OpenGLShader geometry;
+    OpenGLShader staticGeometry;
     OpenGLShader foliage;
     OpenGLShader probeReflector;
     OpenGLShader particles;
@@ -49,6 +53,7 @@ namespace Gamma {
     OpenGLShader spotShadowcaster;
     OpenGLShader pointShadowcasterView;
     OpenGLShader shadowLightView;
+    OpenGLShader staticShadowLightView;
     OpenGLShader pointShadowcaster;
 
     // Dev shaders
@@ -81,6 +86,34 @@ namespace Gamma {
     // @todo target (fbo)
   };
 
+  /**
+   * A view volume that mesh instances are culled against.
+   * Views which won't be rendered in a given frame (e.g.
+   * static shadowcasters which have already been rendered)
+   * are inactive, and skip culling entirely.
+   */
+  struct RendererView {
+    Frustum frustum;
+    bool isActive = true;
+  };
+
+  /**
+   * Per-frame instance visibility for each view rendered by
+   * the renderer: the main view, followed by each directional
+   * shadowcaster cascade and each spot/point shadowcaster.
+   * Visible index lists for every view share one buffer.
+   */
+  struct RendererVisibility {
+    std::vector<RendererView> views;
+    std::vector<u32> indices;
+    std::vector<GlInstanceRange> ranges;
+    u32 totalMeshes = 0;
+    // Scratch buffers for generating static batch commands
+    std::vector<StaticBatchInstances> staticBatchInstances;
+    std::vector<u32> staticBatchIndices;
+    std::vector<StaticBatchCommand> staticBatchCommands;
+  };
+
   class OpenGLRenderer final : public AbstractRenderer {
   public:
     OpenGLRenderer(GmContext* gmContext): AbstractRenderer(gmContext) {};
@@ -91,6 +124,7 @@ namespace Gamma {
     virtual void render() override;
     virtual void createMesh(const Mesh* mesh) override;
     virtual void createShadowMap(const Light* light) override;
+    virtual void createStaticBatch(StaticBatch* batch) override;
     virtual void destroyMesh(const Mesh* mesh) override;
     virtual void destroyShadowMap(const Light* light) override;
     virtual const RenderStats& getRenderStats() override;
@@ -103,11 +137,13 @@ namespace Gamma {
     RendererBuffers buffers;
     RendererShaders shaders;
     RendererContext ctx;
+    RendererVisibility visibility;
     OpenGLLightDisc lightDisc;
     OpenGLShader screen;
     GLuint screenTexture = 0;
     u32 frame = 0;
     std::vector<OpenGLMesh*> glMeshes;
+    std::vector<OpenGLStaticBatch*> glStaticBatches;
     std::vector<OpenGLDirectionalShadowMap*> glDirectionalShadowMaps;
     std::vector<OpenGLPointShadowMap*> glPointShadowMaps;
     std::vector<OpenGLSpotShadowMap*> glSpotShadowMaps;
@@ -144,6 +180,16 @@ namespace Gamma {
     void handleSettingsChanges();
     void initializeRendererContext();
     void initializeLightArrays();
+    void initializeInstances();
+    void initializeStaticBatches();
+    void initializeStaticBatchCommands();
+    void initializeViews();
+    GlInstanceRange cullInstances(const RendererView& view, const Mesh* mesh);
+    u32 getDirectionalShadowView(u32 mapIndex, u32 cascade) const;
+    u32 getSpotShadowView(u32 mapIndex) const;
+    u32 getPointShadowView(u32 mapIndex) const;
+    const GlInstanceRange& getVisibleInstances(u32 view, const OpenGLMesh* glMesh) const;
+    void renderStaticBatches(OpenGLShader& shader, u32 view);
     void renderSurfaceToScreen(SDL_Surface* surface, u32 x, u32 y, const Vec3f& color, const Vec4f& background);
     void renderToAccumulationBuffer();
     void swapAccumulationBuffers();
@@ -0,0 +1,289 @@
+#include "opengl/OpenGLStaticBatch.h"
+#include "opengl/texture_cache.h"
+#include "system/console.h"
+#include "system/entities.h"
+
+#include "glew.h"
+
+namespace Gamma {
+  const enum GLBuffer {
+    VERTEX,
+    COLOR,
+    MATRIX,
+    MATERIAL,
+    INSTANCE_INDICES,
+    COMMAND
+  };
+
+  /**
+   * Vertex attribute locations, matching those of OpenGLMesh
+   * so static batches can be drawn with the same shaders.
+   */
+  const enum GLAttribute {
+    VERTEX_POSITION,
+    VERTEX_NORMAL,
+    VERTEX_TANGENT,
+    VERTEX_UV,
+    INSTANCE_INDEX,
+    VERTEX_POSITION_OFFSET,
+    VERTEX_POSITION_SCALE
+  };
+
+  /**
+   * Shader storage binding points, matching shaders/utils/instances.glsl
+   * and shaders/utils/static-batch.glsl.
+   */
+  const enum GLStorageBinding {
+    INSTANCE_COLORS,
+    INSTANCE_MATRICES,
+    STATIC_BATCH_MATERIALS
+  };
+
+  OpenGLStaticBatch::OpenGLStaticBatch(StaticBatch* batch) {
+    sourceBatch = batch;
+  }
+
+  OpenGLStaticBatch::~OpenGLStaticBatch() {
+    if (hasBuffers) {
+      destroyBuffers();
+    }
+  }
+
+  /**
+   * Binds the batch's textures to consecutive units, starting
+   * at STATIC_BATCH_TEXTURE_UNIT, in slot order.
+   */
+  void OpenGLStaticBatch::bindTextures() {
+    auto& textures = sourceBatch->textures;
+
+    for (u32 slot = 0; slot < glTextures.size(); slot++) {
+      auto* texture = glTextures[slot];
+      GLenum unit = GL_TEXTURE0 + STATIC_BATCH_TEXTURE_UNIT + slot;
+
+      if (texture->isLoaded()) {
+        texture->bind(unit);
+      } else {
+        Gm_BindPlaceholderTexture(textures[slot].type, unit);
+      }
+    }
+  }
+
+  /**
+   * Builds the source batch, and creates the VAO and buffers
+   * for its arena and materials. The arena is freed once it's
+   * been buffered, keeping only the draws and materials.
+   */
+  void OpenGLStaticBatch::createBuffers() {
+    auto& batch = *sourceBatch;
+
+    Gm_BuildStaticBatch(batch);
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(6, &buffers[0]);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+
+    // Buffer arena face elements and vertices, and define vertex
+    // attributes. Batched vertices are always unquantized, since
+    // each mesh is quantized against its own bounds.
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, batch.faceElements.size() * sizeof(u32), batch.faceElements.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::VERTEX]);
+    glBufferData(GL_ARRAY_BUFFER, batch.vertices.size() * sizeof(Vertex), batch.vertices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(GLAttribute::VERTEX_POSITION);
+    glEnableVertexAttribArray(GLAttribute::VERTEX_NORMAL);
+    glEnableVertexAttribArray(GLAttribute::VERTEX_TANGENT);
+    glEnableVertexAttribArray(GLAttribute::VERTEX_UV);
+
+    glVertexAttribPointer(GLAttribute::VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glVertexAttribPointer(GLAttribute::VERTEX_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glVertexAttribPointer(GLAttribute::VERTEX_TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
+    glVertexAttribPointer(GLAttribute::VERTEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
+
+    // Define instance index attributes, as with OpenGLMesh. Commands
+    // read batch instance indices starting at their baseInstance.
+    glEnableVertexAttribArray(GLAttribute::INSTANCE_INDEX);
+    glVertexAttribIFormat(GLAttribute::INSTANCE_INDEX, 1, GL_UNSIGNED_INT, 0);
+    glVertexAttribBinding(GLAttribute::INSTANCE_INDEX, GLAttribute::INSTANCE_INDEX);
+    glVertexBindingDivisor(GLAttribute::INSTANCE_INDEX, 1);
+
+    // Allocate instance storage for every batched object slot
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::COLOR]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, batch.totalInstances * sizeof(pVec4), nullptr, GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::MATRIX]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, batch.totalInstances * sizeof(Matrix4f), nullptr, GL_DYNAMIC_DRAW);
+
+    // Buffer materials, in draw order
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::MATERIAL]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, batch.materials.size() * sizeof(StaticBatchMaterial), batch.materials.data(), GL_STATIC_DRAW);
+
+    for (auto& texture : batch.textures) {
+      glTextures.push_back(Gm_AcquireTexture(texture.path, texture.type));
+    }
+
+    #if GAMMA_DEVELOPER_MODE
+      Console::log(
+        "[Gamma] Static batch '" + batch.name + "' built:",
+        batch.draws.size(), "draws,",
+        batch.vertices.size(), "vertices,",
+        batch.faceElements.size() / 3, "triangles,",
+        batch.textures.size(), "textures"
+      );
+    #endif
+
+    std::vector<Vertex>().swap(batch.vertices);
+    std::vector<u32>().swap(batch.faceElements);
+
+    hasBuffers = true;
+    hasBufferedInstances = false;
+  }
+
+  void OpenGLStaticBatch::destroyBuffers() {
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(6, &buffers[0]);
+    glDeleteBuffers(1, &ebo);
+
+    for (auto* texture : glTextures) {
+      Gm_ReleaseTexture(texture);
+    }
+
+    glTextures.clear();
+    totalViewInstances.clear();
+
+    hasBuffers = false;
+  }
+
+  /**
+   * Uploads the instance colors/matrices of batched objects
+   * which have changed since the last frame, or all of them
+   * after the batch is built. Returns the number of bytes
+   * uploaded.
+   */
+  u32 OpenGLStaticBatch::bufferInstances() {
+    u32 totalBytes = 0;
+
+    if (!hasBuffers) {
+      return 0;
+    }
+
+    for (auto& draw : sourceBatch->draws) {
+      auto& objects = draw.mesh->objects;
+
+      if (hasBufferedInstances) {
+        objects.getDirtyRanges(dirtyRanges);
+      } else {
+        dirtyRanges.clear();
+        dirtyRanges.push_back({ 0, objects.totalActive() });
+      }
+
+      for (auto& range : dirtyRanges) {
+        if (range.count == 0) {
+          continue;
+        }
+
+        u32 start = draw.baseInstance + range.start;
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::COLOR]);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, start * sizeof(pVec4), range.count * sizeof(pVec4), objects.getColors() + range.start);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[GLBuffer::MATRIX]);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, start * sizeof(Matrix4f), range.count * sizeof(Matrix4f), objects.getMatrices() + range.start);
+
+        totalBytes += range.count * (sizeof(pVec4) + sizeof(Matrix4f));
+      }
+    }
+
+    hasBufferedInstances = true;
+
+    return totalBytes;
+  }
+
+  /**
+   * Uploads the batch instance indices and draw commands for
+   * each view, as generated by Gm_GenerateStaticBatchCommands(),
+   * with the commands for every view laid out one after another.
+   */
+  void OpenGLStaticBatch::bufferCommands(const std::vector<u32>& instanceIndices, const std::vector<StaticBatchCommand>& commands) {
+    u32 totalDraws = sourceBatch->draws.size();
+
+    if (!hasBuffers || totalDraws == 0) {
+      return;
+    }
+
+    totalViewInstances.assign(commands.size() / totalDraws, 0);
+
+    for (u32 i = 0; i < commands.size(); i++) {
+      totalViewInstances[i / totalDraws] += commands[i].instanceCount;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[GLBuffer::INSTANCE_INDICES]);
+    glBufferData(GL_ARRAY_BUFFER, instanceIndices.size() * sizeof(u32), instanceIndices.data(), GL_STREAM_DRAW);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffers[GLBuffer::COMMAND]);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(StaticBatchCommand), commands.data(), GL_STREAM_DRAW);
+  }
+
+  const StaticBatch* OpenGLStaticBatch::getSourceBatch() const {
+    return sourceBatch;
+  }
+
+  bool OpenGLStaticBatch::isResident() const {
+    return hasBuffers;
+  }
+
+  /**
+   * Builds the batch once all of its meshes are resident,
+   * frees it when any of them are unloaded, and rebuilds
+   * it when it no longer matches its meshes. Returns true
+   * if the batch was built, freed or rebuilt.
+   */
+  bool OpenGLStaticBatch::updateResidency() {
+    bool isReady = Gm_IsStaticBatchReady(*sourceBatch);
+
+    if (isReady && !hasBuffers) {
+      createBuffers();
+    } else if (!isReady && hasBuffers) {
+      destroyBuffers();
+    } else if (hasBuffers && Gm_IsStaticBatchStale(*sourceBatch)) {
+      destroyBuffers();
+      createBuffers();
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Draws every batched mesh's visible instances in a given
+   * view with a single multi-draw, returning the number of
+   * draw calls issued.
+   */
+  u32 OpenGLStaticBatch::render(GLenum primitiveMode, u32 view) {
+    u32 totalDraws = sourceBatch->draws.size();
+
+    if (!hasBuffers || view >= totalViewInstances.size() || totalViewInstances[view] == 0) {
+      return 0;
+    }
+
+    bindTextures();
+
+    glVertexAttrib4f(GLAttribute::VERTEX_POSITION_OFFSET, 0.f, 0.f, 0.f, 0.f);
+    glVertexAttrib3f(GLAttribute::VERTEX_POSITION_SCALE, 1.f, 1.f, 1.f);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GLStorageBinding::INSTANCE_COLORS, buffers[GLBuffer::COLOR]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GLStorageBinding::INSTANCE_MATRICES, buffers[GLBuffer::MATRIX]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GLStorageBinding::STATIC_BATCH_MATERIALS, buffers[GLBuffer::MATERIAL]);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBindVertexBuffer(GLAttribute::INSTANCE_INDEX, buffers[GLBuffer::INSTANCE_INDICES], 0, sizeof(u32));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffers[GLBuffer::COMMAND]);
+
+    glMultiDrawElementsIndirect(primitiveMode, GL_UNSIGNED_INT, (void*)(view * totalDraws * sizeof(StaticBatchCommand)), totalDraws, 0);
+
+    return 1;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "opengl/OpenGLTexture.h"
+#include "system/ObjectPool.h"
+#include "system/static_batching.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * The first texture unit static batch textures are bound to,
+   * following the units used by individual mesh textures and
+   * probe maps.
+   */
+  const static u32 STATIC_BATCH_TEXTURE_UNIT = 4;
+
+  class OpenGLStaticBatch {
+  public:
+    OpenGLStaticBatch(StaticBatch* batch);
+    ~OpenGLStaticBatch();
+
+    u32 bufferInstances();
+    void bufferCommands(const std::vector<u32>& instanceIndices, const std::vector<StaticBatchCommand>& commands);
+    const StaticBatch* getSourceBatch() const;
+    bool isResident() const;
+    bool updateResidency();
+    u32 render(GLenum primitiveMode, u32 view);
+
+  private:
+    StaticBatch* sourceBatch = nullptr;
+    GLuint vao;
+    /**
+     * Buffers for the batch arena, per-instance data
+     * and per-frame draw commands.
+     *
+     * [0] Vertex
+     * [1] Color (shader storage)
+     * [2] Matrix (shader storage)
+     * [3] Material (shader storage)
+     * [4] Instance index
+     * [5] Draw indirect commands
+     */
+    GLuint buffers[6];
+    GLuint ebo;
+    bool hasBuffers = false;
+    bool hasBufferedInstances = false;
+    std::vector<OpenGLTexture*> glTextures;
+    std::vector<ObjectRange> dirtyRanges;
+    /**
+     * Visible instances in each view the commands
+     * were generated for, so views without any
+     * can be skipped entirely.
+     */
+    std::vector<u32> totalViewInstances;
+
+    void bindTextures();
+    void createBuffers();
+    void destroyBuffers();
+  };
+}
\ No newline at end of file
@@ -1,39 +1,25 @@
 #include <string>
 
 #include "opengl/OpenGLTexture.h"
-#include "system/assert.h"
 
 #include "glew.h"
-#include "SDL_image.h"
 
 namespace Gamma {
-  OpenGLTexture::OpenGLTexture(const std::string& path, GLenum unit) {
-    this->unit = unit;
+  /**
+   * Textures are created empty, and have their image data
+   * uploaded once loaded (see opengl/texture_cache.h).
+   */
+  OpenGLTexture::OpenGLTexture(const std::string& path) {
     this->path = path;
 
-    SDL_Surface* surface = IMG_Load(path.c_str());
-
-    assert(surface != 0, "Failed to load texture: " + path);
-
-    GLuint format = surface->format->BytesPerPixel == 4 ? GL_RGBA : GL_RGB;
-
     glGenTextures(1, &id);
-
-    bind();
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, surface->w, surface->h, 0, format, GL_UNSIGNED_BYTE, surface->pixels);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    SDL_FreeSurface(surface);
   }
 
   OpenGLTexture::~OpenGLTexture() {
     glDeleteTextures(1, &id);
   }
 
-  void OpenGLTexture::bind() {
+  void OpenGLTexture::bind(GLenum unit) {
     glActiveTexture(unit);
     glBindTexture(GL_TEXTURE_2D, id);
   }
@@ -41,4 +27,36 @@ namespace Gamma {
   const std::string& OpenGLTexture::getPath() const {
     return path;
   }
+
+  bool OpenGLTexture::isLoaded() const {
+    return loaded;
+  }
+
+  /**
+   * Uploads a cooked texture, including its precomputed mips.
+   */
+  void OpenGLTexture::upload(const CookedTexture& cooked) {
+    const static GLenum formats[] = {
+      GL_COMPRESSED_RGB_S3TC_DXT1_EXT,   // BC1
+      GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,  // BC3
+      GL_COMPRESSED_RG_RGTC2,            // BC5
+      GL_COMPRESSED_RGBA_BPTC_UNORM      // BC7
+    };
+
+    GLenum format = formats[(u32)cooked.format];
+
+    glBindTexture(GL_TEXTURE_2D, id);
+
+    for (u32 level = 0; level < cooked.mips.size(); level++) {
+      auto& mip = cooked.mips[level];
+
+      glCompressedTexImage2D(GL_TEXTURE_2D, level, format, mip.width, mip.height, 0, mip.size, cooked.data.data() + mip.offset);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, cooked.mips.size() - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    loaded = true;
+  }
 }
\ No newline at end of file
@@ -2,20 +2,23 @@
 
 #include <string>
 
+#include "system/texture_cooker.h"
 #include "system/type_aliases.h"
 
 namespace Gamma {
   class OpenGLTexture {
   public:
-    OpenGLTexture(const std::string& path, GLenum unit);
+    OpenGLTexture(const std::string& path);
     ~OpenGLTexture();
 
-    void bind();
+    void bind(GLenum unit);
     const std::string& getPath() const;
+    bool isLoaded() const;
+    void upload(const CookedTexture& cooked);
 
   private:
-    GLuint id;
-    GLenum unit;
+    GLuint id = 0;
     std::string path;
+    bool loaded = false;
   };
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <vector>
+
+#include "opengl/instance_buffer.h"
+
+#include "glew.h"
+
+namespace Gamma {
+  GLuint glVisibilityBuffer = 0;
+  GLuint glSequentialIndexBuffer = 0;
+  u32 totalSequentialIndices = 0;
+
+  void Gm_InitInstanceBuffers() {
+    glGenBuffers(1, &glVisibilityBuffer);
+    glGenBuffers(1, &glSequentialIndexBuffer);
+  }
+
+  /**
+   * Binds the object indices for a range of instances to
+   * the provided vertex buffer binding of the current VAO.
+   */
+  void Gm_BindInstanceRange(GLuint bindingIndex, const GlInstanceRange& range) {
+    if (range.isSequential) {
+      if (range.count > totalSequentialIndices) {
+        // Grow the shared sequential index buffer to
+        // accommodate the largest range drawn so far
+        std::vector<u32> indices;
+        u32 total = totalSequentialIndices > 0 ? totalSequentialIndices : 1024;
+
+        while (total < range.count) {
+          total *= 2;
+        }
+
+        indices.resize(total);
+
+        for (u32 i = 0; i < total; i++) {
+          indices[i] = i;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, glSequentialIndexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, total * sizeof(u32), indices.data(), GL_STATIC_DRAW);
+
+        totalSequentialIndices = total;
+      }
+
+      glBindVertexBuffer(bindingIndex, glSequentialIndexBuffer, 0, sizeof(u32));
+    } else {
+      glBindVertexBuffer(bindingIndex, glVisibilityBuffer, range.offset * sizeof(u32), sizeof(u32));
+    }
+  }
+
+  /**
+   * Uploads the per-view visible object index lists
+   * referenced by non-sequential instance ranges.
+   */
+  void Gm_BufferVisibleInstances(const u32* indices, u32 total) {
+    glBindBuffer(GL_ARRAY_BUFFER, glVisibilityBuffer);
+    glBufferData(GL_ARRAY_BUFFER, total * sizeof(u32), indices, GL_STREAM_DRAW);
+  }
+
+  void Gm_DestroyInstanceBuffers() {
+    glDeleteBuffers(1, &glVisibilityBuffer);
+    glDeleteBuffers(1, &glSequentialIndexBuffer);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * GlInstanceRange
+   * ---------------
+   *
+   * Defines the instances of a mesh drawn for a given view,
+   * as a range of object indices within the visibility buffer.
+   * Sequential ranges instead draw the first (count) objects
+   * of a mesh in pool order, without any index list.
+   *
+   * Ranges copied from an object pool's visibility list retain
+   * its LoD grouping, and are drawn using the instance ranges
+   * of each MeshLod. Any other range draws a single LoD.
+   */
+  struct GlInstanceRange {
+    u32 offset = 0;
+    u32 count = 0;
+    bool isSequential = true;
+    bool hasLodGroups = false;
+  };
+
+  void Gm_InitInstanceBuffers();
+  void Gm_BindInstanceRange(GLuint bindingIndex, const GlInstanceRange& range);
+  void Gm_BufferVisibleInstances(const u32* indices, u32 total);
+  void Gm_DestroyInstanceBuffers();
+}
\ No newline at end of file
@@ -61,6 +61,11 @@ namespace Gamma {
     shaders.geometry.fragment("./gamma/opengl/shaders/geometry.frag.glsl");
     shaders.geometry.link();
 
+    shaders.staticGeometry.init();
+    shaders.staticGeometry.vertex("./gamma/opengl/shaders/geometry.vert.glsl");
+    shaders.staticGeometry.fragment("./gamma/opengl/shaders/static-geometry.frag.glsl");
+    shaders.staticGeometry.link();
+
     shaders.foliage.init();
     shaders.foliage.vertex("./gamma/opengl/shaders/foliage.vert.glsl");
     shaders.foliage.fragment("./gamma/opengl/shaders/geometry.frag.glsl");
@@ -116,6 +121,11 @@ namespace Gamma {
     shaders.shadowLightView.fragment("./gamma/opengl/shaders/shadow-light-view.frag.glsl");
     shaders.shadowLightView.link();
 
+    shaders.staticShadowLightView.init();
+    shaders.staticShadowLightView.vertex("./gamma/opengl/shaders/shadow-light-view.vert.glsl");
+    shaders.staticShadowLightView.fragment("./gamma/opengl/shaders/static-shadow-light-view.frag.glsl");
+    shaders.staticShadowLightView.link();
+
     shaders.pointShadowcasterView.init();
     shaders.pointShadowcasterView.vertex("./gamma/opengl/shaders/point-light-view.vert.glsl");
     shaders.pointShadowcasterView.geometry("./gamma/opengl/shaders/point-light-view.geom.glsl");
@@ -190,6 +200,7 @@ namespace Gamma {
     buffers.accumulation2.destroy();
 
     shaders.geometry.destroy();
+    shaders.staticGeometry.destroy();
     shaders.probeReflector.destroy();
     shaders.particles.destroy();
     shaders.lightingPrepass.destroy();
@@ -200,6 +211,7 @@ namespace Gamma {
     shaders.spotShadowcaster.destroy();
     shaders.pointShadowcaster.destroy();
     shaders.shadowLightView.destroy();
+    shaders.staticShadowLightView.destroy();
     shaders.pointShadowcasterView.destroy();
     shaders.indirectLight.destroy();
     shaders.indirectLightComposite.destroy();
@@ -7,8 +7,7 @@ layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec3 vertexTangent;
 layout (location = 3) in vec2 vertexUv;
-layout (location = 4) in uint modelColor;
-layout (location = 5) in mat4 modelMatrix;
+layout (location = 4) in uint instanceIndex;
 
 flat out vec3 fragColor;
 out vec3 fragPosition;
@@ -18,6 +17,8 @@ out vec3 fragBitangent;
 out vec2 fragUv;
 
 #include "utils/gl.glsl";
+#include "utils/instances.glsl";
+#include "utils/vertex.glsl";
 #include "utils/foliage.glsl";
 
 /**
@@ -46,8 +47,11 @@ vec3 unpack(uint color) {
 }
 
 void main() {
+  mat4 modelMatrix = instanceMatrices[instanceIndex];
+  uint modelColor = instanceColors[instanceIndex];
+
   // @hack invert Z
-  vec4 world_position = glVec4(modelMatrix * vec4(vertexPosition, 1.0));
+  vec4 world_position = glVec4(modelMatrix * vec4(getVertexPosition(), 1.0));
   mat3 normal_matrix = transpose(inverse(mat3(modelMatrix)));
 
   // @todo make a utility for this
@@ -68,8 +72,8 @@ void main() {
   fragColor = unpack(modelColor);
   // @hack invert Z
   fragPosition = glVec3(world_position.xyz);
-  fragNormal = normal_matrix * vertexNormal;
-  fragTangent = normal_matrix * vertexTangent;
+  fragNormal = normal_matrix * getVertexNormal();
+  fragTangent = normal_matrix * getVertexTangent();
   fragBitangent = getFragBitangent(fragNormal, fragTangent);
   fragUv = vertexUv;
 }
\ No newline at end of file
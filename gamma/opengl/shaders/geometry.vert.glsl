@@ -7,10 +7,11 @@ layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec3 vertexTangent;
 layout (location = 3) in vec2 vertexUv;
-layout (location = 4) in uint modelColor;
-layout (location = 5) in mat4 modelMatrix;
+layout (location = 4) in uint instanceIndex;
 
 flat out vec3 fragColor;
+// Only used by static batches (see static-geometry.frag.glsl)
+flat out uint fragMaterialIndex;
 out vec3 fragPosition;
 out vec3 fragNormal;
 out vec3 fragTangent;
@@ -18,6 +19,8 @@ out vec3 fragBitangent;
 out vec2 fragUv;
 
 #include "utils/gl.glsl";
+#include "utils/instances.glsl";
+#include "utils/vertex.glsl";
 
 /**
  * Returns a bitangent from potentially non-orthonormal
@@ -45,8 +48,11 @@ vec3 unpack(uint color) {
 }
 
 void main() {
+  mat4 modelMatrix = instanceMatrices[instanceIndex];
+  uint modelColor = instanceColors[instanceIndex];
+
   // @hack invert Z
-  vec4 world_position = glVec4(modelMatrix * vec4(vertexPosition, 1.0));
+  vec4 world_position = glVec4(modelMatrix * vec4(getVertexPosition(), 1.0));
   mat3 normal_matrix = transpose(inverse(mat3(modelMatrix)));
 
   gl_Position = matProjection * matView * world_position;
@@ -54,8 +60,9 @@ void main() {
   fragColor = unpack(modelColor);
   // @hack invert Z
   fragPosition = glVec3(world_position.xyz);
-  fragNormal = normal_matrix * vertexNormal;
-  fragTangent = normal_matrix * vertexTangent;
+  fragNormal = normal_matrix * getVertexNormal();
+  fragTangent = normal_matrix * getVertexTangent();
   fragBitangent = getFragBitangent(fragNormal, fragTangent);
   fragUv = vertexUv;
+  fragMaterialIndex = uint(gl_DrawID);
 }
\ No newline at end of file
@@ -30,7 +30,6 @@ layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec3 vertexTangent;
 layout (location = 3) in vec2 vertexUv;
-layout (location = 4) in mat4 modelMatrix;
 
 out vec2 fragUv;
 flat out vec3 color;
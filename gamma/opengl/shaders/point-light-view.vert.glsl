@@ -4,12 +4,15 @@ layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec3 vertexTangent;
 layout (location = 3) in vec2 vertexUv;
-layout (location = 4) in uint modelColor;
-layout (location = 5) in mat4 modelMatrix;
+layout (location = 4) in uint instanceIndex;
 
 #include "utils/gl.glsl";
+#include "utils/instances.glsl";
+#include "utils/vertex.glsl";
 
 void main() {
+  mat4 modelMatrix = instanceMatrices[instanceIndex];
+
   // @hack invert Z
-  gl_Position = glVec4(modelMatrix * vec4(vertexPosition, 1.0));
+  gl_Position = glVec4(modelMatrix * vec4(getVertexPosition(), 1.0));
 }
\ No newline at end of file
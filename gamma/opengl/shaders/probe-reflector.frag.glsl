@@ -24,7 +24,9 @@ vec3 getNormal() {
   vec3 n_fragNormal = normalize(fragNormal);
 
   if (hasNormalMap) {
-    vec3 mappedNormal = texture(meshNormalMap, fragUv).rgb * 2.0 - vec3(1.0);
+    // Normal maps are stored as BC5, keeping only x/y
+    vec2 mappedXy = texture(meshNormalMap, fragUv).rg * 2.0 - vec2(1.0);
+    vec3 mappedNormal = vec3(mappedXy, sqrt(max(0.0, 1.0 - dot(mappedXy, mappedXy))));
 
     mat3 tangentMatrix = mat3(
       normalize(fragTangent),
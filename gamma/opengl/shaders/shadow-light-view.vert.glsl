@@ -6,17 +6,22 @@ layout (location = 0) in vec3 vertexPosition;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec3 vertexTangent;
 layout (location = 3) in vec2 vertexUv;
-layout (location = 4) in uint modelColor;
-layout (location = 5) in mat4 modelMatrix;
+layout (location = 4) in uint instanceIndex;
 
 out vec2 fragUv;
+// Only used by static batches (see static-shadow-light-view.frag.glsl)
+flat out uint fragMaterialIndex;
 
 #include "utils/gl.glsl";
+#include "utils/instances.glsl";
+#include "utils/vertex.glsl";
 #include "utils/foliage.glsl";
 
 void main() {
+  mat4 modelMatrix = instanceMatrices[instanceIndex];
+
   // @hack invert Z
-  vec4 world_position = glVec4(modelMatrix * vec4(vertexPosition, 1.0));
+  vec4 world_position = glVec4(modelMatrix * vec4(getVertexPosition(), 1.0));
 
   // @todo make a utility for this
   switch (foliage.type) {
@@ -34,4 +39,5 @@ void main() {
   gl_Position = matLightViewProjection * world_position;
 
   fragUv = vertexUv;
+  fragMaterialIndex = uint(gl_DrawID);
 }
\ No newline at end of file
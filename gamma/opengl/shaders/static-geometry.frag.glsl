@@ -0,0 +1,48 @@
+#version 460 core
+
+flat in vec3 fragColor;
+flat in uint fragMaterialIndex;
+in vec3 fragNormal;
+in vec3 fragTangent;
+in vec3 fragBitangent;
+in vec2 fragUv;
+
+layout (location = 0) out vec4 out_color_and_depth;
+layout (location = 1) out vec4 out_normal_and_emissivity;
+
+#include "utils/static-batch.glsl";
+
+vec3 getNormal(StaticBatchMaterial material) {
+  vec3 normalized_frag_normal = normalize(fragNormal);
+
+  if (material.normalMapSlot >= 0) {
+    // Normal maps are stored as BC5, keeping only x/y
+    vec2 mappedXy = texture(staticBatchTextures[material.normalMapSlot], fragUv).rg * 2.0 - vec2(1.0);
+    vec3 mappedNormal = vec3(mappedXy, sqrt(max(0.0, 1.0 - dot(mappedXy, mappedXy))));
+
+    mat3 tangentMatrix = mat3(
+      normalize(fragTangent),
+      normalize(fragBitangent),
+      normalized_frag_normal
+    );
+
+    return normalize(tangentMatrix * mappedNormal);
+  } else {
+    return normalized_frag_normal;
+  }
+}
+
+void main() {
+  StaticBatchMaterial material = staticBatchMaterials[fragMaterialIndex];
+
+  vec4 color = material.textureSlot >= 0
+    ? texture(staticBatchTextures[material.textureSlot], fragUv) * vec4(fragColor, 1.0)
+    : vec4(fragColor, 1.0);
+
+  if (color.a < 0.5) {
+    discard;
+  }
+
+  out_color_and_depth = vec4(color.rgb, gl_FragCoord.z);
+  out_normal_and_emissivity = vec4(getNormal(material), material.emissivity);
+}
\ No newline at end of file
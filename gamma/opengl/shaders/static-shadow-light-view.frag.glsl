@@ -0,0 +1,18 @@
+#version 460 core
+
+flat in uint fragMaterialIndex;
+in vec2 fragUv;
+
+layout (location = 0) out float depth;
+
+#include "utils/static-batch.glsl";
+
+void main() {
+  int textureSlot = staticBatchMaterials[fragMaterialIndex].textureSlot;
+
+  if (textureSlot >= 0 && texture(staticBatchTextures[textureSlot], fragUv).w < 0.5) {
+    discard;
+  }
+
+  depth = gl_FragCoord.z;
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+/**
+ * Per-instance colors/matrices, stored in pool order and
+ * indexed by the instance index attribute, which allows
+ * each view to draw its own set of visible instances.
+ */
+layout (std430, binding = 0) readonly buffer InstanceColors {
+  uint instanceColors[];
+};
+
+layout (std430, binding = 1) readonly buffer InstanceMatrices {
+  mat4 instanceMatrices[];
+};
\ No newline at end of file
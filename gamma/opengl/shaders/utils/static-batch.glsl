@@ -0,0 +1,25 @@
+#define MAX_STATIC_BATCH_TEXTURES 12
+
+/**
+ * Per-draw materials for static batches, in draw order, and
+ * indexed by gl_DrawID (see Gm_GenerateStaticBatchCommands()).
+ * Texture slots index into staticBatchTextures, or are -1
+ * for none. Matches StaticBatchMaterial.
+ */
+struct StaticBatchMaterial {
+  int textureSlot;
+  int normalMapSlot;
+  float emissivity;
+  uint padding;
+};
+
+layout (std430, binding = 2) readonly buffer StaticBatchMaterials {
+  StaticBatchMaterial staticBatchMaterials[];
+};
+
+/**
+ * Static batch textures, bound to consecutive units. Slots
+ * are the same for every fragment in a given draw, so
+ * indexing is dynamically uniform.
+ */
+uniform sampler2D staticBatchTextures[MAX_STATIC_BATCH_TEXTURES];
\ No newline at end of file
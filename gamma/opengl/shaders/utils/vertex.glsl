@@ -0,0 +1,41 @@
+/**
+ * Per-mesh vertex decoding parameters, supplied as constant
+ * attribute values so every mesh shader can share them (see
+ * OpenGLMesh::render()). Meshes with quantized vertices store
+ * positions normalized to the mesh bounds, and octahedral-
+ * encoded normals/tangents in the xy components.
+ *
+ * vertexPositionOffset.w is 1 for quantized meshes.
+ */
+layout (location = 5) in vec4 vertexPositionOffset;
+layout (location = 6) in vec3 vertexPositionScale;
+
+vec2 signNotZero(vec2 v) {
+  return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+/**
+ * Decodes an octahedral-encoded direction, matching
+ * Gm_DecodeOctahedral() in system/vertex_quantization.cpp.
+ */
+vec3 decodeOctahedral(vec2 encoded) {
+  vec3 vector = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+  if (vector.z < 0.0) {
+    vector.xy = (1.0 - abs(vector.yx)) * signNotZero(vector.xy);
+  }
+
+  return normalize(vector);
+}
+
+vec3 getVertexPosition() {
+  return vertexPositionOffset.xyz + vertexPosition * vertexPositionScale;
+}
+
+vec3 getVertexNormal() {
+  return vertexPositionOffset.w == 1.0 ? decodeOctahedral(vertexNormal.xy) : vertexNormal;
+}
+
+vec3 getVertexTangent() {
+  return vertexPositionOffset.w == 1.0 ? decodeOctahedral(vertexTangent.xy) : vertexTangent;
+}
\ No newline at end of file
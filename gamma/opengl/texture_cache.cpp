@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "opengl/texture_cache.h"
+#include "system/assert.h"
+#include "system/console.h"
+#include "system/flags.h"
+#include "system/texture_cooker.h"
+
+#include "glew.h"
+
+#define MAX_TEXTURE_DECODE_THREADS 4
+#define TEXTURE_UPLOAD_BYTES_PER_FRAME (8 * 1024 * 1024)
+
+namespace Gamma {
+  // Cache types and state are private to the cache
+  namespace {
+    struct CachedTexture {
+      OpenGLTexture* texture = nullptr;
+      u32 references = 0;
+      /**
+       * Set for textures which couldn't be loaded, which
+       * keep their placeholder texture bound.
+       */
+      bool hasFailed = false;
+    };
+
+    struct TextureRequest {
+      std::string path;
+      TextureType type;
+    };
+
+    struct LoadedTexture {
+      std::string path;
+      CookedTexture* cooked = nullptr;
+    };
+
+    /**
+     * Textures are shared between meshes by path, and
+     * destroyed once the last mesh using them releases them.
+     * Only accessed from the render thread.
+     */
+    std::map<std::string, CachedTexture> textureMap;
+    u32 totalPendingTextures = 0;
+    /**
+     * Neutral 1x1 textures bound in place of textures which are
+     * still loading, indexed by TextureType: white for color and
+     * linear textures, and a flat normal for normal maps.
+     */
+    GLuint glPlaceholderTextures[3];
+
+    /**
+     * Texture loading is done by worker threads, which take
+     * requests from the decode queue, load (or decode and cook)
+     * them, and hand them back to the render thread for upload.
+     */
+    std::vector<std::thread> decodeWorkers;
+    std::deque<TextureRequest> decodeQueue;
+    std::deque<LoadedTexture> loadedTextures;
+    std::mutex decodeMutex;
+    std::condition_variable decodeCondition;
+    bool isDecodingStopped = false;
+  }
+
+  static void Gm_DecodeTextures() {
+    while (true) {
+      TextureRequest request;
+
+      {
+        std::unique_lock<std::mutex> lock(decodeMutex);
+
+        decodeCondition.wait(lock, []() {
+          return isDecodingStopped || decodeQueue.size() > 0;
+        });
+
+        if (isDecodingStopped) {
+          return;
+        }
+
+        request = decodeQueue.front();
+
+        decodeQueue.pop_front();
+      }
+
+      auto* cooked = new CookedTexture();
+
+      if (!Gm_LoadTexture(request.path, request.type, *cooked)) {
+        delete cooked;
+
+        cooked = nullptr;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(decodeMutex);
+
+        loadedTextures.push_back({ request.path, cooked });
+      }
+    }
+  }
+
+  static void Gm_CreatePlaceholderTexture(TextureType type, const u8* pixel) {
+    glBindTexture(GL_TEXTURE_2D, glPlaceholderTextures[(u32)type]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  }
+
+  void Gm_InitTextureCache() {
+    const static u8 colorPixel[4] = { 255, 255, 255, 255 };
+    const static u8 normalPixel[4] = { 128, 128, 255, 255 };
+
+    glGenTextures(3, glPlaceholderTextures);
+
+    Gm_CreatePlaceholderTexture(TextureType::COLOR, colorPixel);
+    Gm_CreatePlaceholderTexture(TextureType::NORMAL, normalPixel);
+    Gm_CreatePlaceholderTexture(TextureType::LINEAR, colorPixel);
+
+    // Leave a core free for the main thread
+    u32 totalThreads = std::clamp(std::thread::hardware_concurrency(), 2u, (u32)MAX_TEXTURE_DECODE_THREADS + 1) - 1;
+
+    isDecodingStopped = false;
+
+    for (u32 i = 0; i < totalThreads; i++) {
+      decodeWorkers.push_back(std::thread(Gm_DecodeTextures));
+    }
+  }
+
+  /**
+   * Returns the shared texture for a given path, queueing it
+   * to be loaded if it isn't already loaded or loading. Each
+   * acquired texture must be released by Gm_ReleaseTexture().
+   */
+  OpenGLTexture* Gm_AcquireTexture(const std::string& path, TextureType type) {
+    auto& cached = textureMap[path];
+
+    if (cached.texture == nullptr) {
+      cached.texture = new OpenGLTexture(path);
+
+      totalPendingTextures++;
+
+      {
+        std::lock_guard<std::mutex> lock(decodeMutex);
+
+        decodeQueue.push_back({ path, type });
+      }
+
+      decodeCondition.notify_one();
+    }
+
+    cached.references++;
+
+    return cached.texture;
+  }
+
+  void Gm_ReleaseTexture(OpenGLTexture* texture) {
+    auto entry = textureMap.find(texture->getPath());
+
+    assert(entry != textureMap.end(), "Released texture '" + texture->getPath() + "' is not cached");
+
+    if (--entry->second.references > 0) {
+      return;
+    }
+
+    #if GAMMA_DEVELOPER_MODE
+      Console::log("[Gamma] Destroying OpenGLTexture:", texture->getPath());
+    #endif
+
+    if (!texture->isLoaded() && !entry->second.hasFailed) {
+      // Its cooked data is discarded once loaded
+      totalPendingTextures--;
+    }
+
+    delete texture;
+
+    textureMap.erase(entry);
+  }
+
+  void Gm_BindPlaceholderTexture(TextureType type, GLenum unit) {
+    glActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, glPlaceholderTextures[(u32)type]);
+  }
+
+  /**
+   * Uploads loaded textures, up to a fixed number of bytes per
+   * frame so that many textures finishing at once don't stall
+   * rendering. At least one texture is uploaded per call.
+   */
+  void Gm_UploadLoadedTextures() {
+    u32 totalBytesUploaded = 0;
+
+    while (totalBytesUploaded < TEXTURE_UPLOAD_BYTES_PER_FRAME) {
+      LoadedTexture loaded;
+
+      {
+        std::lock_guard<std::mutex> lock(decodeMutex);
+
+        if (loadedTextures.size() == 0) {
+          break;
+        }
+
+        loaded = loadedTextures.front();
+
+        loadedTextures.pop_front();
+      }
+
+      auto entry = textureMap.find(loaded.path);
+
+      if (entry != textureMap.end() && !entry->second.texture->isLoaded()) {
+        totalPendingTextures--;
+
+        if (loaded.cooked == nullptr) {
+          // Leave the placeholder texture bound
+          entry->second.hasFailed = true;
+
+          Console::log("[Gamma] Failed to load texture:", loaded.path);
+
+          continue;
+        }
+
+        entry->second.texture->upload(*loaded.cooked);
+
+        totalBytesUploaded += loaded.cooked->data.size();
+
+        #if GAMMA_DEVELOPER_MODE
+          Console::log("[Gamma] OpenGLTexture loaded:", loaded.path);
+        #endif
+      }
+
+      // Textures released before they were uploaded
+      // have their cooked data discarded
+      delete loaded.cooked;
+    }
+  }
+
+  bool Gm_IsLoadingTextures() {
+    return totalPendingTextures > 0;
+  }
+
+  void Gm_DestroyTextureCache() {
+    {
+      std::lock_guard<std::mutex> lock(decodeMutex);
+
+      isDecodingStopped = true;
+    }
+
+    decodeCondition.notify_all();
+
+    for (auto& worker : decodeWorkers) {
+      worker.join();
+    }
+
+    for (auto& loaded : loadedTextures) {
+      delete loaded.cooked;
+    }
+
+    for (auto& [ path, cached ] : textureMap) {
+      delete cached.texture;
+    }
+
+    glDeleteTextures(3, glPlaceholderTextures);
+
+    decodeWorkers.clear();
+    decodeQueue.clear();
+    loadedTextures.clear();
+    textureMap.clear();
+
+    totalPendingTextures = 0;
+  }
+}
\ No newline at end of file
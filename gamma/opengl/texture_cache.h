@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include "opengl/OpenGLTexture.h"
+#include "system/texture_compression.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  void Gm_InitTextureCache();
+  OpenGLTexture* Gm_AcquireTexture(const std::string& path, TextureType type);
+  void Gm_ReleaseTexture(OpenGLTexture* texture);
+  void Gm_BindPlaceholderTexture(TextureType type, GLenum unit);
+  void Gm_UploadLoadedTextures();
+  bool Gm_IsLoadingTextures();
+  void Gm_DestroyTextureCache();
+}
\ No newline at end of file
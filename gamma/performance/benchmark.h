@@ -10,10 +10,10 @@ u64 Gm_GetMicroseconds();
 namespace Gamma {
   void Gm_CompareBenchmarks(u64 a, u64 b);
 
-  auto Gm_CreateTimer() {
+  inline auto Gm_CreateTimer() {
     auto start = std::chrono::system_clock::now();
 
-    return [&]() {
+    return [start]() {
       auto end = std::chrono::system_clock::now();
 
       std::chrono::system_clock::duration duration = end - start;
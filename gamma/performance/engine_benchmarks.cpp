@@ -0,0 +1,148 @@
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "math/frustum.h"
+#include "math/matrix.h"
+#include "performance/benchmark.h"
+#include "performance/engine_benchmarks.h"
+#include "system/camera.h"
+#include "system/console.h"
+#include "system/culling.h"
+#include "system/entities.h"
+#include "system/ObjectPool.h"
+#include "system/ObjLoader.h"
+#include "system/random.h"
+
+#define BENCHMARK_ITERATIONS 20
+
+namespace Gamma {
+  /**
+   * Times a number of repeated runs of a test,
+   * returning the average time in microseconds.
+   */
+  static float Gm_TimeAverageMicroseconds(const std::function<void()>& test) {
+    // Warmup run
+    test();
+
+    u64 start = Gm_GetMicroseconds();
+
+    for (u32 i = 0; i < BENCHMARK_ITERATIONS; i++) {
+      test();
+    }
+
+    return float(Gm_GetMicroseconds() - start) / float(BENCHMARK_ITERATIONS);
+  }
+
+  void Gm_BenchmarkCulling() {
+    const u32 poolSizes[] = { 10000, 100000, 1000000 };
+    const float radius = 1.f;
+
+    Camera camera;
+
+    Matrix4f matProjection = Matrix4f::glPerspective({ 1920, 1080 }, camera.fov, 1.0f, 10000.0f);
+    Matrix4f matView = camera.rotation.toMatrix4f() * Matrix4f::translation(camera.position.invert().gl());
+    Frustum frustum = Frustum::fromViewProjectionGL((matProjection * matView).transpose());
+    Vec3f cameraDirection = camera.orientation.getDirection();
+
+    for (u32 poolSize : poolSizes) {
+      ObjectPool pool;
+      std::vector<u32> visibleIndices(poolSize);
+      u32 totalVisible = 0;
+
+      pool.reserve(poolSize);
+
+      for (u32 i = 0; i < poolSize; i++) {
+        auto& object = pool.createObject();
+
+        Vec3f position = Vec3f(Gm_Random(-1000.f, 1000.f), Gm_Random(-1000.f, 1000.f), Gm_Random(-1000.f, 1000.f));
+        Vec3f scale = Vec3f(Gm_Random(0.5f, 2.f));
+
+        pool.setTransformById(object._record.id, position, scale, Vec3f(0.f));
+      }
+
+      auto& positions = pool.getPositions();
+      auto& scales = pool.getScales();
+
+      // Cone test, as previously used for ObjectPool culling
+      float coneTime = Gm_TimeAverageMicroseconds([&]() {
+        totalVisible = 0;
+
+        for (u32 i = 0; i < poolSize; i++) {
+          Vec3f objectUnitViewPosition = (Vec3f(positions.x[i], positions.y[i], positions.z[i]) - camera.position).unit();
+
+          if (Vec3f::dot(cameraDirection, objectUnitViewPosition) >= 0.7f) {
+            visibleIndices[totalVisible++] = i;
+          }
+        }
+      });
+
+      u32 totalConeVisible = totalVisible;
+
+      float scalarTime = Gm_TimeAverageMicroseconds([&]() {
+        totalVisible = Gm_CullSpheresScalar(frustum, positions, scales, radius, 0, poolSize, visibleIndices.data());
+      });
+
+      u32 totalScalarVisible = totalVisible;
+
+      float simdTime = Gm_TimeAverageMicroseconds([&]() {
+        totalVisible = Gm_CullSpheres(frustum, positions, scales, radius, poolSize, visibleIndices.data());
+      });
+
+      Console::log("[Gamma] Culling", poolSize, "objects:");
+      Console::log("  Cone test:", coneTime, "us (" + std::to_string(totalConeVisible) + " visible)");
+      Console::log("  Frustum (scalar):", scalarTime, "us (" + std::to_string(totalScalarVisible) + " visible)");
+      Console::log("  Frustum (SIMD):", simdTime, "us (" + std::to_string(totalVisible) + " visible)");
+
+      pool.free();
+    }
+  }
+
+  /**
+   * Checks that two vectors have identical contents, byte for byte.
+   */
+  template<typename T>
+  static bool Gm_IsIdenticalData(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.size() == 0 || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+  }
+
+  void Gm_BenchmarkObjLoading(const std::vector<std::string>& paths) {
+    for (auto& path : paths) {
+      if (!std::filesystem::exists(path)) {
+        Console::log("[Gamma] OBJ benchmark file not found:", path);
+
+        continue;
+      }
+
+      float megabytes = float(std::filesystem::file_size(path)) / 1000000.f;
+      bool isMatch = false;
+
+      float legacyTime = Gm_TimeAverageMicroseconds([&]() {
+        LegacyObjLoader obj(path.c_str());
+      });
+
+      float mappedTime = Gm_TimeAverageMicroseconds([&]() {
+        ObjLoader obj(path.c_str());
+      });
+
+      {
+        LegacyObjLoader legacyObj(path.c_str());
+        ObjLoader obj(path.c_str());
+
+        isMatch = (
+          Gm_IsIdenticalData(obj.vertices, legacyObj.vertices) &&
+          Gm_IsIdenticalData(obj.textureCoordinates, legacyObj.textureCoordinates) &&
+          Gm_IsIdenticalData(obj.normals, legacyObj.normals) &&
+          Gm_IsIdenticalData(obj.faces, legacyObj.faces)
+        );
+      }
+
+      // Bytes per microsecond == megabytes per second
+      Console::log("[Gamma] Loading", path + ":", isMatch ? "(output matches)" : "(OUTPUT MISMATCH)");
+      Console::log("  Legacy:", legacyTime, "us (" + std::to_string(megabytes * 1000000.f / legacyTime) + " MB/s)");
+      Console::log("  Mapped:", mappedTime, "us (" + std::to_string(megabytes * 1000000.f / mappedTime) + " MB/s)");
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Gamma {
+  /**
+   * Gm_BenchmarkCulling
+   * -------------------
+   *
+   * Compares the previous camera-direction cone test against
+   * scalar and SIMD frustum culling, for pools of 10K, 100K
+   * and 1M randomly-placed objects.
+   */
+  void Gm_BenchmarkCulling();
+
+  /**
+   * Gm_BenchmarkObjLoading
+   * ----------------------
+   *
+   * Measures the throughput of the memory-mapped ObjLoader
+   * against LegacyObjLoader for each of the given .obj files,
+   * and checks that both produce identical output.
+   */
+  void Gm_BenchmarkObjLoading(const std::vector<std::string>& paths);
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ struct GmContext;
 namespace Gamma {
   struct Mesh;
   struct Light;
+  struct StaticBatch;
 
   struct FrameFlags {
     /**
@@ -23,6 +24,10 @@ namespace Gamma {
   struct RenderStats {
     u32 gpuMemoryTotal;
     u32 gpuMemoryUsed;
+    u32 instanceBytesUploaded = 0;
+    // Mesh and static batch draw calls issued in the frame,
+    // with each multi-draw counted once
+    u32 drawCalls = 0;
     bool isVSynced;
   };
 
@@ -35,6 +40,7 @@ namespace Gamma {
 
     virtual void createMesh(const Mesh* mesh) {};
     virtual void createShadowMap(const Light* light) {};
+    virtual void createStaticBatch(StaticBatch* batch) {};
     virtual void destroyMesh(const Mesh* mesh) {};
     virtual void destroyShadowMap(const Light* light) {};
 
@@ -0,0 +1,127 @@
+#if defined(_WIN32)
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "system/console.h"
+#include "system/MappedFile.h"
+
+namespace Gamma {
+  // Returned as the contents of empty files,
+  // which can't be mapped
+  static const char* EMPTY_FILE_CONTENTS = "";
+
+  MappedFile::MappedFile(const char* path) {
+    #if defined(_WIN32)
+      HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+      LARGE_INTEGER fileSize;
+
+      if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+        if (file != INVALID_HANDLE_VALUE) {
+          CloseHandle(file);
+        }
+
+        Console::log("[Gamma] MappedFile failed to open file:", path);
+
+        return;
+      }
+
+      fileHandle = file;
+      totalBytes = (u64)fileSize.QuadPart;
+
+      if (totalBytes == 0) {
+        contents = EMPTY_FILE_CONTENTS;
+
+        return;
+      }
+
+      HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+      if (mapping != nullptr) {
+        mappingHandle = mapping;
+        contents = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      }
+    #else
+      int file = open(path, O_RDONLY);
+      struct stat fileStats;
+
+      if (file == -1 || fstat(file, &fileStats) != 0) {
+        if (file != -1) {
+          close(file);
+        }
+
+        Console::log("[Gamma] MappedFile failed to open file:", path);
+
+        return;
+      }
+
+      fileDescriptor = file;
+      totalBytes = (u64)fileStats.st_size;
+
+      if (totalBytes == 0) {
+        contents = EMPTY_FILE_CONTENTS;
+
+        return;
+      }
+
+      void* view = mmap(nullptr, totalBytes, PROT_READ, MAP_PRIVATE, file, 0);
+
+      if (view != MAP_FAILED) {
+        contents = (const char*)view;
+
+        // Files are generally parsed front to back
+        madvise(view, totalBytes, MADV_SEQUENTIAL);
+      }
+    #endif
+
+    if (contents == nullptr) {
+      Console::log("[Gamma] MappedFile failed to map file:", path);
+
+      totalBytes = 0;
+    } else {
+      isMapped = true;
+    }
+  }
+
+  MappedFile::~MappedFile() {
+    #if defined(_WIN32)
+      if (isMapped) {
+        UnmapViewOfFile(contents);
+      }
+
+      if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+      }
+
+      if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+      }
+    #else
+      if (isMapped) {
+        munmap((void*)contents, totalBytes);
+      }
+
+      if (fileDescriptor != -1) {
+        close(fileDescriptor);
+      }
+    #endif
+  }
+
+  const char* MappedFile::data() const {
+    return contents;
+  }
+
+  bool MappedFile::isOpen() const {
+    return contents != nullptr;
+  }
+
+  u64 MappedFile::size() const {
+    return totalBytes;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * MappedFile
+   * ----------
+   *
+   * A read-only, memory-mapped view of a file's contents,
+   * unmapped when the MappedFile goes out of scope.
+   *
+   * Usage:
+   *
+   *  MappedFile file("path/to/file");
+   *
+   *  if (file.isOpen()) {
+   *    parse(file.data(), file.size());
+   *  }
+   */
+  class MappedFile {
+  public:
+    MappedFile(const char* path);
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const;
+    bool isOpen() const;
+    u64 size() const;
+
+  private:
+    const char* contents = nullptr;
+    u64 totalBytes = 0;
+    bool isMapped = false;
+
+    #if defined(_WIN32)
+      void* fileHandle = nullptr;
+      void* mappingHandle = nullptr;
+    #else
+      int fileDescriptor = -1;
+    #endif
+  };
+}
\ No newline at end of file
@@ -1,16 +1,282 @@
+#include <cstdlib>
+#include <cstring>
 #include <map>
 #include <string>
 #include <iostream>
 
+#include "system/console.h"
+#include "system/MappedFile.h"
 #include "system/ObjLoader.h"
 
 namespace Gamma {
-  static std::string VERTEX_LABEL = "v";
-  static std::string TEXTURE_COORDINATE_LABEL = "vt";
-  static std::string NORMAL_LABEL = "vn";
-  static std::string FACE_LABEL = "f";
+  const static std::string_view VERTEX_LABEL = "v";
+  const static std::string_view TEXTURE_COORDINATE_LABEL = "vt";
+  const static std::string_view NORMAL_LABEL = "vn";
+  const static std::string_view FACE_LABEL = "f";
+
+  /**
+   * Powers of ten exactly representable as floats,
+   * used in the Gm_ParseFloat() fast path.
+   */
+  const static float POWERS_OF_TEN[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+  };
+
+  inline static bool Gm_IsDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  inline static bool Gm_IsWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  /**
+   * Returns the next whitespace-delimited token in a line,
+   * advancing the offset past it.
+   */
+  static std::string_view Gm_NextToken(const std::string_view& line, u32& offset) {
+    while (offset < line.size() && Gm_IsWhitespace(line[offset])) {
+      offset++;
+    }
+
+    u32 start = offset;
+
+    while (offset < line.size() && !Gm_IsWhitespace(line[offset])) {
+      offset++;
+    }
+
+    return line.substr(start, offset - start);
+  }
+
+  /**
+   * Parses a floating point token, matching the result of stof().
+   *
+   * Values with a mantissa exactly representable as a float and a
+   * small decimal exponent (i.e., virtually all .obj output) take a
+   * single correctly-rounded float multiply or divide. Anything else
+   * falls back to strtof() on a stack copy of the token.
+   */
+  static float Gm_ParseFloat(const std::string_view& token) {
+    const char* c = token.data();
+    const char* end = c + token.size();
+    bool isNegative = false;
+    u64 mantissa = 0;
+    s32 exponent = 0;
+    u32 totalDigits = 0;
+
+    if (c < end && (*c == '-' || *c == '+')) {
+      isNegative = *c == '-';
+      c++;
+    }
+
+    for (; c < end && Gm_IsDigit(*c); c++) {
+      mantissa = mantissa * 10 + (*c - '0');
+      totalDigits += mantissa > 0 ? 1 : 0;
+    }
+
+    if (c < end && *c == '.') {
+      for (c++; c < end && Gm_IsDigit(*c); c++) {
+        mantissa = mantissa * 10 + (*c - '0');
+        totalDigits += mantissa > 0 ? 1 : 0;
+        exponent--;
+      }
+    }
+
+    if (c < end && (*c == 'e' || *c == 'E')) {
+      bool isNegativeExponent = false;
+      s32 value = 0;
+
+      c++;
+
+      if (c < end && (*c == '-' || *c == '+')) {
+        isNegativeExponent = *c == '-';
+        c++;
+      }
+
+      for (; c < end && Gm_IsDigit(*c) && value < 1000; c++) {
+        value = value * 10 + (*c - '0');
+      }
+
+      exponent += isNegativeExponent ? -value : value;
+    }
+
+    if (
+      c == end &&
+      token.size() > 0 &&
+      totalDigits <= 18 &&
+      mantissa <= (1 << 24) &&
+      exponent >= -10 && exponent <= 10
+    ) {
+      float value = exponent < 0
+        ? float(mantissa) / POWERS_OF_TEN[-exponent]
+        : float(mantissa) * POWERS_OF_TEN[exponent];
+
+      return isNegative ? -value : value;
+    }
+
+    char buffer[64];
+    u32 length = token.size() < sizeof(buffer) - 1 ? (u32)token.size() : (u32)sizeof(buffer) - 1;
+
+    memcpy(buffer, token.data(), length);
+
+    buffer[length] = '\0';
+
+    return strtof(buffer, nullptr);
+  }
+
+  /**
+   * Parses a signed integer token, matching the result of stoi().
+   */
+  static s32 Gm_ParseInt(const std::string_view& token) {
+    const char* c = token.data();
+    const char* end = c + token.size();
+    bool isNegative = false;
+    s32 value = 0;
+
+    if (c < end && (*c == '-' || *c == '+')) {
+      isNegative = *c == '-';
+      c++;
+    }
+
+    for (; c < end && Gm_IsDigit(*c); c++) {
+      value = value * 10 + (*c - '0');
+    }
+
+    return isNegative ? -value : value;
+  }
+
+  /**
+   * Parses a face vertex token, in the same manner as
+   * LegacyObjLoader::parseVertexData().
+   */
+  static VertexData Gm_ParseVertexData(const std::string_view& token) {
+    u32 indexes[3];
+    u32 offset = 0;
+
+    for (u32 i = 0; i < 3; i++) {
+      auto next = token.find('/', offset);
+      bool hasNext = next != std::string_view::npos;
+      u32 length = u32((hasNext ? next : token.size()) - offset);
+
+      if (offset >= token.size() || length == 0) {
+        // Missing indexes are marked as undefined
+        indexes[i] = -1;
+      } else {
+        indexes[i] = Gm_ParseInt(token.substr(offset, length)) - 1;
+      }
+
+      offset = hasNext ? u32(next + 1) : (u32)token.size();
+    }
+
+    return { indexes[0], indexes[1], indexes[2] };
+  }
 
   ObjLoader::ObjLoader(const char* path) {
+    MappedFile file(path);
+
+    if (!file.isOpen()) {
+      Console::log("[Gamma] ObjLoader failed to load file:", path);
+
+      return;
+    }
+
+    reserve(file.data(), file.size());
+    parse(file.data(), file.size());
+  }
+
+  ObjLoader::~ObjLoader() {
+    vertices.clear();
+    textureCoordinates.clear();
+    normals.clear();
+    faces.clear();
+  }
+
+  void ObjLoader::parse(const char* contents, u64 size) {
+    const char* cursor = contents;
+    const char* end = contents + size;
+
+    while (cursor < end) {
+      auto* lineEnd = (const char*)memchr(cursor, '\n', end - cursor);
+
+      if (lineEnd == nullptr) {
+        lineEnd = end;
+      }
+
+      std::string_view line(cursor, lineEnd - cursor);
+      u32 offset = 0;
+      auto label = Gm_NextToken(line, offset);
+
+      cursor = lineEnd + 1;
+
+      if (label == VERTEX_LABEL) {
+        float x = Gm_ParseFloat(Gm_NextToken(line, offset));
+        float y = Gm_ParseFloat(Gm_NextToken(line, offset));
+        float z = Gm_ParseFloat(Gm_NextToken(line, offset));
+
+        vertices.push_back({ x, y, z });
+      } else if (label == TEXTURE_COORDINATE_LABEL) {
+        float u = Gm_ParseFloat(Gm_NextToken(line, offset));
+        float v = Gm_ParseFloat(Gm_NextToken(line, offset));
+
+        textureCoordinates.push_back({ u, 1.f - v });
+      } else if (label == NORMAL_LABEL) {
+        float x = Gm_ParseFloat(Gm_NextToken(line, offset));
+        float y = Gm_ParseFloat(Gm_NextToken(line, offset));
+        float z = Gm_ParseFloat(Gm_NextToken(line, offset));
+
+        normals.push_back({ x, y, z });
+      } else if (label == FACE_LABEL) {
+        Face face;
+
+        face.v1 = Gm_ParseVertexData(Gm_NextToken(line, offset));
+        face.v2 = Gm_ParseVertexData(Gm_NextToken(line, offset));
+        face.v3 = Gm_ParseVertexData(Gm_NextToken(line, offset));
+
+        faces.push_back(face);
+      }
+    }
+  }
+
+  /**
+   * Counts vertex/texture coordinate/normal/face lines ahead
+   * of parsing, so each list is only allocated once.
+   */
+  void ObjLoader::reserve(const char* contents, u64 size) {
+    const char* cursor = contents;
+    const char* end = contents + size;
+    u32 totalVertices = 0;
+    u32 totalTextureCoordinates = 0;
+    u32 totalNormals = 0;
+    u32 totalFaces = 0;
+
+    while (cursor < end - 1) {
+      char a = cursor[0];
+      char b = cursor[1];
+
+      if (a == 'v') {
+        if (b == ' ') totalVertices++;
+        else if (b == 't') totalTextureCoordinates++;
+        else if (b == 'n') totalNormals++;
+      } else if (a == 'f' && b == ' ') {
+        totalFaces++;
+      }
+
+      auto* lineEnd = (const char*)memchr(cursor, '\n', end - cursor);
+
+      if (lineEnd == nullptr) {
+        break;
+      }
+
+      cursor = lineEnd + 1;
+    }
+
+    vertices.reserve(totalVertices);
+    textureCoordinates.reserve(totalTextureCoordinates);
+    normals.reserve(totalNormals);
+    faces.reserve(totalFaces);
+  }
+
+  LegacyObjLoader::LegacyObjLoader(const char* path) {
     load(path);
 
     while (isLoading) {
@@ -32,14 +298,14 @@ namespace Gamma {
     }
   }
 
-  ObjLoader::~ObjLoader() {
+  LegacyObjLoader::~LegacyObjLoader() {
     vertices.clear();
     textureCoordinates.clear();
     normals.clear();
     faces.clear();
   }
 
-  void ObjLoader::handleFace() {
+  void LegacyObjLoader::handleFace() {
     Face face;
 
     face.v1 = parseVertexData(readNextChunk());
@@ -49,7 +315,7 @@ namespace Gamma {
     faces.push_back(face);
   }
 
-  void ObjLoader::handleNormal() {
+  void LegacyObjLoader::handleNormal() {
     float x = stof(readNextChunk());
     float y = stof(readNextChunk());
     float z = stof(readNextChunk());
@@ -57,7 +323,7 @@ namespace Gamma {
     normals.push_back({ x, y, z });
   }
 
-  void ObjLoader::handleVertex() {
+  void LegacyObjLoader::handleVertex() {
     float x = stof(readNextChunk());
     float y = stof(readNextChunk());
     float z = stof(readNextChunk());
@@ -65,7 +331,7 @@ namespace Gamma {
     vertices.push_back({ x, y, z });
   }
 
-  void ObjLoader::handleTextureCoordinate() {
+  void LegacyObjLoader::handleTextureCoordinate() {
     float u = stof(readNextChunk());
     float v = stof(readNextChunk());
 
@@ -86,7 +352,7 @@ namespace Gamma {
    * and vn the normal index, with respect to previously listed
    * vertex/texture coordinate/normal values.
    */
-  VertexData ObjLoader::parseVertexData(const std::string& chunk) {
+  VertexData LegacyObjLoader::parseVertexData(const std::string& chunk) {
     VertexData vertexData;
     int offset = 0;
     int indexes[3];
@@ -3,6 +3,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "math/vector.h"
 #include "system/AbstractLoader.h"
@@ -40,13 +41,15 @@ namespace Gamma {
    * ---------
    *
    * Opens and parses .obj files into an intermediate representation
-   * for conversion into Model instances.
+   * for conversion into Model instances. Files are memory-mapped and
+   * tokenized in place, with vertex/face lists reserved up front
+   * from a pre-scan of the file's lines.
    *
    * Usage:
    *
    *  ObjLoader modelObj("path/to/file.obj");
    */
-  class ObjLoader : public AbstractLoader {
+  class ObjLoader {
   public:
     std::vector<Vec3f> vertices;
     std::vector<Vec2f> textureCoordinates;
@@ -56,6 +59,30 @@ namespace Gamma {
     ObjLoader(const char* path);
     ~ObjLoader();
 
+  private:
+    void parse(const char* contents, u64 size);
+    void reserve(const char* contents, u64 size);
+  };
+
+  /**
+   * LegacyObjLoader
+   * ---------------
+   *
+   * The original character-at-a-time .obj loader, producing
+   * the same output as ObjLoader.
+   *
+   * @deprecated Only retained as a baseline for Gm_BenchmarkObjLoading()
+   */
+  class LegacyObjLoader : public AbstractLoader {
+  public:
+    std::vector<Vec3f> vertices;
+    std::vector<Vec2f> textureCoordinates;
+    std::vector<Vec3f> normals;
+    std::vector<Face> faces;
+
+    LegacyObjLoader(const char* path);
+    ~LegacyObjLoader();
+
   private:
     void handleFace();
     void handleNormal();
@@ -1,11 +1,63 @@
+#include <algorithm>
+#include <new>
+#include <utility>
+
 #include "system/assert.h"
-#include "system/camera.h"
+#include "system/culling.h"
 #include "system/entities.h"
 #include "system/ObjectPool.h"
+#include "system/transforms.h"
 
-#define UNUSED_OBJECT_INDEX 0xffff
+#define UNUSED_OBJECT_INDEX 0xffffff
+#define MAX_OBJECT_ID 0xffffff
+#define OBJECT_SLOT_PAGE_SIZE 1024
+#define OBJECT_POOL_CHUNK_SIZE 256
+#define OBJECT_POOL_ALIGNMENT 64
+#define LOD_HYSTERESIS 0.1f
+#define DIRTY_TRANSFORM 0x01
 
 namespace Gamma {
+  /**
+   * Reallocates a cache-aligned array to a new size,
+   * preserving the first (total) items.
+   */
+  template<typename T>
+  static void Gm_ResizeAligned(T*& items, u32 size, u32 total) {
+    T* resized = nullptr;
+
+    if (size > 0) {
+      resized = (T*)::operator new[](size * sizeof(T), std::align_val_t(OBJECT_POOL_ALIGNMENT));
+
+      for (u32 i = 0; i < size; i++) {
+        new (&resized[i]) T(i < total ? items[i] : T());
+      }
+    }
+
+    if (items != nullptr) {
+      ::operator delete[](items, std::align_val_t(OBJECT_POOL_ALIGNMENT));
+    }
+
+    items = resized;
+  }
+
+  static void Gm_ResizeAligned(Vec3fStream& stream, u32 size, u32 total) {
+    Gm_ResizeAligned(stream.x, size, total);
+    Gm_ResizeAligned(stream.y, size, total);
+    Gm_ResizeAligned(stream.z, size, total);
+  }
+
+  static void Gm_WriteStream(Vec3fStream& stream, u32 index, const Vec3f& value) {
+    stream.x[index] = value.x;
+    stream.y[index] = value.y;
+    stream.z[index] = value.z;
+  }
+
+  static void Gm_MoveStream(Vec3fStream& stream, u32 fromIndex, u32 toIndex) {
+    stream.x[toIndex] = stream.x[fromIndex];
+    stream.y[toIndex] = stream.y[fromIndex];
+    stream.z[toIndex] = stream.z[fromIndex];
+  }
+
   /**
    * ObjectPool
    * ----------
@@ -18,224 +70,602 @@ namespace Gamma {
     return objects;
   }
 
+  u32 ObjectPool::capacity() const {
+    return totalCapacity;
+  }
+
+  void ObjectPool::clearDirtyRanges() {
+    if (hasDirtyChunks) {
+      std::fill(dirtyChunks.begin(), dirtyChunks.end(), false);
+
+      hasDirtyChunks = false;
+    }
+  }
+
+  /**
+   * Gathers the indices of all objects with dirty transforms
+   * into a list of unique indices, clearing their dirty state,
+   * and returns the number collected. Their matrices can then
+   * be computed with computeDirtyTransforms().
+   */
+  u32 ObjectPool::collectDirtyTransforms() {
+    u32 total = 0;
+
+    for (u32 i = 0; i < dirtyIndices.size(); i++) {
+      u32 index = dirtyIndices[i];
+
+      // Skip stale entries for since-removed objects, objects
+      // which were explicitly transformed, and duplicates
+      if (index < totalActiveObjects && dirtyFlags[index] & DIRTY_TRANSFORM) {
+        dirtyFlags[index] &= ~DIRTY_TRANSFORM;
+        dirtyIndices[total++] = index;
+
+        markDirty(index);
+      }
+    }
+
+    dirtyIndices.resize(total);
+
+    return total;
+  }
+
+  /**
+   * Computes matrices for a range of the objects gathered by
+   * collectDirtyTransforms(). Disjoint ranges can be computed
+   * in parallel, as long as the pool is otherwise unchanged.
+   */
+  void ObjectPool::computeDirtyTransforms(u32 start, u32 end) {
+    Gm_ComputeTransformsGL(positions, scales, rotations, dirtyIndices.data() + start, end - start, matrices);
+  }
+
+  /**
+   * Determines which objects have bounding spheres intersecting
+   * the provided frustum, given the mesh's model-space bounding
+   * radius, and records their indices as the visible set.
+   * Returns the number of visible objects.
+   */
+  u32 ObjectPool::computeVisibility(const Frustum& frustum, float radius) {
+    totalVisibleObjects = Gm_CullSpheres(frustum, positions, scales, radius, totalActiveObjects, visibleIndices);
+    hasVisibilityList = true;
+
+    return totalVisibleObjects;
+  }
+
+  /**
+   * Updates the transform streams and colors of a span of
+   * objects from their Object records, equivalent to calling
+   * setTransformById() and setColorById() for each of them.
+   */
+  void ObjectPool::commitObjects(const ObjectSpan& span) {
+    u32 start = u32(span.objects - objects);
+
+    assert(span.count == 0 || (span.objects >= objects && start + span.count <= totalActiveObjects), "Attempted to commit objects outside of the Object Pool");
+
+    for (u32 index = start; index < start + span.count; index++) {
+      auto& object = objects[index];
+
+      Gm_WriteStream(positions, index, object.position);
+      Gm_WriteStream(scales, index, object.scale);
+      Gm_WriteStream(rotations, index, object.rotation);
+
+      colors[index] = object.color;
+
+      if (!(dirtyFlags[index] & DIRTY_TRANSFORM)) {
+        dirtyFlags[index] |= DIRTY_TRANSFORM;
+        dirtyIndices.push_back(index);
+      }
+
+      markDirty(index);
+    }
+  }
+
   Object& ObjectPool::createObject() {
-    u16 id = runningId++;
+    return createObjects(1)[0];
+  }
 
-    assert(max() > totalActive(), "Object Pool out of space: " + std::to_string(max()) + " objects allowed in this pool");
-    // @todo cycle through indices until an unoccupied slot is found
-    assert(indices[id] == UNUSED_OBJECT_INDEX, "Attempted to create an Object in an occupied slot");
+  /**
+   * Creates a number of objects in one go, growing the pool at
+   * most once, and returns them as a contiguous span.
+   */
+  ObjectSpan ObjectPool::createObjects(u32 count) {
+    assert(max() - totalActive() >= count, "Object Pool out of space: " + std::to_string(max()) + " objects allowed in this pool");
 
-    // Retrieve and initialize object
-    u16 index = totalActiveObjects;
-    Object& object = objects[index];
+    u32 start = totalActiveObjects;
 
-    object._record.id = id;
-    object._record.generation++;
+    if (start + count > totalCapacity) {
+      // Grow by at least one chunk, or by half the
+      // current capacity for larger pools
+      u32 growth = totalCapacity / 2 > OBJECT_POOL_CHUNK_SIZE ? totalCapacity / 2 : OBJECT_POOL_CHUNK_SIZE;
+      u32 required = start + count > totalCapacity + growth ? start + count : totalCapacity + growth;
+      u32 size = (required + OBJECT_POOL_CHUNK_SIZE - 1) / OBJECT_POOL_CHUNK_SIZE * OBJECT_POOL_CHUNK_SIZE;
 
-    // Reset object matrix/color
-    matrices[index] = Matrix4f::identity();
-    colors[index] = pVec4(255, 255, 255);
+      resize(size > max() ? max() : size);
+    }
 
-    // Enable object lookup by ID -> index
-    indices[id] = index;
+    for (u32 index = start; index < start + count; index++) {
+      u32 id;
 
-    totalActiveObjects++;
-    totalVisibleObjects++;
+      // Recycle the ID of a previously-removed object where possible,
+      // so the ID -> index table only grows with the peak object count
+      if (freeIds.size() > 0) {
+        id = freeIds.back();
 
-    return object;
+        freeIds.pop_back();
+      } else {
+        assert(runningId < MAX_OBJECT_ID, "Object Pool out of IDs");
+
+        id = runningId++;
+      }
+
+      auto& slot = getSlot(id);
+
+      assert(slot.index == UNUSED_OBJECT_INDEX, "Attempted to create an Object in an occupied slot");
+
+      // Retrieve and initialize object
+      Object& object = objects[index];
+
+      // Advance the slot generation so any records
+      // referring to the ID's prior owner become stale
+      slot.generation++;
+      slot.index = index;
+
+      object._record.id = id;
+      object._record.generation = slot.generation;
+
+      // Reset object matrix/color/transform streams
+      matrices[index] = Matrix4f::identity();
+      colors[index] = pVec4(255, 255, 255);
+
+      Gm_WriteStream(positions, index, Vec3f(0.0f));
+      Gm_WriteStream(scales, index, Vec3f(1.0f));
+      Gm_WriteStream(rotations, index, Vec3f(0.0f));
+
+      lodLevels[index] = 0;
+      dirtyFlags[index] = 0;
+
+      markDirty(index);
+    }
+
+    totalActiveObjects += count;
+
+    // Any existing visibility list is invalidated
+    // by changes to the set of active objects
+    showAll();
+
+    return { objects + start, count };
   }
 
   Object* ObjectPool::end() const {
     return &objects[totalActiveObjects];
   }
 
-  void ObjectPool::free() {
-    for (u16 i = 0; i < USHRT_MAX; i++) {
-      indices[i] = UNUSED_OBJECT_INDEX;
-    }
+  ObjectSlot* ObjectPool::findSlot(u32 objectId) const {
+    u32 page = objectId / OBJECT_SLOT_PAGE_SIZE;
 
-    if (objects != nullptr) {
-      delete[] objects;
+    if (page >= slotPages.size()) {
+      return nullptr;
     }
 
-    if (matrices != nullptr) {
-      delete[] matrices;
-    }
+    return &slotPages[page][objectId % OBJECT_SLOT_PAGE_SIZE];
+  }
 
-    if (colors != nullptr) {
-      delete[] colors;
+  void ObjectPool::free() {
+    for (auto* page : slotPages) {
+      delete[] page;
     }
 
-    objects = nullptr;
-    matrices = nullptr;
-    colors = nullptr;
+    slotPages.clear();
+    slotPages.shrink_to_fit();
+    freeIds.clear();
+    freeIds.shrink_to_fit();
+    lodSortBuffer.clear();
+    lodSortBuffer.shrink_to_fit();
+    dirtyIndices.clear();
+    dirtyIndices.shrink_to_fit();
+
+    totalActiveObjects = 0;
+    runningId = 0;
+
+    showAll();
+    resize(0);
   }
 
-  Object* ObjectPool::getById(u16 objectId) const {
-    u16 index = indices[objectId];
+  Object* ObjectPool::getById(u32 objectId) const {
+    auto* slot = findSlot(objectId);
 
-    return index == UNUSED_OBJECT_INDEX ? nullptr : &objects[index];
+    return slot == nullptr || slot->index == UNUSED_OBJECT_INDEX ? nullptr : &objects[slot->index];
   }
 
   Object* ObjectPool::getByRecord(const ObjectRecord& record) const {
-    auto* object = getById(record.id);
+    auto* slot = findSlot(record.id);
 
-    if (object == nullptr || object->_record.generation != record.generation) {
+    if (slot == nullptr || slot->index == UNUSED_OBJECT_INDEX || slot->generation != record.generation) {
       return nullptr;
     }
 
-    return object;
+    return &objects[slot->index];
   }
 
   pVec4* ObjectPool::getColors() const {
     return colors;
   }
 
+  /**
+   * Collects contiguous ranges of active objects whose matrices
+   * or colors have changed since the last clearDirtyRanges().
+   */
+  void ObjectPool::getDirtyRanges(std::vector<ObjectRange>& ranges) const {
+    ranges.clear();
+
+    if (!hasDirtyChunks) {
+      return;
+    }
+
+    for (u32 chunk = 0; chunk < dirtyChunks.size(); chunk++) {
+      if (!dirtyChunks[chunk]) {
+        continue;
+      }
+
+      u32 start = chunk * OBJECT_POOL_CHUNK_SIZE;
+
+      if (start >= totalActiveObjects) {
+        break;
+      }
+
+      u32 end = std::min(start + OBJECT_POOL_CHUNK_SIZE, totalActiveObjects);
+
+      if (ranges.size() > 0 && ranges.back().start + ranges.back().count == start) {
+        // Extend the previous range across adjacent chunks
+        ranges.back().count += end - start;
+      } else {
+        ranges.push_back({ start, end - start });
+      }
+    }
+  }
+
   Matrix4f* ObjectPool::getMatrices() const {
     return matrices;
   }
 
-  u16 ObjectPool::max() const {
+  ObjectSlot& ObjectPool::getSlot(u32 objectId) {
+    u32 page = objectId / OBJECT_SLOT_PAGE_SIZE;
+
+    // Allocate lookup table pages on demand
+    while (page >= slotPages.size()) {
+      auto* slots = new ObjectSlot[OBJECT_SLOT_PAGE_SIZE];
+
+      for (u32 i = 0; i < OBJECT_SLOT_PAGE_SIZE; i++) {
+        slots[i].index = UNUSED_OBJECT_INDEX;
+        slots[i].generation = 0;
+      }
+
+      slotPages.push_back(slots);
+    }
+
+    return slotPages[page][objectId % OBJECT_SLOT_PAGE_SIZE];
+  }
+
+  void ObjectPool::markDirty(u32 index) {
+    dirtyChunks[index / OBJECT_POOL_CHUNK_SIZE] = true;
+    hasDirtyChunks = true;
+  }
+
+  const Vec3fStream& ObjectPool::getPositions() const {
+    return positions;
+  }
+
+  const Vec3fStream& ObjectPool::getRotations() const {
+    return rotations;
+  }
+
+  const Vec3fStream& ObjectPool::getScales() const {
+    return scales;
+  }
+
+  const u32* ObjectPool::getVisibleIndices() const {
+    return hasVisibilityList ? visibleIndices : nullptr;
+  }
+
+  u32 ObjectPool::max() const {
     return maxObjects;
   }
 
-  // @todo consolidate logic in partitionByDistance/partitionByVisibility
-  u16 ObjectPool::partitionByDistance(u16 start, float distance, const Vec3f& cameraPosition) {
-    u16 current = start;
-    u16 end = totalVisible();
+  void ObjectPool::moveObject(u32 fromIndex, u32 toIndex) {
+    objects[toIndex] = objects[fromIndex];
+    matrices[toIndex] = matrices[fromIndex];
+    colors[toIndex] = colors[fromIndex];
 
-    while (end > current) {
-      float currentObjectDistance = (objects[current].position - cameraPosition).magnitude();
+    Gm_MoveStream(positions, fromIndex, toIndex);
+    Gm_MoveStream(scales, fromIndex, toIndex);
+    Gm_MoveStream(rotations, fromIndex, toIndex);
 
-      if (currentObjectDistance <= distance) {
-        current++;
-      } else {
-        float endObjectDistance;
+    lodLevels[toIndex] = lodLevels[fromIndex];
+    dirtyFlags[toIndex] = dirtyFlags[fromIndex];
 
-        do {
-          endObjectDistance = (objects[--end].position - cameraPosition).magnitude();
-        } while (endObjectDistance > distance && end > current);
+    markDirty(toIndex);
 
-        if (current != end) {
-          swapObjects(current, end);
-        }
+    if (dirtyFlags[toIndex] & DIRTY_TRANSFORM) {
+      // Track the object's transform at its new index
+      dirtyIndices.push_back(toIndex);
+    }
+  }
+
+  /**
+   * Groups visible objects by level of detail in a single pass,
+   * given the boundary distances between consecutive levels.
+   * Objects are counting-sorted into contiguous, ascending LoD
+   * groups within the visible index list, preserving their
+   * relative order, and the size of each group is written out
+   * to levelCounts.
+   *
+   * With useObjectScale, boundary distances are multiplied by
+   * each object's largest scale component, so larger objects
+   * switch to lower levels of detail further away, in line with
+   * their projected size.
+   *
+   * Objects only change levels once they pass a boundary by a
+   * margin, so objects sitting near a boundary don't flicker
+   * between levels (or churn the sort) as the camera moves.
+   */
+  void ObjectPool::partitionVisibleByLod(const Vec3f& cameraPosition, const float* distances, u32 totalLevels, bool useObjectScale, u32* levelCounts) {
+    assert(totalLevels > 0 && totalLevels <= MAX_LOD_LEVELS, "Invalid number of LoD levels: " + std::to_string(totalLevels));
 
-        // @optimize we can increment 'current' here if endObjectDistance < distance
-        // to avoid recalculating the same distance on the next while loop cycle
-        // @todo test this out and make sure it works
+    if (!hasVisibilityList) {
+      // Partition all active objects
+      for (u32 i = 0; i < totalActiveObjects; i++) {
+        visibleIndices[i] = i;
       }
+
+      hasVisibilityList = true;
     }
 
-    return current;
-  }
+    // Squared distances at which objects move to the next
+    // level (farther) or back to the previous one (nearer)
+    float farThresholds[MAX_LOD_LEVELS];
+    float nearThresholds[MAX_LOD_LEVELS];
+    u32 offsets[MAX_LOD_LEVELS];
+    u32 lastLevel = totalLevels - 1;
 
-  // @todo consolidate logic in partitionByDistance/partitionByVisibility
-  // @todo accept a distance threshold to avoid culling partially
-  // in-frame/partially out-of-frame objects
-  // @todo use camera FoV to determine dot product threshold
-  void ObjectPool::partitionByVisibility(const Camera& camera) {
-    u16 current = 0;
-    u16 end = totalActive();
-    Vec3f cameraDirection = camera.orientation.getDirection();
+    for (u32 level = 0; level < lastLevel; level++) {
+      float farDistance = distances[level] * (1.f + LOD_HYSTERESIS);
+      float nearDistance = distances[level] * (1.f - LOD_HYSTERESIS);
 
-    while (end > current) {
-      Vec3f objectUnitViewPosition = (objects[current].position - camera.position).unit();
+      farThresholds[level] = farDistance * farDistance;
+      nearThresholds[level] = nearDistance * nearDistance;
+    }
 
-      if (Vec3f::dot(cameraDirection, objectUnitViewPosition) >= 0.7f) {
-        current++;
-      } else {
-        Vec3f endObjectUnitViewPosition;
+    for (u32 level = 0; level < totalLevels; level++) {
+      levelCounts[level] = 0;
+    }
+
+    // Determine the level of each visible object
+    for (u32 i = 0; i < totalVisibleObjects; i++) {
+      u32 index = visibleIndices[i];
+      float dx = positions.x[index] - cameraPosition.x;
+      float dy = positions.y[index] - cameraPosition.y;
+      float dz = positions.z[index] - cameraPosition.z;
+      float distanceSquared = dx * dx + dy * dy + dz * dz;
+
+      if (useObjectScale) {
+        float sx = scales.x[index];
+        float sy = scales.y[index];
+        float sz = scales.z[index];
+        float scaleSquared = std::max(sx * sx, std::max(sy * sy, sz * sz));
+
+        distanceSquared /= scaleSquared;
+      }
 
-        do {
-          endObjectUnitViewPosition = (objects[--end].position - camera.position).unit();
-        } while (Vec3f::dot(cameraDirection, endObjectUnitViewPosition) < 0.7f && end > current);
+      u32 level = lodLevels[index];
 
-        if (current != end) {
-          swapObjects(current, end);
-        }
+      if (level > lastLevel) {
+        level = lastLevel;
       }
+
+      while (level > 0 && distanceSquared < nearThresholds[level - 1]) {
+        level--;
+      }
+
+      while (level < lastLevel && distanceSquared > farThresholds[level]) {
+        level++;
+      }
+
+      lodLevels[index] = (u8)level;
+      levelCounts[level]++;
+    }
+
+    // Scatter visible indices into their level groups
+    u32 offset = 0;
+
+    for (u32 level = 0; level < totalLevels; level++) {
+      offsets[level] = offset;
+      offset += levelCounts[level];
+    }
+
+    lodSortBuffer.resize(totalVisibleObjects);
+
+    for (u32 i = 0; i < totalVisibleObjects; i++) {
+      u32 index = visibleIndices[i];
+
+      lodSortBuffer[offsets[lodLevels[index]]++] = index;
     }
 
-    totalVisibleObjects = current;
+    std::copy(lodSortBuffer.begin(), lodSortBuffer.end(), visibleIndices);
   }
 
-  void ObjectPool::removeById(u16 objectId) {
-    u16 index = indices[objectId];
+  void ObjectPool::removeById(u32 objectId) {
+    auto* slot = findSlot(objectId);
 
-    if (index == UNUSED_OBJECT_INDEX) {
+    if (slot == nullptr || slot->index == UNUSED_OBJECT_INDEX) {
       return;
     }
 
-    totalActiveObjects--;
-    totalVisibleObjects--;
+    u32 index = slot->index;
+    u32 lastIndex = --totalActiveObjects;
 
-    u16 lastIndex = totalActiveObjects;
-
-    // Move last object/matrix/color into removed index
-    objects[index] = objects[lastIndex];
-    matrices[index] = matrices[lastIndex];
-    colors[index] = colors[lastIndex];
+    // Move last object into removed index
+    moveObject(lastIndex, index);
 
     // Update ID -> index lookup table
-    indices[objects[index]._record.id] = index;
-    indices[objectId] = UNUSED_OBJECT_INDEX;
+    findSlot(objects[index]._record.id)->index = index;
+    slot->index = UNUSED_OBJECT_INDEX;
+
+    freeIds.push_back(objectId);
+
+    showAll();
+  }
+
+  /**
+   * Removes a set of objects by ID, compacting the remaining
+   * objects in a single pass. Unlike removeById(), remaining
+   * objects keep their relative order.
+   */
+  void ObjectPool::removeMany(const std::vector<u32>& objectIds) {
+    std::vector<bool> isRemoved(totalActiveObjects, false);
+    u32 firstRemovedIndex = totalActiveObjects;
+
+    for (u32 objectId : objectIds) {
+      auto* slot = findSlot(objectId);
+
+      if (slot == nullptr || slot->index == UNUSED_OBJECT_INDEX) {
+        continue;
+      }
+
+      isRemoved[slot->index] = true;
+      firstRemovedIndex = std::min(firstRemovedIndex, (u32)slot->index);
+      slot->index = UNUSED_OBJECT_INDEX;
+
+      freeIds.push_back(objectId);
+    }
+
+    if (firstRemovedIndex == totalActiveObjects) {
+      return;
+    }
+
+    // Shift remaining objects down over removed ones,
+    // updating the ID -> index lookup table as we go
+    u32 total = firstRemovedIndex;
+
+    for (u32 index = firstRemovedIndex + 1; index < totalActiveObjects; index++) {
+      if (!isRemoved[index]) {
+        moveObject(index, total);
+
+        findSlot(objects[total]._record.id)->index = total;
+
+        total++;
+      }
+    }
+
+    totalActiveObjects = total;
+
+    showAll();
   }
 
   void ObjectPool::reset() {
-    for (u16 i = 0; i < totalActiveObjects; i++) {
-      indices[objects[i]._record.id] = UNUSED_OBJECT_INDEX;
+    for (u32 i = 0; i < totalActiveObjects; i++) {
+      findSlot(objects[i]._record.id)->index = UNUSED_OBJECT_INDEX;
     }
 
+    // Slot generations are preserved, so records to
+    // objects from before the reset remain invalid
+    freeIds.clear();
+    dirtyIndices.clear();
+
     totalActiveObjects = 0;
-    totalVisibleObjects = 0;
     runningId = 0;
+
+    showAll();
+  }
+
+  void ObjectPool::reserve(u32 size) {
+    if (size > totalCapacity) {
+      resize(size > max() ? max() : size);
+    }
+  }
+
+  void ObjectPool::resize(u32 size) {
+    assert(size >= totalActiveObjects, "Attempted to resize an Object Pool below its active object count");
+
+    Gm_ResizeAligned(objects, size, totalActiveObjects);
+    Gm_ResizeAligned(matrices, size, totalActiveObjects);
+    Gm_ResizeAligned(colors, size, totalActiveObjects);
+    Gm_ResizeAligned(positions, size, totalActiveObjects);
+    Gm_ResizeAligned(scales, size, totalActiveObjects);
+    Gm_ResizeAligned(rotations, size, totalActiveObjects);
+    Gm_ResizeAligned(lodLevels, size, totalActiveObjects);
+    Gm_ResizeAligned(dirtyFlags, size, totalActiveObjects);
+    Gm_ResizeAligned(visibleIndices, size, 0);
+
+    // Resized storage needs to be uploaded in full
+    dirtyChunks.assign((size + OBJECT_POOL_CHUNK_SIZE - 1) / OBJECT_POOL_CHUNK_SIZE, true);
+    hasDirtyChunks = true;
+
+    totalCapacity = size;
   }
 
-  void ObjectPool::reserve(u16 size) {
-    free();
+  void ObjectPool::setMax(u32 size) {
+    assert(size <= MAX_OBJECT_ID, "Object Pools cannot exceed " + std::to_string(MAX_OBJECT_ID) + " objects");
 
     maxObjects = size;
-    totalActiveObjects = 0;
-    totalVisibleObjects = 0;
-    objects = new Object[size];
-    matrices = new Matrix4f[size];
-    colors = new pVec4[size];
+  }
+
+  void ObjectPool::setTransformById(u32 objectId, const Vec3f& position, const Vec3f& scale, const Vec3f& rotation) {
+    u32 index = findSlot(objectId)->index;
+
+    Gm_WriteStream(positions, index, position);
+    Gm_WriteStream(scales, index, scale);
+    Gm_WriteStream(rotations, index, rotation);
+
+    if (!(dirtyFlags[index] & DIRTY_TRANSFORM)) {
+      dirtyFlags[index] |= DIRTY_TRANSFORM;
+      dirtyIndices.push_back(index);
+    }
   }
 
   void ObjectPool::showAll() {
     totalVisibleObjects = totalActiveObjects;
+    hasVisibilityList = false;
   }
 
-  void ObjectPool::swapObjects(u16 indexA, u16 indexB) {
-    Object objectA = objects[indexA];
-    Matrix4f matrixA = matrices[indexA];
-    pVec4 colorA = colors[indexA];
+  void ObjectPool::shrinkToFit() {
+    u32 size = (totalActiveObjects + OBJECT_POOL_CHUNK_SIZE - 1) / OBJECT_POOL_CHUNK_SIZE * OBJECT_POOL_CHUNK_SIZE;
 
-    objects[indexA] = objects[indexB];
-    matrices[indexA] = matrices[indexB];
-    colors[indexA] = colors[indexB];
+    if (size > max()) {
+      size = max();
+    }
 
-    objects[indexB] = objectA;
-    matrices[indexB] = matrixA;
-    colors[indexB] = colorA;
+    if (size < totalCapacity) {
+      resize(size);
+    }
 
-    indices[objects[indexA]._record.id] = indexA;
-    indices[objects[indexB]._record.id] = indexB;
+    freeIds.shrink_to_fit();
   }
 
-  void ObjectPool::setColorById(u16 objectId, const pVec4& color) {
-    colors[indices[objectId]] = color;
+  void ObjectPool::setColorById(u32 objectId, const pVec4& color) {
+    u32 index = findSlot(objectId)->index;
+
+    colors[index] = color;
+
+    markDirty(index);
   }
 
-  u16 ObjectPool::totalActive() const {
+  u32 ObjectPool::totalActive() const {
     return totalActiveObjects;
   }
 
-  u16 ObjectPool::totalVisible() const {
+  u32 ObjectPool::totalVisible() const {
     return totalVisibleObjects;
   }
 
-  void ObjectPool::transformById(u16 objectId, const Matrix4f& matrix) {
-    matrices[indices[objectId]] = matrix;
+  /**
+   * Explicitly sets an object's matrix, overriding any pending
+   * transform from setTransformById().
+   */
+  void ObjectPool::transformById(u32 objectId, const Matrix4f& matrix) {
+    u32 index = findSlot(objectId)->index;
+
+    matrices[index] = matrix;
+    dirtyFlags[index] &= ~DIRTY_TRANSFORM;
+
+    markDirty(index);
   }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "math/matrix.h"
 #include "system/packed_data.h"
 #include "system/type_aliases.h"
@@ -7,7 +9,51 @@
 namespace Gamma {
   struct Object;
   struct ObjectRecord;
-  struct Camera;
+  struct ObjectSpan;
+  struct Frustum;
+
+  const static u32 MAX_LOD_LEVELS = 8;
+
+  /**
+   * ObjectSlot
+   * ----------
+   *
+   * An entry in the ObjectPool ID -> index lookup table,
+   * tracking the current generation of an object ID so
+   * stale ObjectRecords can be detected once the ID is
+   * recycled.
+   *
+   * @size 4 bytes
+   */
+  struct ObjectSlot {
+    u32 index : 24;
+    u32 generation : 8;
+  };
+
+  /**
+   * Vec3fStream
+   * -----------
+   *
+   * Separate x/y/z component arrays for a vector property
+   * of every object in an ObjectPool, allowing passes over
+   * that property to read it in SIMD-friendly batches.
+   */
+  struct Vec3fStream {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+  };
+
+  /**
+   * ObjectRange
+   * -----------
+   *
+   * A contiguous range of objects in an ObjectPool.
+   */
+  struct ObjectRange {
+    u32 start = 0;
+    u32 count = 0;
+  };
 
   /**
    * ObjectPool
@@ -16,45 +62,102 @@ namespace Gamma {
    * A collection of Objects tied to a given Mesh, designed
    * to facilitate instanced/batched rendering.
    *
-   * @todo u16 -> u32 to support >65K objects per pool
+   * Object IDs are 24-bit slots into a paged lookup table,
+   * which only allocates pages for the range of IDs actually
+   * handed out. IDs of removed objects are recycled before
+   * any new IDs are created.
+   *
+   * Object/matrix/color storage grows on demand in cache-aligned
+   * chunks, and stays contiguous so the active range can be
+   * uploaded for instancing in one go. Growing the pool may
+   * relocate its storage, so Object references should not be
+   * held across object creation in the same pool.
+   *
+   * Alongside the Object records, pools keep structure-of-arrays
+   * position/scale/rotation streams, written when objects are
+   * committed. Per-frame passes over large numbers of objects
+   * (culling, LoD selection) read these instead of the Objects
+   * themselves, which are left to game code.
+   *
+   * Committing an object's transform only marks it as dirty.
+   * Matrices for all dirty objects are computed together once
+   * per frame, in batches which may be split across threads.
+   * Pools also track which chunks of objects have had their
+   * matrices or colors changed since the last frame, so static
+   * objects don't need to be re-uploaded for rendering.
+   *
+   * Culling never reorders objects, since game code relies on
+   * stable pool order (e.g. to keep compound mesh pools aligned).
+   * Instead, computeVisibility() produces a list of visible object
+   * indices, which LoD selection further groups in place.
    */
   class ObjectPool {
   public:
     Object& operator[](u32 index);
 
     Object* begin() const;
+    u32 capacity() const;
+    void clearDirtyRanges();
+    u32 collectDirtyTransforms();
+    void commitObjects(const ObjectSpan& span);
+    void computeDirtyTransforms(u32 start, u32 end);
+    u32 computeVisibility(const Frustum& frustum, float radius);
     Object& createObject();
+    ObjectSpan createObjects(u32 count);
     Object* end() const;
     void free();
-    Object* getById(u16 objectId) const;
+    Object* getById(u32 objectId) const;
     Object* getByRecord(const ObjectRecord& record) const;
     pVec4* getColors() const;
+    void getDirtyRanges(std::vector<ObjectRange>& ranges) const;
     Matrix4f* getMatrices() const;
-    u16 max() const;
-    u16 partitionByDistance(u16 start, float distance, const Vec3f& cameraPosition);
-    void partitionByVisibility(const Camera& camera);
-    void removeById(u16 objectId);
+    const Vec3fStream& getPositions() const;
+    const Vec3fStream& getRotations() const;
+    const Vec3fStream& getScales() const;
+    const u32* getVisibleIndices() const;
+    u32 max() const;
+    void partitionVisibleByLod(const Vec3f& cameraPosition, const float* distances, u32 totalLevels, bool useObjectScale, u32* levelCounts);
+    void removeById(u32 objectId);
+    void removeMany(const std::vector<u32>& objectIds);
     void reset();
-    void reserve(u16 size);
-    void setColorById(u16 objectId, const pVec4& color);
+    void reserve(u32 size);
+    void setColorById(u32 objectId, const pVec4& color);
+    void setMax(u32 size);
+    void setTransformById(u32 objectId, const Vec3f& position, const Vec3f& scale, const Vec3f& rotation);
     void showAll();
-    u16 totalActive() const;
-    u16 totalVisible() const;
-    void transformById(u16 objectId, const Matrix4f& matrix);
+    void shrinkToFit();
+    u32 totalActive() const;
+    u32 totalVisible() const;
+    void transformById(u32 objectId, const Matrix4f& matrix);
 
   private:
     Object* objects = nullptr;
     Matrix4f* matrices = nullptr;
     pVec4* colors = nullptr;
-    // @todo if we cycle through indices to find unoccupied slots
-    // when creating new objects, we needn't preallocate the entire
-    // indices array up to USHRT_MAX/0xffff
-    u16 indices[0xffff];
-    u16 maxObjects = 0;
-    u16 totalActiveObjects = 0;
-    u16 totalVisibleObjects = 0;
-    u16 runningId = 0;
-
-    void swapObjects(u16 indexA, u16 indexB);
+    Vec3fStream positions;
+    Vec3fStream scales;
+    Vec3fStream rotations;
+    u8* lodLevels = nullptr;
+    u8* dirtyFlags = nullptr;
+    u32* visibleIndices = nullptr;
+    std::vector<ObjectSlot*> slotPages;
+    std::vector<u32> freeIds;
+    std::vector<u32> dirtyIndices;
+    std::vector<bool> dirtyChunks;
+    std::vector<u32> lodSortBuffer;
+    // Pools are only capped by the 24-bit ID range unless setMax() is used
+    u32 maxObjects = 0xffffff;
+    u32 totalCapacity = 0;
+    u32 totalActiveObjects = 0;
+    u32 totalVisibleObjects = 0;
+    u32 runningId = 0;
+    bool hasVisibilityList = false;
+    bool hasDirtyChunks = false;
+
+    ObjectSlot* findSlot(u32 objectId) const;
+    ObjectSlot& getSlot(u32 objectId);
+    void markDirty(u32 index);
+    void moveObject(u32 fromIndex, u32 toIndex);
+    void resize(u32 size);
   };
 }
\ No newline at end of file
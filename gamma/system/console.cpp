@@ -4,6 +4,7 @@
 
 namespace Gamma {
   std::stringstream Console::output;
+  std::mutex Console::mutex;
   ConsoleMessage* Console::firstMessage = nullptr;
   ConsoleMessage* Console::lastMessage = nullptr;
   u32 Console::messageCounter = 0;
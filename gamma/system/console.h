@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -18,6 +19,10 @@ namespace Gamma {
   public:
     template<typename ...Args>
     static void log(Args&& ...args) {
+      // Meshes may be loaded on worker threads (see Gm_AddMeshes()),
+      // so only allow one thread to write messages at a time
+      std::lock_guard<std::mutex> lock(mutex);
+
       // @todo output time with each console message
       out(args...);
       std::cout << "\n";
@@ -31,6 +36,7 @@ namespace Gamma {
 
   private:
     static std::stringstream output;
+    static std::mutex mutex;
     static ConsoleMessage* firstMessage;
     static ConsoleMessage* lastMessage;
     static u32 messageCounter;
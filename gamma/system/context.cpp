@@ -53,6 +53,8 @@ static void Gm_DisplayDevtools(GmContext* context) {
   auto vertsLabel = "Verts: " + String(sceneStats.verts);
   auto trisLabel = "Tris: " + String(sceneStats.tris);
   auto memoryLabel = "GPU Memory: " + String(renderStats.gpuMemoryUsed) + "MB / " + String(renderStats.gpuMemoryTotal) + "MB";
+  auto uploadLabel = "Instance uploads: " + String(renderStats.instanceBytesUploaded) + " bytes";
+  auto drawCallsLabel = "Draw calls: " + String(renderStats.drawCalls);
 
   renderer.renderText(font_sm, fpsLabel.c_str(), 25, 25);
   renderer.renderText(font_sm, frameTimeLabel.c_str(), 25, 50);
@@ -60,12 +62,14 @@ static void Gm_DisplayDevtools(GmContext* context) {
   renderer.renderText(font_sm, vertsLabel.c_str(), 25, 100);
   renderer.renderText(font_sm, trisLabel.c_str(), 25, 125);
   renderer.renderText(font_sm, memoryLabel.c_str(), 25, 150);
+  renderer.renderText(font_sm, uploadLabel.c_str(), 25, 175);
+  renderer.renderText(font_sm, drawCallsLabel.c_str(), 25, 200);
 
   // Render user-defined debug messages
   u8 index = 0;
 
   for (auto& message : context->debugMessages) {
-    renderer.renderText(font_sm, message.c_str(), 25, 200 + index++ * 25, Vec3f(1.f), Vec4f(0.f, 0.f, 0.f, 0.8f));
+    renderer.renderText(font_sm, message.c_str(), 25, 225 + index++ * 25, Vec3f(1.f), Vec4f(0.f, 0.f, 0.f, 0.8f));
   }
 
   context->debugMessages.clear();
@@ -102,6 +106,8 @@ GmContext* Gm_CreateContext() {
   context->window.font_sm = TTF_OpenFont("./fonts/OpenSans-Regular.ttf", 16);
   context->window.font_lg = TTF_OpenFont("./fonts/OpenSans-Regular.ttf", 22);
 
+  Gm_InitTransformWorkers();
+
   return context;
 }
 
@@ -198,8 +204,16 @@ void Gm_HandleEvents(GmContext* context) {
 }
 
 void Gm_RenderScene(GmContext* context) {
+  Gm_UpdateStreamedMeshes(context);
+  Gm_UpdateTransforms(context);
+
   context->renderer->render();
 
+  // Changed instance data has now been uploaded
+  for (auto* mesh : context->scene.meshes) {
+    mesh->objects.clearDirtyRanges();
+  }
+
   #if GAMMA_DEVELOPER_MODE
     Gm_DisplayDevtools(context);
   #endif
@@ -226,6 +240,8 @@ void Gm_LogFrameEnd(GmContext* context) {
 void Gm_DestroyContext(GmContext* context) {
   // @todo clear scene
 
+  Gm_DestroyTransformWorkers();
+
   IMG_Quit();
 
   TTF_CloseFont(context->window.font_sm);
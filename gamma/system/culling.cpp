@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <immintrin.h>
+
+#include "math/utilities.h"
+#include "system/culling.h"
+
+namespace Gamma {
+  u32 Gm_CullSpheres(const Frustum& frustum, const Vec3fStream& positions, const Vec3fStream& scales, float radius, u32 total, u32* visibleIndices) {
+    auto* planes = frustum.planes;
+    u32 i = 0;
+    u32 count = 0;
+
+    #if defined(__AVX__)
+      const __m256 signMask8 = _mm256_set1_ps(-0.f);
+      const __m256 radius8 = _mm256_set1_ps(radius);
+
+      for (; i + 8 <= total; i += 8) {
+        __m256 x = _mm256_loadu_ps(positions.x + i);
+        __m256 y = _mm256_loadu_ps(positions.y + i);
+        __m256 z = _mm256_loadu_ps(positions.z + i);
+
+        // Largest absolute scale component, negated to get
+        // the minimum signed distance for each plane test
+        __m256 scale = _mm256_max_ps(
+          _mm256_andnot_ps(signMask8, _mm256_loadu_ps(scales.x + i)),
+          _mm256_max_ps(
+            _mm256_andnot_ps(signMask8, _mm256_loadu_ps(scales.y + i)),
+            _mm256_andnot_ps(signMask8, _mm256_loadu_ps(scales.z + i))
+          )
+        );
+
+        __m256 minDistance = _mm256_xor_ps(_mm256_mul_ps(scale, radius8), signMask8);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (u32 p = 0; p < 6; p++) {
+          auto& plane = planes[p];
+
+          __m256 distance = _mm256_add_ps(
+            _mm256_add_ps(
+              _mm256_mul_ps(x, _mm256_set1_ps(plane.x)),
+              _mm256_mul_ps(y, _mm256_set1_ps(plane.y))
+            ),
+            _mm256_add_ps(
+              _mm256_mul_ps(z, _mm256_set1_ps(plane.z)),
+              _mm256_set1_ps(plane.w)
+            )
+          );
+
+          inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, minDistance, _CMP_GE_OQ));
+        }
+
+        u32 mask = (u32)_mm256_movemask_ps(inside);
+
+        // Write every index, but only advance past visible ones
+        for (u32 lane = 0; lane < 8; lane++) {
+          visibleIndices[count] = i + lane;
+          count += (mask >> lane) & 1;
+        }
+      }
+    #endif
+
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    const __m128 radius4 = _mm_set1_ps(radius);
+
+    for (; i + 4 <= total; i += 4) {
+      __m128 x = _mm_loadu_ps(positions.x + i);
+      __m128 y = _mm_loadu_ps(positions.y + i);
+      __m128 z = _mm_loadu_ps(positions.z + i);
+
+      __m128 scale = _mm_max_ps(
+        _mm_andnot_ps(signMask, _mm_loadu_ps(scales.x + i)),
+        _mm_max_ps(
+          _mm_andnot_ps(signMask, _mm_loadu_ps(scales.y + i)),
+          _mm_andnot_ps(signMask, _mm_loadu_ps(scales.z + i))
+        )
+      );
+
+      __m128 minDistance = _mm_xor_ps(_mm_mul_ps(scale, radius4), signMask);
+      __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+      for (u32 p = 0; p < 6; p++) {
+        auto& plane = planes[p];
+
+        __m128 distance = _mm_add_ps(
+          _mm_add_ps(
+            _mm_mul_ps(x, _mm_set1_ps(plane.x)),
+            _mm_mul_ps(y, _mm_set1_ps(plane.y))
+          ),
+          _mm_add_ps(
+            _mm_mul_ps(z, _mm_set1_ps(plane.z)),
+            _mm_set1_ps(plane.w)
+          )
+        );
+
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, minDistance));
+      }
+
+      u32 mask = (u32)_mm_movemask_ps(inside);
+
+      for (u32 lane = 0; lane < 4; lane++) {
+        visibleIndices[count] = i + lane;
+        count += (mask >> lane) & 1;
+      }
+    }
+
+    return count + Gm_CullSpheresScalar(frustum, positions, scales, radius, i, total, visibleIndices + count);
+  }
+
+  u32 Gm_CullSpheresScalar(const Frustum& frustum, const Vec3fStream& positions, const Vec3fStream& scales, float radius, u32 start, u32 end, u32* visibleIndices) {
+    u32 count = 0;
+
+    for (u32 i = start; i < end; i++) {
+      float scale = std::max(Gm_Absf(scales.x[i]), std::max(Gm_Absf(scales.y[i]), Gm_Absf(scales.z[i])));
+      Vec3f center = Vec3f(positions.x[i], positions.y[i], positions.z[i]);
+
+      if (frustum.isSphereVisible(center, radius * scale)) {
+        visibleIndices[count++] = i;
+      }
+    }
+
+    return count;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "math/frustum.h"
+#include "system/ObjectPool.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * Gm_CullSpheres
+   * --------------
+   *
+   * Tests a batch of bounding spheres against a Frustum, writing
+   * the indices of visible spheres into the provided buffer and
+   * returning the visible count. Sphere centers are read from the
+   * position stream, and radii are scaled by the largest absolute
+   * component of the scale stream. The output buffer must have
+   * room for the full batch.
+   *
+   * Spheres are tested 4 at a time with SSE, or 8 at a time with
+   * AVX where the build targets it.
+   */
+  u32 Gm_CullSpheres(const Frustum& frustum, const Vec3fStream& positions, const Vec3fStream& scales, float radius, u32 total, u32* visibleIndices);
+
+  /**
+   * Gm_CullSpheresScalar
+   * --------------------
+   *
+   * Non-vectorized equivalent of Gm_CullSpheres(), used for
+   * remainders and as a reference for benchmarking.
+   */
+  u32 Gm_CullSpheresScalar(const Frustum& frustum, const Vec3fStream& positions, const Vec3fStream& scales, float radius, u32 start, u32 end, u32* visibleIndices);
+}
\ No newline at end of file
@@ -1,13 +1,26 @@
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
-#include <map>
+#include <math.h>
 #include <utility>
 
 #include "math/vector.h"
 #include "system/assert.h"
+#include "system/console.h"
 #include "system/entities.h"
+#include "system/flags.h"
+#include "system/mesh_cache.h"
+#include "system/mesh_optimization.h"
+#include "system/mesh_simplification.h"
 #include "system/ObjLoader.h"
 
+#define UNUSED_VERTEX_INDEX 0xFFFFFFFF
+/**
+ * Minimum cosine of the angle between the normals
+ * of two near-coincident vertices for them to be welded
+ */
+#define WELD_NORMAL_COSINE 0.9999f
+
 namespace Gamma {
   /**
    * Defines positions for each corner of the unit cube
@@ -45,6 +58,43 @@ namespace Gamma {
     { 5, 1, 2, 6 }            // right
   };
 
+  /**
+   * Gm_ComputeBounds
+   * ----------------
+   *
+   * Determines the model-space bounding box and bounding
+   * sphere radius of a Mesh from its vertices.
+   */
+  void Gm_ComputeBounds(Mesh* mesh) {
+    auto& vertices = mesh->vertices;
+
+    if (vertices.size() == 0) {
+      return;
+    }
+
+    Vec3f minimum = vertices[0].position;
+    Vec3f maximum = vertices[0].position;
+    float radiusSquared = 0.f;
+
+    for (auto& vertex : vertices) {
+      auto& position = vertex.position;
+
+      minimum.x = std::min(minimum.x, position.x);
+      minimum.y = std::min(minimum.y, position.y);
+      minimum.z = std::min(minimum.z, position.z);
+
+      maximum.x = std::max(maximum.x, position.x);
+      maximum.y = std::max(maximum.y, position.y);
+      maximum.z = std::max(maximum.z, position.z);
+
+      radiusSquared = std::max(radiusSquared, Vec3f::dot(position, position));
+    }
+
+    mesh->minimumBounds = minimum;
+    mesh->maximumBounds = maximum;
+    mesh->boundingRadius = sqrtf(radiusSquared);
+  }
+
   /**
    * Gm_ComputeNormals
    * -----------------
@@ -105,6 +155,201 @@ namespace Gamma {
     }
   }
 
+  /**
+   * Gm_HashIndexes
+   * --------------
+   *
+   * Mixes three 32-bit values into a well-distributed hash.
+   */
+  inline static u32 Gm_HashIndexes(u32 a, u32 b, u32 c) {
+    u32 hash = a * 0x9E3779B1 ^ b * 0x85EBCA77 ^ c * 0xC2B2AE3D;
+
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352D;
+    hash ^= hash >> 15;
+
+    return hash;
+  }
+
+  /**
+   * VertexTupleTable
+   * ----------------
+   *
+   * An open-addressing (linearly-probed) hash table mapping .obj
+   * position/uv/normal index tuples to buffered vertex indexes.
+   */
+  struct VertexTupleTable {
+    struct Entry {
+      VertexData key;
+      u32 index;
+    };
+
+    std::vector<Entry> entries;
+    u32 mask = 0;
+
+    /**
+     * Empties the table, sizing it for a given number of keys
+     * at <= 50% load. Storage is only ever grown, so the table
+     * can be reused between models without reallocating.
+     */
+    void reset(u32 totalKeys) {
+      u32 capacity = 16;
+
+      while (capacity < totalKeys * 2) {
+        capacity <<= 1;
+      }
+
+      if (entries.size() < capacity) {
+        entries.resize(capacity);
+      }
+
+      mask = capacity - 1;
+
+      for (u32 i = 0; i < capacity; i++) {
+        entries[i].index = UNUSED_VERTEX_INDEX;
+      }
+    }
+
+    /**
+     * Returns the entry for a key, which is unused
+     * (index == UNUSED_VERTEX_INDEX) for new keys.
+     */
+    Entry& find(const VertexData& key) {
+      u32 slot = Gm_HashIndexes(key.vertexIndex, key.textureCoordinateIndex, key.normalIndex) & mask;
+
+      while (true) {
+        auto& entry = entries[slot];
+
+        if (
+          entry.index == UNUSED_VERTEX_INDEX || (
+            entry.key.vertexIndex == key.vertexIndex &&
+            entry.key.textureCoordinateIndex == key.textureCoordinateIndex &&
+            entry.key.normalIndex == key.normalIndex
+          )
+        ) {
+          return entry;
+        }
+
+        slot = (slot + 1) & mask;
+      }
+    }
+  };
+
+  /**
+   * VertexWeldGrid
+   * --------------
+   *
+   * A spatial hash of buffered vertices over a grid of cells
+   * the size of the weld distance, used to find existing
+   * vertices near-coincident with new ones.
+   */
+  struct VertexWeldGrid {
+    struct Cell {
+      s32 x;
+      s32 y;
+      s32 z;
+      u32 head;
+    };
+
+    std::vector<Cell> cells;
+    // Links each vertex to the next in its cell
+    std::vector<u32> next;
+    u32 mask = 0;
+    u32 baseVertex = 0;
+    float distance = 0.f;
+
+    void reset(u32 totalVertices, u32 baseVertex, float distance) {
+      u32 capacity = 16;
+
+      while (capacity < totalVertices * 2) {
+        capacity <<= 1;
+      }
+
+      if (cells.size() < capacity) {
+        cells.resize(capacity);
+      }
+
+      for (u32 i = 0; i < capacity; i++) {
+        cells[i].head = UNUSED_VERTEX_INDEX;
+      }
+
+      next.clear();
+
+      this->mask = capacity - 1;
+      this->baseVertex = baseVertex;
+      this->distance = distance;
+    }
+
+    Cell& findCell(s32 x, s32 y, s32 z) {
+      u32 slot = Gm_HashIndexes(x, y, z) & mask;
+
+      while (true) {
+        auto& cell = cells[slot];
+
+        if (cell.head == UNUSED_VERTEX_INDEX || (cell.x == x && cell.y == y && cell.z == z)) {
+          return cell;
+        }
+
+        slot = (slot + 1) & mask;
+      }
+    }
+
+    /**
+     * Returns the index of an existing vertex within the weld
+     * distance of the given one and with a matching normal,
+     * or UNUSED_VERTEX_INDEX if none exists.
+     */
+    u32 findMatch(const std::vector<Vertex>& vertices, const Vertex& vertex) {
+      s32 cx = (s32)floorf(vertex.position.x / distance);
+      s32 cy = (s32)floorf(vertex.position.y / distance);
+      s32 cz = (s32)floorf(vertex.position.z / distance);
+      float maxDistanceSquared = distance * distance;
+
+      // Matches may lie in any neighboring cell
+      for (s32 x = cx - 1; x <= cx + 1; x++) {
+        for (s32 y = cy - 1; y <= cy + 1; y++) {
+          for (s32 z = cz - 1; z <= cz + 1; z++) {
+            u32 index = findCell(x, y, z).head;
+
+            while (index != UNUSED_VERTEX_INDEX) {
+              auto& candidate = vertices[index];
+              Vec3f delta = candidate.position - vertex.position;
+
+              if (
+                Vec3f::dot(delta, delta) <= maxDistanceSquared &&
+                Vec3f::dot(candidate.normal, vertex.normal) >= WELD_NORMAL_COSINE * candidate.normal.magnitude() * vertex.normal.magnitude()
+              ) {
+                return index;
+              }
+
+              index = next[index - baseVertex];
+            }
+          }
+        }
+      }
+
+      return UNUSED_VERTEX_INDEX;
+    }
+
+    void insert(const std::vector<Vertex>& vertices, u32 index) {
+      auto& position = vertices[index].position;
+      s32 x = (s32)floorf(position.x / distance);
+      s32 y = (s32)floorf(position.y / distance);
+      s32 z = (s32)floorf(position.z / distance);
+      auto& cell = findCell(x, y, z);
+
+      if (cell.head == UNUSED_VERTEX_INDEX) {
+        cell.x = x;
+        cell.y = y;
+        cell.z = z;
+      }
+
+      next.push_back(cell.head);
+
+      cell.head = index;
+    }
+  };
+
   /**
    * Gm_BufferObjData
    * ----------------
@@ -113,6 +358,11 @@ namespace Gamma {
    * defined in a preliminary state, into vertex/face element
    * buffers defined on Meshes or other global buffers.
    *
+   * With a nonzero weld distance, vertices within that distance
+   * of an existing one with the same normal are merged into it,
+   * regardless of texture coordinates. This collapses UV seams,
+   * so it should only be used for untextured models.
+   *
    * @todo we may not want to add the base vertex offset here;
    * once this is used to pack multiple (distinct, not merely LOD)
    * meshes into a common vertex/element buffer, it may be preferable
@@ -120,7 +370,7 @@ namespace Gamma {
    * alone is technically feasible though. reconsider when revisiting
    * this for glMultiDrawElementsIndirect().
    */
-  static void Gm_BufferObjData(const ObjLoader& obj, std::vector<Vertex>& vertices, std::vector<u32>& faceElements) {
+  static void Gm_BufferObjData(const ObjLoader& obj, std::vector<Vertex>& vertices, std::vector<u32>& faceElements, float weldDistance = 0.f) {
     u32 baseVertex = vertices.size();
 
     if (obj.textureCoordinates.size() == 0 && obj.normals.size() == 0) {
@@ -141,51 +391,66 @@ namespace Gamma {
     } else {
       // Texture coordinates and/or normals defined, so we need
       // to create a unique vertex for each position/uv/normal
-      // tuple, and add face elements based on created vertices
-      typedef std::tuple<u32, u32, u32> VertexTuple;
+      // tuple, and add face elements based on created vertices.
+      // Tables are kept between calls to reuse their storage.
+      thread_local static VertexTupleTable vertexTupleTable;
+      thread_local static VertexWeldGrid vertexWeldGrid;
+      bool useWelding = weldDistance > 0.f;
+
+      vertexTupleTable.reset(obj.faces.size() * 3);
+
+      if (useWelding) {
+        vertexWeldGrid.reset(obj.faces.size() * 3, baseVertex, weldDistance);
+      }
 
-      std::map<VertexTuple, u32> vertexTupleToIndexMap;
+      vertices.reserve(vertices.size() + obj.vertices.size());
+      faceElements.reserve(faceElements.size() + obj.faces.size() * 3);
 
       for (const auto& face : obj.faces) {
-        VertexTuple vertexTuples[3] = {
-          { face.v1.vertexIndex, face.v1.textureCoordinateIndex, face.v1.normalIndex },
-          { face.v2.vertexIndex, face.v2.textureCoordinateIndex, face.v2.normalIndex },
-          { face.v3.vertexIndex, face.v3.textureCoordinateIndex, face.v3.normalIndex }
-        };
+        const VertexData* vertexTuples[3] = { &face.v1, &face.v2, &face.v3 };
 
         // Add face elements, creating vertices if necessary
         for (u32 p = 0; p < 3; p++) {
-          auto& vertexTuple = vertexTuples[p];
-          auto indexRecord = vertexTupleToIndexMap.find(vertexTuple);
+          auto& vertexTuple = *vertexTuples[p];
+          auto& entry = vertexTupleTable.find(vertexTuple);
 
-          if (indexRecord != vertexTupleToIndexMap.end()) {
+          if (entry.index != UNUSED_VERTEX_INDEX) {
             // Vertex tuple already exists, so we can just
             // add the stored face element index
-            faceElements.push_back(indexRecord->second);
-          } else {
-            // Vertex doesn't exist, so we need to create it
-            Vertex vertex;
-            u32 index = vertices.size();
-
-            // @todo Have the option to run through existing vertices,
-            // compare position, and re-use any which are within a minuscule
-            // distance threshold of this one to avoid duplicates. Certain
-            // obj files may do this on purpose, so it should be opt-in.
-            vertex.position = obj.vertices[std::get<0>(vertexTuple)];
-
-            if (obj.textureCoordinates.size() > 0) {
-              vertex.uv = obj.textureCoordinates[std::get<1>(vertexTuple)];
-            }
+            faceElements.push_back(entry.index);
 
-            if (obj.normals.size() > 0) {
-              vertex.normal = obj.normals[std::get<2>(vertexTuple)];
-            }
+            continue;
+          }
+
+          // Vertex doesn't exist, so we need to create it
+          Vertex vertex;
+
+          vertex.position = obj.vertices[vertexTuple.vertexIndex];
+
+          if (obj.textureCoordinates.size() > 0) {
+            vertex.uv = obj.textureCoordinates[vertexTuple.textureCoordinateIndex];
+          }
+
+          if (obj.normals.size() > 0) {
+            vertex.normal = obj.normals[vertexTuple.normalIndex];
+          }
+
+          u32 index = useWelding ? vertexWeldGrid.findMatch(vertices, vertex) : UNUSED_VERTEX_INDEX;
+
+          if (index == UNUSED_VERTEX_INDEX) {
+            index = vertices.size();
 
             vertices.push_back(vertex);
-            faceElements.push_back(index);
 
-            vertexTupleToIndexMap.emplace(vertexTuple, index);
+            if (useWelding) {
+              vertexWeldGrid.insert(vertices, index);
+            }
           }
+
+          faceElements.push_back(index);
+
+          entry.key = vertexTuple;
+          entry.index = index;
         }
       }
     }
@@ -234,28 +499,74 @@ namespace Gamma {
 
     Gm_ComputeNormals(mesh);
     Gm_ComputeTangents(mesh);
+    Gm_ComputeBounds(mesh);
 
     return mesh;
   }
 
+  /**
+   * Gm_OptimizeModel
+   * ----------------
+   *
+   * Applies vertex cache/fetch optimizations to a freshly-processed
+   * model, as configured by its ModelOptions.
+   */
+  static void Gm_OptimizeModel(const char* path, const ModelOptions& options, Mesh* mesh) {
+    if (!options.optimizeVertexCache) {
+      return;
+    }
+
+    auto stats = Gm_OptimizeMesh(mesh, options.optimizeOverdraw);
+
+    #if GAMMA_DEVELOPER_MODE
+      Console::log(
+        "[Gamma] Optimized model:", path,
+        "| ACMR:", stats.before.acmr, "->", stats.after.acmr,
+        "| ATVR:", stats.before.atvr, "->", stats.after.atvr
+      );
+    #endif
+  }
+
   /**
    * Mesh::Model()
    * -------------
    *
-   * Loads an .obj model file into a Mesh.
+   * Loads an .obj model file into a Mesh, generating
+   * lower levels of detail if configured to.
    */
-  Mesh* Mesh::Model(const char* path) {
-    ObjLoader obj(path);
-
+  Mesh* Mesh::Model(const char* path, const ModelOptions& options) {
     auto* mesh = new Mesh();
 
-    Gm_BufferObjData(obj, mesh->vertices, mesh->faceElements);
+    // Use the cooked mesh where possible, only parsing
+    // and processing the source model when it changes
+    if (!Gm_LoadCookedMesh({ path }, options, mesh)) {
+      ObjLoader obj(path);
+
+      Gm_BufferObjData(obj, mesh->vertices, mesh->faceElements, options.weldDistance);
+
+      if (obj.normals.size() == 0) {
+        Gm_ComputeNormals(mesh);
+      }
 
-    if (obj.normals.size() == 0) {
-      Gm_ComputeNormals(mesh);
+      Gm_ComputeTangents(mesh);
+
+      if (options.lodRatios.size() > 0) {
+        Gm_GenerateLods(mesh, options.lodRatios);
+
+        #if GAMMA_DEVELOPER_MODE
+          for (u32 i = 1; i < mesh->lods.size(); i++) {
+            Console::log("[Gamma] Generated LoD", i, "for", path, "|", mesh->lods[i].elementCount / 3, "triangles");
+          }
+        #endif
+      }
+
+      Gm_OptimizeModel(path, options, mesh);
+      Gm_SaveCookedMesh({ path }, options, mesh);
     }
 
-    Gm_ComputeTangents(mesh);
+    Gm_ComputeBounds(mesh);
+
+    mesh->useQuantizedVertices = options.quantizeVertices;
 
     return mesh;
   }
@@ -268,13 +579,21 @@ namespace Gamma {
    * treating each consecutive model as a lower level
    * of detail.
    */
-  Mesh* Mesh::Model(const std::vector<std::string>& paths) {
+  Mesh* Mesh::Model(const std::vector<std::string>& paths, const ModelOptions& options) {
     if (paths.size() == 1) {
-      return Mesh::Model(paths[0].c_str());
+      return Mesh::Model(paths[0].c_str(), options);
     }
 
     auto* mesh = new Mesh();
 
+    mesh->useQuantizedVertices = options.quantizeVertices;
+
+    if (Gm_LoadCookedMesh(paths, options, mesh)) {
+      Gm_ComputeBounds(mesh);
+
+      return mesh;
+    }
+
     mesh->lods.resize(paths.size());
 
     for (u32 i = 0; i < paths.size(); i++) {
@@ -285,7 +604,7 @@ namespace Gamma {
       mesh->lods[i].elementOffset = mesh->faceElements.size();
       mesh->lods[i].vertexOffset = mesh->vertices.size();
 
-      Gm_BufferObjData(obj, mesh->vertices, mesh->faceElements);
+      Gm_BufferObjData(obj, mesh->vertices, mesh->faceElements, options.weldDistance);
 
       mesh->lods[i].elementCount = mesh->faceElements.size() - mesh->lods[i].elementOffset;
       mesh->lods[i].vertexCount = mesh->vertices.size() - mesh->lods[i].vertexOffset;
@@ -293,6 +612,9 @@ namespace Gamma {
 
     Gm_ComputeNormals(mesh);
     Gm_ComputeTangents(mesh);
+    Gm_OptimizeModel(paths[0].c_str(), options, mesh);
+    Gm_SaveCookedMesh(paths, options, mesh);
+    Gm_ComputeBounds(mesh);
 
     return mesh;
   }
@@ -383,6 +705,7 @@ namespace Gamma {
 
     Gm_ComputeNormals(mesh);
     Gm_ComputeTangents(mesh);
+    Gm_ComputeBounds(mesh);
 
     return mesh;
   }
@@ -57,10 +57,12 @@ namespace Gamma {
     u16 meshIndex = 0;
     // @todo remove this and allow meshes to be 'deactivated' when freed
     u16 meshId = 0;
-    // @todo u32 id with 24 bits for id and 8 for generation,
-    // allowing up to ~16.77 million objects per pool
-    u16 id = 0;
-    u16 generation = 0;
+    // 24 bits for id and 8 for generation, allowing
+    // up to ~16.77 million objects per pool
+    u32 id : 24;
+    u32 generation : 8;
+
+    ObjectRecord(): id(0), generation(0) {};
   };
 
   /**
@@ -81,6 +83,62 @@ namespace Gamma {
     pVec4 color;
   };
 
+  /**
+   * ObjectSpan
+   * ----------
+   *
+   * A contiguous run of Objects in an ObjectPool, as created
+   * in bulk. Like Object references, spans are invalidated by
+   * further object creation or removal in the same pool.
+   */
+  struct ObjectSpan {
+    Object* objects = nullptr;
+    u32 count = 0;
+
+    Object& operator[](u32 index) const {
+      return objects[index];
+    }
+
+    Object* begin() const {
+      return objects;
+    }
+
+    Object* end() const {
+      return objects + count;
+    }
+  };
+
+  /**
+   * MeshHandle
+   * ----------
+   *
+   * A stable handle to a named scene Mesh, resolved
+   * once by name for O(1) access in update code.
+   */
+  struct MeshHandle {
+    u16 index = 0xFFFF;
+  };
+
+  /**
+   * ObjectHandle
+   * ------------
+   *
+   * A stable handle to a named, saved scene Object.
+   */
+  struct ObjectHandle {
+    u32 index = 0xFFFFFFFF;
+  };
+
+  /**
+   * LightHandle
+   * -----------
+   *
+   * A stable handle to a named, saved scene Light.
+   */
+  struct LightHandle {
+    u32 index = 0xFFFFFFFF;
+  };
+
   /**
    * A set of Mesh types, particular to all instances of a Mesh,
    * controlling the rendering priority and properties of those
@@ -206,6 +264,43 @@ namespace Gamma {
     float speed = 1.f;
   };
 
+  /**
+   * ModelOptions
+   * ------------
+   *
+   * Processing options for models loaded via Mesh::Model().
+   */
+  struct ModelOptions {
+    /**
+     * When nonzero, vertices within this distance of one another
+     * which share a normal are welded together, regardless of their
+     * texture coordinates. Only suitable for untextured models.
+     */
+    float weldDistance = 0.f;
+    /**
+     * Reorders faces and vertices for vertex cache and
+     * vertex fetch locality. See Gm_OptimizeMesh().
+     */
+    bool optimizeVertexCache = true;
+    /**
+     * Additionally sorts face clusters so that the outer-facing
+     * sides of the model draw first, reducing overdraw at a
+     * small cost to vertex cache efficiency.
+     */
+    bool optimizeOverdraw = false;
+    /**
+     * Triangle ratios, relative to the source model, of lower
+     * levels of detail to generate by simplifying the model.
+     * Only applies to models with a single source file.
+     */
+    std::vector<float> lodRatios;
+    /**
+     * Uploads the model's vertices in the compact
+     * QuantizedVertex format. See Mesh::useQuantizedVertices.
+     */
+    bool quantizeVertices = false;
+  };
+
   /**
    * Mesh
    * ----
@@ -251,6 +346,31 @@ namespace Gamma {
      * @see MeshLod
      */
     std::vector<MeshLod> lods;
+    /**
+     * Determines whether vertices are uploaded to the GPU as
+     * QuantizedVertices (16 bytes each), rather than as full
+     * Vertex structs (44 bytes each), with positions normalized
+     * to the mesh bounds. Only suitable for static geometry, and
+     * must be set before the Mesh is added to the scene.
+     *
+     * @see QuantizedVertex
+     */
+    bool useQuantizedVertices = false;
+    /**
+     * The smallest model-space vertex coordinates.
+     */
+    Vec3f minimumBounds;
+    /**
+     * The largest model-space vertex coordinates.
+     */
+    Vec3f maximumBounds;
+    /**
+     * The radius of a sphere around the model-space
+     * origin which encloses every vertex. Since objects
+     * rotate and scale about their origin, this bounds
+     * each object as a sphere around its position.
+     */
+    float boundingRadius = 0.f;
     /**
      * A collection of objects representing unique instances
      * of the mesh.
@@ -295,6 +415,25 @@ namespace Gamma {
      * ignored in all rendering passes.
      */
     bool disabled = false;
+    /**
+     * Determines whether the mesh's geometry is loaded.
+     * Streamed meshes are added to the scene without any
+     * geometry, and are loaded and unloaded on demand while
+     * their objects remain in place; non-resident meshes
+     * have no GPU resources and are not rendered.
+     *
+     * @see Gm_RetainMesh()
+     * @see Gm_ReleaseMesh()
+     */
+    bool isResident = true;
+    /**
+     * Incremented whenever the mesh's geometry is replaced
+     * after it's added to the scene, prompting the renderer
+     * to re-buffer it.
+     *
+     * @see Gm_ReplaceMeshGeometry()
+     */
+    u32 geometryVersion = 0;
     /**
      * Configuration for particle system meshes.
      */
@@ -312,8 +451,8 @@ namespace Gamma {
     float emissivity = 0.f;
 
     static Mesh* Cube();
-    static Mesh* Model(const char* path);
-    static Mesh* Model(const std::vector<std::string>& paths);
+    static Mesh* Model(const char* path, const ModelOptions& options = ModelOptions());
+    static Mesh* Model(const std::vector<std::string>& paths, const ModelOptions& options = ModelOptions());
     static Mesh* Particles();
     static Mesh* Plane(u32 size, bool useLoopingTexture = false);
     // @todo Sphere(u32 divisions)
@@ -323,6 +462,12 @@ namespace Gamma {
     void transformGeometry(std::function<void(const Vertex&, Vertex&)> handler);
   };
 
+  /**
+   * Gm_ComputeBounds
+   * ----------------
+   */
+  void Gm_ComputeBounds(Mesh* mesh);
+
   /**
    * Gm_FreeMesh
    * -----------
@@ -0,0 +1,213 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "math/geometry.h"
+#include "system/console.h"
+#include "system/entities.h"
+#include "system/MappedFile.h"
+#include "system/mesh_cache.h"
+#include "system/type_aliases.h"
+
+/**
+ * "GMSH", as little-endian bytes
+ */
+#define GMESH_MAGIC 0x48534D47
+/**
+ * Bump whenever the cooked layout, or the processing
+ * applied to meshes before they're cooked, changes
+ */
+#define GMESH_FORMAT_VERSION 1
+
+namespace Gamma {
+  /**
+   * GmeshHeader
+   * -----------
+   *
+   * Precedes the contents of a cooked mesh file, which are laid out as:
+   *
+   *  [header]
+   *  [source key, padded to 4 bytes]
+   *  [Vertex * totalVertices]
+   *  [u32 * totalFaceElements]
+   *  [MeshLod * totalLods]
+   */
+  struct GmeshHeader {
+    u32 magic = GMESH_MAGIC;
+    u32 version = GMESH_FORMAT_VERSION;
+    u32 vertexSize = sizeof(Vertex);
+    u32 lodSize = sizeof(MeshLod);
+    u32 keyLength = 0;
+    u32 totalVertices = 0;
+    u32 totalFaceElements = 0;
+    u32 totalLods = 0;
+  };
+
+  inline static u64 Gm_AlignTo4(u64 size) {
+    return (size + 3) & ~3ULL;
+  }
+
+  /**
+   * Builds a key identifying the exact source files and options
+   * a cooked mesh was built from. Any change to a source's path or
+   * last write time, or to the options, produces a different key,
+   * invalidating the cache. Returns an empty key if any of the
+   * sources are missing.
+   */
+  static std::string Gm_GetCookedMeshKey(const std::vector<std::string>& sourcePaths, const ModelOptions& options) {
+    std::string key = "weld:" + std::to_string(options.weldDistance) + "\n";
+
+    key += "optimize:" + std::to_string(options.optimizeVertexCache) + std::to_string(options.optimizeOverdraw) + "\n";
+    key += "lods:";
+
+    for (float ratio : options.lodRatios) {
+      key += std::to_string(ratio) + " ";
+    }
+
+    key += "\n";
+
+    for (auto& path : sourcePaths) {
+      std::error_code error;
+      auto writeTime = std::filesystem::last_write_time(path, error);
+
+      if (error) {
+        return "";
+      }
+
+      key += path + "|" + std::to_string(writeTime.time_since_epoch().count()) + "\n";
+    }
+
+    return key;
+  }
+
+  /**
+   * Gm_GetCookedMeshPath
+   * --------------------
+   *
+   * Returns the path to the cooked mesh file for a set of
+   * source models, alongside the first source model.
+   */
+  std::string Gm_GetCookedMeshPath(const std::vector<std::string>& sourcePaths) {
+    std::filesystem::path path = sourcePaths[0];
+
+    // Keep LoD sets distinct from single models
+    // loaded from the same first source
+    path.replace_extension(sourcePaths.size() > 1 ? ".lods.gmesh" : ".gmesh");
+
+    return path.string();
+  }
+
+  /**
+   * Gm_LoadCookedMesh
+   * -----------------
+   *
+   * Loads the vertices, face elements and LoDs of a Mesh from
+   * its cooked mesh file, if one exists and is up to date with
+   * the given source models and options. Returns false otherwise.
+   */
+  bool Gm_LoadCookedMesh(const std::vector<std::string>& sourcePaths, const ModelOptions& options, Mesh* mesh) {
+    auto cookedPath = Gm_GetCookedMeshPath(sourcePaths);
+
+    if (!std::filesystem::exists(cookedPath)) {
+      return false;
+    }
+
+    auto key = Gm_GetCookedMeshKey(sourcePaths, options);
+    MappedFile file(cookedPath.c_str());
+
+    if (key.size() == 0 || !file.isOpen() || file.size() < sizeof(GmeshHeader)) {
+      return false;
+    }
+
+    GmeshHeader header;
+
+    memcpy(&header, file.data(), sizeof(GmeshHeader));
+
+    u64 keyOffset = sizeof(GmeshHeader);
+    u64 verticesOffset = keyOffset + Gm_AlignTo4(header.keyLength);
+    u64 faceElementsOffset = verticesOffset + u64(header.totalVertices) * sizeof(Vertex);
+    u64 lodsOffset = faceElementsOffset + u64(header.totalFaceElements) * sizeof(u32);
+    u64 totalSize = lodsOffset + u64(header.totalLods) * sizeof(MeshLod);
+
+    if (
+      header.magic != GMESH_MAGIC ||
+      header.version != GMESH_FORMAT_VERSION ||
+      header.vertexSize != sizeof(Vertex) ||
+      header.lodSize != sizeof(MeshLod) ||
+      header.keyLength != key.size() ||
+      file.size() != totalSize ||
+      memcmp(file.data() + keyOffset, key.data(), key.size()) != 0
+    ) {
+      return false;
+    }
+
+    auto* vertices = (const Vertex*)(file.data() + verticesOffset);
+    auto* faceElements = (const u32*)(file.data() + faceElementsOffset);
+    auto* lods = (const MeshLod*)(file.data() + lodsOffset);
+
+    mesh->vertices.assign(vertices, vertices + header.totalVertices);
+    mesh->faceElements.assign(faceElements, faceElements + header.totalFaceElements);
+    mesh->lods.assign(lods, lods + header.totalLods);
+
+    for (auto& lod : mesh->lods) {
+      lod.instanceOffset = 0;
+      lod.instanceCount = 0;
+    }
+
+    return true;
+  }
+
+  /**
+   * Gm_SaveCookedMesh
+   * -----------------
+   *
+   * Writes the vertices, face elements and LoDs of a Mesh
+   * built from the given source models and options to a
+   * cooked mesh file.
+   */
+  void Gm_SaveCookedMesh(const std::vector<std::string>& sourcePaths, const ModelOptions& options, const Mesh* mesh) {
+    auto key = Gm_GetCookedMeshKey(sourcePaths, options);
+
+    if (key.size() == 0 || mesh->vertices.size() == 0) {
+      return;
+    }
+
+    auto cookedPath = Gm_GetCookedMeshPath(sourcePaths);
+    auto temporaryPath = cookedPath + ".tmp";
+    GmeshHeader header;
+    const char padding[4] = { 0 };
+
+    header.keyLength = (u32)key.size();
+    header.totalVertices = (u32)mesh->vertices.size();
+    header.totalFaceElements = (u32)mesh->faceElements.size();
+    header.totalLods = (u32)mesh->lods.size();
+
+    bool isWritten = false;
+    std::error_code error;
+
+    {
+      std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+      file.write((const char*)&header, sizeof(GmeshHeader));
+      file.write(key.data(), key.size());
+      file.write(padding, Gm_AlignTo4(key.size()) - key.size());
+      file.write((const char*)mesh->vertices.data(), mesh->vertices.size() * sizeof(Vertex));
+      file.write((const char*)mesh->faceElements.data(), mesh->faceElements.size() * sizeof(u32));
+      file.write((const char*)mesh->lods.data(), mesh->lods.size() * sizeof(MeshLod));
+
+      isWritten = file.good();
+    }
+
+    // Swap in the complete file, so a partially-written
+    // one is never picked up by a later load
+    if (isWritten) {
+      std::filesystem::rename(temporaryPath, cookedPath, error);
+    }
+
+    if (!isWritten || error) {
+      Console::log("[Gamma] Failed to write cooked mesh:", cookedPath);
+
+      std::filesystem::remove(temporaryPath, error);
+    }
+  }
+}
\ No newline at end of file
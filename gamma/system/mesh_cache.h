@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Gamma {
+  struct Mesh;
+  struct ModelOptions;
+
+  std::string Gm_GetCookedMeshPath(const std::vector<std::string>& sourcePaths);
+  bool Gm_LoadCookedMesh(const std::vector<std::string>& sourcePaths, const ModelOptions& options, Mesh* mesh);
+  void Gm_SaveCookedMesh(const std::vector<std::string>& sourcePaths, const ModelOptions& options, const Mesh* mesh);
+}
\ No newline at end of file
@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+#include "math/vector.h"
+#include "system/entities.h"
+#include "system/mesh_optimization.h"
+
+/**
+ * The number of recently-used vertices considered 'cached'
+ * during vertex cache optimization. Deliberately larger than
+ * the FIFO size used in analysis, per Forsyth's recommendation.
+ */
+#define VERTEX_CACHE_SIZE 32
+#define CACHE_DECAY_POWER 1.5f
+#define LAST_TRIANGLE_SCORE 0.75f
+#define VALENCE_BOOST_SCALE 2.f
+#define VALENCE_BOOST_POWER 0.5f
+#define MAX_SCORED_VALENCE 32
+#define OVERDRAW_CACHE_SIZE 16
+#define UNUSED_INDEX 0xFFFFFFFF
+
+namespace Gamma {
+  /**
+   * Precomputed vertex scores by cache position and by
+   * remaining valence, as used in Gm_GetVertexScore().
+   */
+  struct VertexScoreTables {
+    float cacheScores[VERTEX_CACHE_SIZE];
+    float valenceScores[MAX_SCORED_VALENCE + 1];
+
+    VertexScoreTables() {
+      for (u32 i = 0; i < VERTEX_CACHE_SIZE; i++) {
+        // Vertices of the last triangle get a fixed score, so the
+        // next triangle isn't biased towards any one of its edges
+        cacheScores[i] = i < 3
+          ? LAST_TRIANGLE_SCORE
+          : powf(1.f - float(i - 3) / float(VERTEX_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+      }
+
+      valenceScores[0] = 0.f;
+
+      for (u32 i = 1; i <= MAX_SCORED_VALENCE; i++) {
+        valenceScores[i] = VALENCE_BOOST_SCALE * powf(float(i), -VALENCE_BOOST_POWER);
+      }
+    }
+  };
+
+  const static VertexScoreTables vertexScoreTables;
+
+  /**
+   * Scores a vertex by its position in the simulated cache
+   * and its number of remaining triangles. Low-valence vertices
+   * are boosted so that isolated triangles aren't left behind.
+   */
+  inline static float Gm_GetVertexScore(s32 cachePosition, u32 remainingValence) {
+    if (remainingValence == 0) {
+      return -1.f;
+    }
+
+    float score = cachePosition >= 0 ? vertexScoreTables.cacheScores[cachePosition] : 0.f;
+
+    return score + vertexScoreTables.valenceScores[std::min(remainingValence, (u32)MAX_SCORED_VALENCE)];
+  }
+
+  /**
+   * Gm_AnalyzeVertexCache
+   * ---------------------
+   *
+   * Simulates a FIFO post-transform vertex cache over an index
+   * buffer, returning its ACMR/ATVR. Indexes must be less than
+   * totalVertices.
+   */
+  VertexCacheStats Gm_AnalyzeVertexCache(const u32* indices, u32 totalIndices, u32 totalVertices, u32 cacheSize) {
+    VertexCacheStats stats;
+    std::vector<u32> cacheTimestamps(totalVertices, 0);
+    u32 timestamp = cacheSize + 1;
+    u32 totalMisses = 0;
+    u32 totalUniqueVertices = 0;
+
+    for (u32 i = 0; i < totalIndices; i++) {
+      u32 index = indices[i];
+
+      if (cacheTimestamps[index] == 0) {
+        totalUniqueVertices++;
+      }
+
+      if (timestamp - cacheTimestamps[index] > cacheSize) {
+        // Miss; push the vertex into the cache
+        cacheTimestamps[index] = timestamp++;
+        totalMisses++;
+      }
+    }
+
+    if (totalIndices > 0) {
+      stats.acmr = float(totalMisses) / float(totalIndices / 3);
+      stats.atvr = float(totalMisses) / float(totalUniqueVertices);
+    }
+
+    return stats;
+  }
+
+  /**
+   * Gm_OptimizeVertexCache
+   * ----------------------
+   *
+   * Reorders the triangles of an index buffer for post-transform
+   * vertex cache locality, using Tom Forsyth's 'Linear-Speed Vertex
+   * Cache Optimisation' algorithm. Triangles are emitted greedily by
+   * score, where vertices in a simulated LRU cache and vertices with
+   * few remaining triangles score highest.
+   *
+   * Indexes must lie in [vertexOffset, vertexOffset + totalVertices).
+   */
+  void Gm_OptimizeVertexCache(u32* indices, u32 totalIndices, u32 vertexOffset, u32 totalVertices) {
+    u32 totalTriangles = totalIndices / 3;
+
+    if (totalTriangles == 0) {
+      return;
+    }
+
+    // Build vertex -> triangle adjacency lists
+    std::vector<u32> remainingValences(totalVertices, 0);
+    std::vector<u32> adjacencyOffsets(totalVertices + 1, 0);
+    std::vector<u32> adjacency(totalTriangles * 3);
+
+    for (u32 i = 0; i < totalTriangles * 3; i++) {
+      remainingValences[indices[i] - vertexOffset]++;
+    }
+
+    for (u32 v = 0; v < totalVertices; v++) {
+      adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingValences[v];
+    }
+
+    {
+      std::vector<u32> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+      for (u32 i = 0; i < totalTriangles * 3; i++) {
+        adjacency[cursors[indices[i] - vertexOffset]++] = i / 3;
+      }
+    }
+
+    // Initialize vertex/triangle scores
+    std::vector<s32> cachePositions(totalVertices, -1);
+    std::vector<float> vertexScores(totalVertices);
+    std::vector<float> triangleScores(totalTriangles);
+    std::vector<bool> isEmitted(totalTriangles, false);
+    std::vector<u32> output(totalTriangles * 3);
+
+    for (u32 v = 0; v < totalVertices; v++) {
+      vertexScores[v] = Gm_GetVertexScore(-1, remainingValences[v]);
+    }
+
+    u32 bestTriangle = 0;
+
+    for (u32 t = 0; t < totalTriangles; t++) {
+      auto* triangle = &indices[t * 3];
+
+      triangleScores[t] = (
+        vertexScores[triangle[0] - vertexOffset] +
+        vertexScores[triangle[1] - vertexOffset] +
+        vertexScores[triangle[2] - vertexOffset]
+      );
+
+      if (triangleScores[t] > triangleScores[bestTriangle]) {
+        bestTriangle = t;
+      }
+    }
+
+    u32 cache[VERTEX_CACHE_SIZE + 3];
+    u32 nextCache[VERTEX_CACHE_SIZE + 3];
+    u32 cacheSize = 0;
+    u32 inputCursor = 0;
+
+    for (u32 emitted = 0; emitted < totalTriangles; emitted++) {
+      if (bestTriangle == UNUSED_INDEX) {
+        // No cached vertices have remaining triangles,
+        // so restart from the next unemitted triangle
+        while (isEmitted[inputCursor]) {
+          inputCursor++;
+        }
+
+        bestTriangle = inputCursor;
+      }
+
+      u32 triangle[3] = {
+        indices[bestTriangle * 3] - vertexOffset,
+        indices[bestTriangle * 3 + 1] - vertexOffset,
+        indices[bestTriangle * 3 + 2] - vertexOffset
+      };
+
+      output[emitted * 3] = triangle[0] + vertexOffset;
+      output[emitted * 3 + 1] = triangle[1] + vertexOffset;
+      output[emitted * 3 + 2] = triangle[2] + vertexOffset;
+
+      isEmitted[bestTriangle] = true;
+
+      // Remove the triangle from its vertices' adjacency lists
+      for (u32 v : triangle) {
+        auto* triangles = &adjacency[adjacencyOffsets[v]];
+        u32 total = remainingValences[v];
+
+        for (u32 i = 0; i < total; i++) {
+          if (triangles[i] == bestTriangle) {
+            triangles[i] = triangles[total - 1];
+            remainingValences[v]--;
+
+            break;
+          }
+        }
+      }
+
+      // Move the triangle's vertices to the front of the cache
+      u32 nextCacheSize = 0;
+
+      for (u32 v : triangle) {
+        if (std::find(nextCache, nextCache + nextCacheSize, v) == nextCache + nextCacheSize) {
+          nextCache[nextCacheSize++] = v;
+        }
+      }
+
+      for (u32 i = 0; i < cacheSize; i++) {
+        u32 v = cache[i];
+
+        if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+          nextCache[nextCacheSize++] = v;
+        }
+      }
+
+      // Rescore vertices in (or just evicted from) the cache
+      for (u32 i = 0; i < nextCacheSize; i++) {
+        u32 v = nextCache[i];
+        s32 position = i < VERTEX_CACHE_SIZE ? (s32)i : -1;
+
+        cachePositions[v] = position;
+        vertexScores[v] = Gm_GetVertexScore(position, remainingValences[v]);
+      }
+
+      // Rescore affected triangles, selecting the best one
+      // among those with vertices still in the cache
+      float bestScore = -1.f;
+
+      bestTriangle = UNUSED_INDEX;
+
+      for (u32 i = 0; i < nextCacheSize; i++) {
+        u32 v = nextCache[i];
+        auto* triangles = &adjacency[adjacencyOffsets[v]];
+
+        for (u32 j = 0; j < remainingValences[v]; j++) {
+          u32 t = triangles[j];
+          auto* vertices = &indices[t * 3];
+
+          triangleScores[t] = (
+            vertexScores[vertices[0] - vertexOffset] +
+            vertexScores[vertices[1] - vertexOffset] +
+            vertexScores[vertices[2] - vertexOffset]
+          );
+
+          if (i < VERTEX_CACHE_SIZE && triangleScores[t] > bestScore) {
+            bestScore = triangleScores[t];
+            bestTriangle = t;
+          }
+        }
+      }
+
+      cacheSize = std::min(nextCacheSize, (u32)VERTEX_CACHE_SIZE);
+
+      std::copy(nextCache, nextCache + cacheSize, cache);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+  }
+
+  /**
+   * Gm_OptimizeOverdraw
+   * -------------------
+   *
+   * Reorders clusters of triangles in a cache-optimized index
+   * buffer so that outward-facing clusters on the outside of the
+   * model draw first, in the manner of Tipsify's overdraw pass.
+   * Clusters are split where the simulated vertex cache is fully
+   * cold (all three vertices missing), so reordering them has
+   * little effect on cache efficiency.
+   */
+  void Gm_OptimizeOverdraw(u32* indices, u32 totalIndices, const Vertex* vertices) {
+    struct Cluster {
+      u32 start;
+      u32 end;
+      float sortKey;
+    };
+
+    u32 totalTriangles = totalIndices / 3;
+
+    if (totalTriangles == 0) {
+      return;
+    }
+
+    // Find cluster boundaries
+    std::vector<Cluster> clusters;
+    u32 maxIndex = *std::max_element(indices, indices + totalIndices);
+    std::vector<u32> cacheTimestamps(maxIndex + 1, 0);
+    u32 timestamp = OVERDRAW_CACHE_SIZE + 1;
+
+    for (u32 t = 0; t < totalTriangles; t++) {
+      u32 misses = 0;
+
+      for (u32 i = 0; i < 3; i++) {
+        u32 index = indices[t * 3 + i];
+
+        if (timestamp - cacheTimestamps[index] > OVERDRAW_CACHE_SIZE) {
+          cacheTimestamps[index] = timestamp++;
+          misses++;
+        }
+      }
+
+      if (t == 0 || misses == 3) {
+        clusters.push_back({ t, t + 1, 0.f });
+      } else {
+        clusters.back().end = t + 1;
+      }
+    }
+
+    if (clusters.size() < 2) {
+      return;
+    }
+
+    // Determine the area-weighted centroid and normal of each cluster
+    std::vector<Vec3f> clusterCentroids(clusters.size());
+    std::vector<Vec3f> clusterNormals(clusters.size());
+    Vec3f meshCentroid;
+    float meshArea = 0.f;
+
+    for (u32 c = 0; c < clusters.size(); c++) {
+      Vec3f centroid;
+      Vec3f normal;
+      float area = 0.f;
+
+      for (u32 t = clusters[c].start; t < clusters[c].end; t++) {
+        auto& p1 = vertices[indices[t * 3]].position;
+        auto& p2 = vertices[indices[t * 3 + 1]].position;
+        auto& p3 = vertices[indices[t * 3 + 2]].position;
+        Vec3f cross = Vec3f::cross(p2 - p1, p3 - p1);
+        float triangleArea = cross.magnitude();
+
+        centroid += (p1 + p2 + p3) * (triangleArea / 3.f);
+        normal += cross;
+        area += triangleArea;
+      }
+
+      clusterCentroids[c] = area > 0.f
+        ? centroid / area
+        : vertices[indices[clusters[c].start * 3]].position;
+      clusterNormals[c] = normal;
+      meshCentroid += centroid;
+      meshArea += area;
+    }
+
+    if (meshArea > 0.f) {
+      meshCentroid = meshCentroid / meshArea;
+    }
+
+    for (u32 c = 0; c < clusters.size(); c++) {
+      float normalLength = clusterNormals[c].magnitude();
+
+      clusters[c].sortKey = normalLength > 0.f
+        ? Vec3f::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c] / normalLength)
+        : 0.f;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+      return a.sortKey > b.sortKey;
+    });
+
+    std::vector<u32> output;
+
+    output.reserve(totalTriangles * 3);
+
+    for (auto& cluster : clusters) {
+      output.insert(output.end(), indices + cluster.start * 3, indices + cluster.end * 3);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+  }
+
+  /**
+   * Gm_OptimizeVertexFetch
+   * ----------------------
+   *
+   * Reorders a range of vertices in the order they're first
+   * referenced by an index buffer, for vertex fetch locality,
+   * and remaps the index buffer accordingly. Unreferenced
+   * vertices are moved to the end of the range.
+   */
+  void Gm_OptimizeVertexFetch(Vertex* vertices, u32* indices, u32 totalIndices, u32 vertexOffset, u32 totalVertices) {
+    std::vector<u32> remap(totalVertices, UNUSED_INDEX);
+    std::vector<Vertex> reordered(totalVertices);
+    u32 nextIndex = 0;
+
+    for (u32 i = 0; i < totalIndices; i++) {
+      u32 v = indices[i] - vertexOffset;
+
+      if (remap[v] == UNUSED_INDEX) {
+        remap[v] = nextIndex++;
+      }
+
+      indices[i] = vertexOffset + remap[v];
+    }
+
+    for (u32 v = 0; v < totalVertices; v++) {
+      if (remap[v] == UNUSED_INDEX) {
+        remap[v] = nextIndex++;
+      }
+
+      reordered[remap[v]] = vertices[vertexOffset + v];
+    }
+
+    std::copy(reordered.begin(), reordered.end(), vertices + vertexOffset);
+  }
+
+  /**
+   * Gm_OptimizeMesh
+   * ---------------
+   *
+   * Runs vertex cache, (optionally) overdraw, and vertex fetch
+   * optimization over each LoD of a Mesh, or over the whole
+   * Mesh if it has no LoDs.
+   */
+  MeshOptimizationStats Gm_OptimizeMesh(Mesh* mesh, bool optimizeOverdraw) {
+    MeshOptimizationStats stats;
+    auto& vertices = mesh->vertices;
+    auto& faceElements = mesh->faceElements;
+
+    auto optimizeRange = [&](u32 elementOffset, u32 elementCount, u32 vertexOffset, u32 vertexCount) {
+      u32* indices = faceElements.data() + elementOffset;
+
+      Gm_OptimizeVertexCache(indices, elementCount, vertexOffset, vertexCount);
+
+      if (optimizeOverdraw) {
+        Gm_OptimizeOverdraw(indices, elementCount, vertices.data());
+      }
+
+      Gm_OptimizeVertexFetch(vertices.data(), indices, elementCount, vertexOffset, vertexCount);
+    };
+
+    stats.before = Gm_AnalyzeVertexCache(faceElements.data(), faceElements.size(), vertices.size());
+
+    if (mesh->lods.size() == 0) {
+      optimizeRange(0, faceElements.size(), 0, vertices.size());
+    } else {
+      for (u32 i = 0; i < mesh->lods.size(); i++) {
+        auto& lod = mesh->lods[i];
+
+        // Skip LoDs sharing the previous LoD's geometry
+        if (i > 0 && lod.elementOffset == mesh->lods[i - 1].elementOffset) {
+          continue;
+        }
+
+        optimizeRange(lod.elementOffset, lod.elementCount, lod.vertexOffset, lod.vertexCount);
+      }
+    }
+
+    stats.after = Gm_AnalyzeVertexCache(faceElements.data(), faceElements.size(), vertices.size());
+
+    return stats;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "math/geometry.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  struct Mesh;
+
+  /**
+   * VertexCacheStats
+   * ----------------
+   *
+   * Post-transform vertex cache efficiency of an index buffer,
+   * as simulated with a FIFO cache.
+   */
+  struct VertexCacheStats {
+    /**
+     * Average cache miss ratio: transformed vertices per triangle.
+     * Ranges from 3 (no reuse) down to ~0.5 for regular grids.
+     */
+    float acmr = 0.f;
+    /**
+     * Average transformed vertex ratio: transformed vertices per
+     * unique vertex. 1 is ideal, with each vertex processed once.
+     */
+    float atvr = 0.f;
+  };
+
+  /**
+   * MeshOptimizationStats
+   * ---------------------
+   *
+   * Vertex cache efficiency of a Mesh before and after optimization.
+   */
+  struct MeshOptimizationStats {
+    VertexCacheStats before;
+    VertexCacheStats after;
+  };
+
+  VertexCacheStats Gm_AnalyzeVertexCache(const u32* indices, u32 totalIndices, u32 totalVertices, u32 cacheSize = 16);
+  void Gm_OptimizeVertexCache(u32* indices, u32 totalIndices, u32 vertexOffset, u32 totalVertices);
+  void Gm_OptimizeOverdraw(u32* indices, u32 totalIndices, const Vertex* vertices);
+  void Gm_OptimizeVertexFetch(Vertex* vertices, u32* indices, u32 totalIndices, u32 vertexOffset, u32 totalVertices);
+  MeshOptimizationStats Gm_OptimizeMesh(Mesh* mesh, bool optimizeOverdraw = false);
+}
\ No newline at end of file
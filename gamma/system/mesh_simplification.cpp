@@ -0,0 +1,687 @@
+#include <algorithm>
+#include <math.h>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "math/vector.h"
+#include "system/assert.h"
+#include "system/entities.h"
+#include "system/mesh_simplification.h"
+
+/**
+ * Weight of the quadrics which keep border and seam
+ * vertices on their edges, relative to face quadrics
+ */
+#define BORDER_QUADRIC_WEIGHT 10.f
+/**
+ * Minimum cosine between the normals of a triangle before
+ * and after a collapse, beyond which it is considered flipped
+ */
+#define MIN_COLLAPSE_NORMAL_COSINE 0.25f
+#define UNUSED_INDEX 0xFFFFFFFF
+
+namespace Gamma {
+  /**
+   * Determines which edge collapses a vertex may take part in,
+   * based on its surrounding topology.
+   */
+  enum class VertexKind {
+    // Interior vertices; may collapse freely
+    MANIFOLD,
+    // Vertices on an open mesh border; may only
+    // collapse along the border
+    BORDER,
+    // Vertices split along a UV/normal seam into exactly
+    // two wedges; may only collapse along the seam, with
+    // both wedges collapsing together
+    SEAM,
+    // Vertices at seam/border junctions or on non-manifold
+    // edges; never collapse
+    LOCKED
+  };
+
+  /**
+   * Symmetric matrix A, vector b and constant c of a
+   * quadric error function Q(p) = p'Ap + 2b'p + c.
+   */
+  struct Quadric {
+    double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+  };
+
+  struct EdgeCollapse {
+    u32 from;
+    u32 to;
+    // Second wedges of seam vertices, or UNUSED_INDEX
+    u32 seamFrom;
+    u32 seamTo;
+    float error;
+  };
+
+  inline static u64 Gm_GetEdgeKey(u32 a, u32 b) {
+    return a < b ? (u64(a) << 32) | b : (u64(b) << 32) | a;
+  }
+
+  static void Gm_AddPlaneQuadric(Quadric& q, const Vec3f& normal, float distance, float weight) {
+    q.a00 += weight * normal.x * normal.x;
+    q.a11 += weight * normal.y * normal.y;
+    q.a22 += weight * normal.z * normal.z;
+    q.a01 += weight * normal.x * normal.y;
+    q.a02 += weight * normal.x * normal.z;
+    q.a12 += weight * normal.y * normal.z;
+    q.b0 += weight * normal.x * distance;
+    q.b1 += weight * normal.y * distance;
+    q.b2 += weight * normal.z * distance;
+    q.c += weight * distance * distance;
+  }
+
+  static void Gm_AddQuadric(Quadric& q, const Quadric& r) {
+    q.a00 += r.a00;
+    q.a11 += r.a11;
+    q.a22 += r.a22;
+    q.a01 += r.a01;
+    q.a02 += r.a02;
+    q.a12 += r.a12;
+    q.b0 += r.b0;
+    q.b1 += r.b1;
+    q.b2 += r.b2;
+    q.c += r.c;
+  }
+
+  static float Gm_GetQuadricError(const Quadric& q, const Vec3f& p) {
+    double rx = q.a00 * p.x + q.a01 * p.y + q.a02 * p.z;
+    double ry = q.a01 * p.x + q.a11 * p.y + q.a12 * p.z;
+    double rz = q.a02 * p.x + q.a12 * p.y + q.a22 * p.z;
+    double error = p.x * rx + p.y * ry + p.z * rz + 2.0 * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z) + q.c;
+
+    return (float)fabs(error);
+  }
+
+  /**
+   * Maps vertices sharing a position to one representative vertex,
+   * and links them into rings of 'wedges' around the position.
+   */
+  static void Gm_LinkWedges(const Vertex* vertices, u32 totalVertices, std::vector<u32>& positionRemap, std::vector<u32>& wedges) {
+    std::vector<u32> order(totalVertices);
+
+    positionRemap.resize(totalVertices);
+    wedges.resize(totalVertices);
+
+    std::iota(order.begin(), order.end(), 0);
+
+    std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+      auto& pa = vertices[a].position;
+      auto& pb = vertices[b].position;
+
+      return pa.x != pb.x ? pa.x < pb.x : pa.y != pb.y ? pa.y < pb.y : pa.z < pb.z;
+    });
+
+    for (u32 start = 0, end = 0; start < totalVertices; start = end) {
+      end = start + 1;
+
+      while (end < totalVertices && vertices[order[end]].position == vertices[order[start]].position) {
+        end++;
+      }
+
+      for (u32 i = start; i < end; i++) {
+        positionRemap[order[i]] = order[start];
+        wedges[order[i]] = order[i + 1 < end ? i + 1 : start];
+      }
+    }
+  }
+
+  /**
+   * Removes the back faces of double-sided surfaces, i.e. triangles
+   * covering the same positions as an earlier triangle, recording
+   * the back face vertex corresponding to each front face vertex.
+   * Simplifying only the front faces avoids treating double-sided
+   * surfaces as non-manifold, and keeps both sides identical.
+   */
+  static void Gm_RemoveBackFaces(const std::vector<u32>& positionRemap, std::vector<u32>& indices, std::vector<u32>& backVertices) {
+    std::unordered_map<u64, u32> frontFaces;
+    u32 totalWritten = 0;
+
+    backVertices.assign(positionRemap.size(), UNUSED_INDEX);
+
+    for (u32 i = 0; i < indices.size(); i += 3) {
+      u32 p[3] = {
+        positionRemap[indices[i]],
+        positionRemap[indices[i + 1]],
+        positionRemap[indices[i + 2]]
+      };
+
+      std::sort(p, p + 3);
+
+      // Hash the sorted positions into a single key; collisions
+      // are ruled out by comparing the candidate front face below
+      u64 key = (u64(p[0]) * 73856093) ^ (u64(p[1]) * 19349663) ^ (u64(p[2]) * 83492791);
+      auto entry = frontFaces.find(key);
+
+      if (entry != frontFaces.end()) {
+        u32* front = &indices[entry->second];
+        u32 matches = 0;
+
+        for (u32 j = 0; j < 3; j++) {
+          for (u32 k = 0; k < 3; k++) {
+            if (positionRemap[front[j]] == positionRemap[indices[i + k]]) {
+              matches++;
+
+              break;
+            }
+          }
+        }
+
+        if (matches == 3) {
+          for (u32 j = 0; j < 3; j++) {
+            for (u32 k = 0; k < 3; k++) {
+              if (positionRemap[front[j]] == positionRemap[indices[i + k]]) {
+                backVertices[front[j]] = indices[i + k];
+              }
+            }
+          }
+
+          continue;
+        }
+      } else {
+        frontFaces[key] = totalWritten;
+      }
+
+      indices[totalWritten++] = indices[i];
+      indices[totalWritten++] = indices[i + 1];
+      indices[totalWritten++] = indices[i + 2];
+    }
+
+    indices.resize(totalWritten);
+  }
+
+  /**
+   * Restores back faces for simplified front faces whose
+   * vertices all have back face counterparts, wound to
+   * match the back face vertex normals.
+   */
+  static void Gm_RestoreBackFaces(const Vertex* vertices, const std::vector<u32>& backVertices, std::vector<u32>& indices) {
+    u32 totalFrontIndices = indices.size();
+
+    for (u32 i = 0; i < totalFrontIndices; i += 3) {
+      u32 a = backVertices[indices[i]];
+      u32 b = backVertices[indices[i + 1]];
+      u32 c = backVertices[indices[i + 2]];
+
+      if (a == UNUSED_INDEX || b == UNUSED_INDEX || c == UNUSED_INDEX) {
+        continue;
+      }
+
+      auto& p1 = vertices[a].position;
+      auto& p2 = vertices[b].position;
+      auto& p3 = vertices[c].position;
+      Vec3f normal = Vec3f::cross(p2 - p1, p3 - p1);
+      Vec3f vertexNormal = vertices[a].normal + vertices[b].normal + vertices[c].normal;
+
+      indices.push_back(a);
+
+      if (Vec3f::dot(normal, vertexNormal) >= 0.f) {
+        indices.push_back(b);
+        indices.push_back(c);
+      } else {
+        indices.push_back(c);
+        indices.push_back(b);
+      }
+    }
+  }
+
+  /**
+   * Gm_SimplifyMesh
+   * ---------------
+   *
+   * Reduces the triangles of an index buffer towards a target count
+   * using Garland-Heckbert quadric error metrics. Edges are collapsed
+   * onto existing vertices, in order of increasing error, so vertex
+   * attributes remain exact. Vertices on open borders and UV/normal
+   * seams are constrained to collapse along them, which keeps textures
+   * and shading continuous across the simplified mesh.
+   *
+   * @todo error limits; currently collapses until the target is met,
+   * or until no collapses remain which preserve the mesh topology
+   */
+  void Gm_SimplifyMesh(const Vertex* vertices, u32 totalVertices, std::vector<u32>& indices, u32 targetIndexCount) {
+    std::vector<u32> positionRemap;
+    std::vector<u32> wedges;
+    std::vector<u32> backVertices;
+    u32 totalSourceIndices = indices.size();
+
+    Gm_LinkWedges(vertices, totalVertices, positionRemap, wedges);
+    Gm_RemoveBackFaces(positionRemap, indices, backVertices);
+
+    // Scale the target to the remaining front faces
+    targetIndexCount = u32(u64(targetIndexCount) * indices.size() / std::max(totalSourceIndices, 1u)) / 3 * 3;
+
+    // Count edges between vertices, and between
+    // positions, to identify borders and seams
+    std::unordered_map<u64, u32> edgeCounts;
+    std::unordered_map<u64, u32> positionEdgeCounts;
+
+    for (u32 i = 0; i < indices.size(); i += 3) {
+      for (u32 e = 0; e < 3; e++) {
+        u32 a = indices[i + e];
+        u32 b = indices[i + (e + 1) % 3];
+
+        edgeCounts[Gm_GetEdgeKey(a, b)]++;
+        positionEdgeCounts[Gm_GetEdgeKey(positionRemap[a], positionRemap[b])]++;
+      }
+    }
+
+    std::vector<u32> openEdges(totalVertices, 0);
+    std::vector<u32> borderEdges(totalVertices, 0);
+    std::vector<u32> openNeighbors(totalVertices * 2);
+    std::vector<bool> isNonManifold(totalVertices, false);
+
+    for (auto& [ key, count ] : edgeCounts) {
+      u32 a = u32(key >> 32);
+      u32 b = u32(key & 0xFFFFFFFF);
+
+      if (count == 1) {
+        if (openEdges[a] < 2) openNeighbors[a * 2 + openEdges[a]] = b;
+        if (openEdges[b] < 2) openNeighbors[b * 2 + openEdges[b]] = a;
+
+        openEdges[a]++;
+        openEdges[b]++;
+
+        if (positionEdgeCounts[Gm_GetEdgeKey(positionRemap[a], positionRemap[b])] == 1) {
+          borderEdges[a]++;
+          borderEdges[b]++;
+        }
+      } else if (count > 2) {
+        isNonManifold[a] = true;
+        isNonManifold[b] = true;
+      }
+    }
+
+    for (auto& [ key, count ] : positionEdgeCounts) {
+      if (count > 2) {
+        isNonManifold[u32(key >> 32)] = true;
+        isNonManifold[u32(key & 0xFFFFFFFF)] = true;
+      }
+    }
+
+    // Classify vertices
+    std::vector<VertexKind> kinds(totalVertices);
+    std::vector<u32> seamTwins(totalVertices, UNUSED_INDEX);
+
+    auto isSeamTwin = [&](u32 v, u32 w) {
+      u32 a1 = positionRemap[openNeighbors[v * 2]];
+      u32 a2 = positionRemap[openNeighbors[v * 2 + 1]];
+      u32 b1 = positionRemap[openNeighbors[w * 2]];
+      u32 b2 = positionRemap[openNeighbors[w * 2 + 1]];
+
+      return openEdges[w] == 2 && borderEdges[w] == 0 && ((a1 == b1 && a2 == b2) || (a1 == b2 && a2 == b1));
+    };
+
+    for (u32 v = 0; v < totalVertices; v++) {
+      if (isNonManifold[v] || isNonManifold[positionRemap[v]]) {
+        kinds[v] = VertexKind::LOCKED;
+      } else if (openEdges[v] == 0) {
+        kinds[v] = VertexKind::MANIFOLD;
+      } else if (openEdges[v] == 2 && borderEdges[v] == 2) {
+        // Any other wedges belong to separate surfaces
+        // merely touching this one, and can be ignored
+        kinds[v] = VertexKind::BORDER;
+      } else if (openEdges[v] == 2 && borderEdges[v] == 0) {
+        // Seam vertices must have exactly one opposite wedge,
+        // and no other wedges joined to them by a seam
+        u32 totalTwins = 0;
+        u32 totalJoined = 0;
+
+        for (u32 w = wedges[v]; w != v; w = wedges[w]) {
+          if (isSeamTwin(v, w)) {
+            seamTwins[v] = w;
+            totalTwins++;
+          } else if (openEdges[w] > 0) {
+            totalJoined++;
+          }
+        }
+
+        kinds[v] = totalTwins == 1 && totalJoined == 0 ? VertexKind::SEAM : VertexKind::LOCKED;
+      } else {
+        kinds[v] = VertexKind::LOCKED;
+      }
+    }
+
+    // Seam wedges may only move together
+    for (u32 v = 0; v < totalVertices; v++) {
+      if (kinds[v] == VertexKind::SEAM && kinds[seamTwins[v]] != VertexKind::SEAM) {
+        kinds[v] = VertexKind::LOCKED;
+      }
+    }
+
+    // Accumulate quadrics for each position, from the planes of
+    // its triangles and planes perpendicular to its open edges
+    std::vector<Quadric> quadrics(totalVertices);
+
+    for (u32 i = 0; i < indices.size(); i += 3) {
+      auto& p1 = vertices[indices[i]].position;
+      auto& p2 = vertices[indices[i + 1]].position;
+      auto& p3 = vertices[indices[i + 2]].position;
+      Vec3f normal = Vec3f::cross(p2 - p1, p3 - p1);
+      float area = normal.magnitude();
+
+      if (area == 0.f) {
+        continue;
+      }
+
+      normal /= area;
+
+      float distance = -Vec3f::dot(normal, p1);
+
+      for (u32 e = 0; e < 3; e++) {
+        u32 a = indices[i + e];
+        u32 b = indices[i + (e + 1) % 3];
+
+        Gm_AddPlaneQuadric(quadrics[positionRemap[a]], normal, distance, area);
+
+        if (edgeCounts[Gm_GetEdgeKey(a, b)] == 1) {
+          auto& pa = vertices[a].position;
+          Vec3f edge = vertices[b].position - pa;
+          Vec3f edgeNormal = Vec3f::cross(edge, normal);
+          float edgeNormalLength = edgeNormal.magnitude();
+
+          if (edgeNormalLength > 0.f) {
+            edgeNormal /= edgeNormalLength;
+
+            float edgeDistance = -Vec3f::dot(edgeNormal, pa);
+            float weight = Vec3f::dot(edge, edge) * BORDER_QUADRIC_WEIGHT;
+
+            Gm_AddPlaneQuadric(quadrics[positionRemap[a]], edgeNormal, edgeDistance, weight);
+            Gm_AddPlaneQuadric(quadrics[positionRemap[b]], edgeNormal, edgeDistance, weight);
+          }
+        }
+      }
+    }
+
+    // Collapse edges in passes, selecting the lowest-error
+    // collapses with non-overlapping neighborhoods each time
+    std::vector<u32> collapseRemap(totalVertices);
+    std::vector<bool> isCollapseLocked(totalVertices);
+    std::vector<u32> adjacencyOffsets(totalVertices + 1);
+    std::vector<u32> adjacency;
+    std::vector<EdgeCollapse> collapses;
+    u32 totalIndicesRemaining = indices.size();
+
+    auto isOpenEdge = [&](u32 a, u32 b) {
+      auto entry = edgeCounts.find(Gm_GetEdgeKey(a, b));
+
+      return entry != edgeCounts.end() && entry->second == 1;
+    };
+
+    auto addCollapse = [&](u32 from, u32 to) {
+      EdgeCollapse collapse = { from, to, UNUSED_INDEX, UNUSED_INDEX, 0.f };
+
+      switch (kinds[from]) {
+        case VertexKind::MANIFOLD:
+          break;
+        case VertexKind::BORDER:
+          if (kinds[to] == VertexKind::MANIFOLD || !isOpenEdge(from, to)) {
+            return;
+          }
+
+          break;
+        case VertexKind::SEAM:
+          if (
+            (kinds[to] != VertexKind::SEAM && kinds[to] != VertexKind::LOCKED) ||
+            !isOpenEdge(from, to)
+          ) {
+            return;
+          }
+
+          // Find the matching edge on the opposite side of the seam
+          collapse.seamFrom = seamTwins[from];
+
+          for (u32 w = wedges[to]; ; w = wedges[w]) {
+            if (w != to && isOpenEdge(collapse.seamFrom, w)) {
+              collapse.seamTo = w;
+
+              break;
+            }
+
+            if (w == to) {
+              return;
+            }
+          }
+
+          break;
+        default:
+          return;
+      }
+
+      collapse.error = Gm_GetQuadricError(quadrics[positionRemap[from]], vertices[to].position);
+
+      collapses.push_back(collapse);
+    };
+
+    while (totalIndicesRemaining > targetIndexCount) {
+      // Refresh edge counts and position -> triangle adjacency
+      edgeCounts.clear();
+      std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+
+      for (u32 i = 0; i < totalIndicesRemaining; i++) {
+        edgeCounts[Gm_GetEdgeKey(indices[i], indices[i - i % 3 + (i + 1) % 3])]++;
+        adjacencyOffsets[positionRemap[indices[i]] + 1]++;
+      }
+
+      std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+
+      adjacency.resize(totalIndicesRemaining);
+
+      {
+        std::vector<u32> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+        for (u32 i = 0; i < totalIndicesRemaining; i++) {
+          adjacency[cursors[positionRemap[indices[i]]]++] = i / 3;
+        }
+      }
+
+      // Gather and sort candidate collapses
+      collapses.clear();
+
+      for (u32 i = 0; i < totalIndicesRemaining; i++) {
+        u32 a = indices[i];
+        u32 b = indices[i - i % 3 + (i + 1) % 3];
+
+        addCollapse(a, b);
+        addCollapse(b, a);
+      }
+
+      std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& a, const EdgeCollapse& b) {
+        return a.error < b.error;
+      });
+
+      // Select collapses
+      u32 trianglesToRemove = (totalIndicesRemaining - targetIndexCount + 2) / 3;
+      u32 totalRemoved = 0;
+      u32 totalCollapses = 0;
+
+      std::iota(collapseRemap.begin(), collapseRemap.end(), 0);
+      std::fill(isCollapseLocked.begin(), isCollapseLocked.end(), false);
+
+      for (auto& collapse : collapses) {
+        if (totalRemoved >= trianglesToRemove) {
+          break;
+        }
+
+        u32 fromPosition = positionRemap[collapse.from];
+        u32 toPosition = positionRemap[collapse.to];
+
+        if (isCollapseLocked[fromPosition] || isCollapseLocked[toPosition]) {
+          continue;
+        }
+
+        auto isMoving = [&](u32 v) {
+          return v == collapse.from || v == collapse.seamFrom;
+        };
+
+        auto isTarget = [&](u32 v) {
+          return v == collapse.to || v == collapse.seamTo;
+        };
+
+        // Reject collapses which would flip triangles
+        const Vec3f& target = vertices[collapse.to].position;
+        u32 removed = 0;
+        bool isFlipping = false;
+
+        for (u32 j = adjacencyOffsets[fromPosition]; j < adjacencyOffsets[fromPosition + 1]; j++) {
+          u32* triangle = &indices[adjacency[j] * 3];
+
+          if (!isMoving(triangle[0]) && !isMoving(triangle[1]) && !isMoving(triangle[2])) {
+            continue;
+          }
+
+          if (isTarget(triangle[0]) || isTarget(triangle[1]) || isTarget(triangle[2])) {
+            removed++;
+
+            continue;
+          }
+
+          Vec3f p[3];
+
+          for (u32 k = 0; k < 3; k++) {
+            p[k] = isMoving(triangle[k]) ? target : vertices[triangle[k]].position;
+          }
+
+          auto& p1 = vertices[triangle[0]].position;
+          auto& p2 = vertices[triangle[1]].position;
+          auto& p3 = vertices[triangle[2]].position;
+          Vec3f before = Vec3f::cross(p2 - p1, p3 - p1);
+          Vec3f after = Vec3f::cross(p[1] - p[0], p[2] - p[0]);
+
+          if (Vec3f::dot(before, after) <= MIN_COLLAPSE_NORMAL_COSINE * before.magnitude() * after.magnitude()) {
+            isFlipping = true;
+
+            break;
+          }
+        }
+
+        if (isFlipping) {
+          continue;
+        }
+
+        // Lock the collapse neighborhood for the rest of the pass
+        for (u32 j = adjacencyOffsets[fromPosition]; j < adjacencyOffsets[fromPosition + 1]; j++) {
+          u32* triangle = &indices[adjacency[j] * 3];
+
+          isCollapseLocked[positionRemap[triangle[0]]] = true;
+          isCollapseLocked[positionRemap[triangle[1]]] = true;
+          isCollapseLocked[positionRemap[triangle[2]]] = true;
+        }
+
+        collapseRemap[collapse.from] = collapse.to;
+
+        if (collapse.seamFrom != UNUSED_INDEX) {
+          collapseRemap[collapse.seamFrom] = collapse.seamTo;
+        }
+
+        Gm_AddQuadric(quadrics[toPosition], quadrics[fromPosition]);
+
+        totalRemoved += removed;
+        totalCollapses++;
+      }
+
+      if (totalCollapses == 0) {
+        break;
+      }
+
+      // Apply collapses, discarding degenerate triangles
+      u32 totalWritten = 0;
+
+      for (u32 i = 0; i < totalIndicesRemaining; i += 3) {
+        u32 a = collapseRemap[indices[i]];
+        u32 b = collapseRemap[indices[i + 1]];
+        u32 c = collapseRemap[indices[i + 2]];
+        u32 pa = positionRemap[a];
+        u32 pb = positionRemap[b];
+        u32 pc = positionRemap[c];
+
+        if (pa != pb && pb != pc && pc != pa) {
+          indices[totalWritten++] = a;
+          indices[totalWritten++] = b;
+          indices[totalWritten++] = c;
+        }
+      }
+
+      totalIndicesRemaining = totalWritten;
+    }
+
+    indices.resize(totalIndicesRemaining);
+
+    Gm_RestoreBackFaces(vertices, backVertices, indices);
+  }
+
+  /**
+   * Gm_GenerateLods
+   * ---------------
+   *
+   * Generates lower levels of detail for a single-LoD Mesh by
+   * simplifying it to each of the provided triangle ratios. The
+   * existing geometry becomes the first LoD, and each generated
+   * LoD is appended with its own range of vertices.
+   */
+  void Gm_GenerateLods(Mesh* mesh, const std::vector<float>& triangleRatios) {
+    assert(mesh->lods.size() == 0, "Gm_GenerateLods: Mesh already has LoDs");
+    assert(triangleRatios.size() < MAX_LOD_LEVELS, "Gm_GenerateLods: Too many LoD levels: " + std::to_string(triangleRatios.size() + 1));
+
+    auto& vertices = mesh->vertices;
+    auto& faceElements = mesh->faceElements;
+    u32 totalSourceVertices = vertices.size();
+    u32 totalSourceElements = faceElements.size();
+    std::vector<u32> lodElements;
+    std::vector<u32> remap(totalSourceVertices);
+
+    mesh->lods.resize(triangleRatios.size() + 1);
+
+    mesh->lods[0].elementOffset = 0;
+    mesh->lods[0].elementCount = totalSourceElements;
+    mesh->lods[0].vertexOffset = 0;
+    mesh->lods[0].vertexCount = totalSourceVertices;
+
+    for (u32 i = 0; i < triangleRatios.size(); i++) {
+      auto& lod = mesh->lods[i + 1];
+      u32 targetElements = u32(float(totalSourceElements / 3) * triangleRatios[i]) * 3;
+
+      lodElements.assign(faceElements.begin(), faceElements.begin() + totalSourceElements);
+
+      Gm_SimplifyMesh(vertices.data(), totalSourceVertices, lodElements, targetElements);
+
+      if (lodElements.size() >= mesh->lods[i].elementCount) {
+        // Simplification stalled; share the previous LoD's geometry
+        lod.elementOffset = mesh->lods[i].elementOffset;
+        lod.elementCount = mesh->lods[i].elementCount;
+        lod.vertexOffset = mesh->lods[i].vertexOffset;
+        lod.vertexCount = mesh->lods[i].vertexCount;
+
+        continue;
+      }
+
+      // Copy the vertices referenced by the
+      // simplified indexes into the LoD's range
+      lod.elementOffset = faceElements.size();
+      lod.vertexOffset = vertices.size();
+
+      std::fill(remap.begin(), remap.end(), UNUSED_INDEX);
+
+      for (u32 j = 0; j < lodElements.size(); j++) {
+        u32 v = lodElements[j];
+
+        if (remap[v] == UNUSED_INDEX) {
+          remap[v] = vertices.size();
+
+          vertices.push_back(vertices[v]);
+        }
+
+        faceElements.push_back(remap[v]);
+      }
+
+      lod.elementCount = faceElements.size() - lod.elementOffset;
+      lod.vertexCount = vertices.size() - lod.vertexOffset;
+    }
+  }
+}
\ No newline at end of file
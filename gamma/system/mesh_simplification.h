@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+#include "math/geometry.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  struct Mesh;
+
+  void Gm_SimplifyMesh(const Vertex* vertices, u32 totalVertices, std::vector<u32>& indices, u32 targetIndexCount);
+  void Gm_GenerateLods(Mesh* mesh, const std::vector<float>& triangleRatios);
+}
\ No newline at end of file
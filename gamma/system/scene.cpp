@@ -1,5 +1,14 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <math.h>
+#include <mutex>
+#include <thread>
 
+#include "math/constants.h"
+#include "performance/benchmark.h"
 #include "system/scene.h"
 #include "system/assert.h"
 #include "system/console.h"
@@ -8,8 +17,73 @@
 #include "system/vector_helpers.h"
 #include "system/yaml_parser.h"
 
+#define TRANSFORM_BATCH_SIZE 8192
+
 using namespace Gamma;
 
+struct TransformBatch {
+  ObjectPool* objects = nullptr;
+  u32 start = 0;
+  u32 end = 0;
+};
+
+/**
+ * Large numbers of dirty transforms (e.g. on level load or
+ * mass edits) are split into batches, which are computed by
+ * persistent worker threads alongside the main thread. Each
+ * dispatch wakes every worker, and waits for all of them to
+ * finish before returning.
+ */
+static std::vector<std::thread> transformWorkers;
+static std::vector<TransformBatch> transformBatches;
+static std::atomic<u32> nextTransformBatch = 0;
+static std::mutex transformMutex;
+static std::condition_variable transformCondition;
+static std::condition_variable transformDoneCondition;
+static u32 transformDispatch = 0;
+static u32 totalFinishedTransformWorkers = 0;
+static bool isTransformingStopped = false;
+
+static void Gm_ComputeTransformBatches() {
+  u32 index;
+
+  while ((index = nextTransformBatch++) < transformBatches.size()) {
+    auto& batch = transformBatches[index];
+
+    batch.objects->computeDirtyTransforms(batch.start, batch.end);
+  }
+}
+
+static void Gm_RunTransformWorker() {
+  u32 dispatch = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(transformMutex);
+
+      transformCondition.wait(lock, [&]() {
+        return isTransformingStopped || transformDispatch != dispatch;
+      });
+
+      if (isTransformingStopped) {
+        return;
+      }
+
+      dispatch = transformDispatch;
+    }
+
+    Gm_ComputeTransformBatches();
+
+    {
+      std::lock_guard<std::mutex> lock(transformMutex);
+
+      totalFinishedTransformWorkers++;
+    }
+
+    transformDoneCondition.notify_one();
+  }
+}
+
 const GmSceneStats Gm_GetSceneStats(GmContext* context) {
   GmSceneStats stats;
 
@@ -32,7 +106,7 @@ const GmSceneStats Gm_GetSceneStats(GmContext* context) {
   return stats;
 }
 
-void Gm_AddMesh(GmContext* context, const std::string& meshName, u16 maxInstances, Gamma::Mesh* mesh) {
+void Gm_AddMesh(GmContext* context, const std::string& meshName, u32 maxInstances, Gamma::Mesh* mesh) {
   auto& scene = context->scene;
   auto& meshes = scene.meshes;
   auto& meshMap = scene.meshMap;
@@ -41,20 +115,288 @@ void Gm_AddMesh(GmContext* context, const std::string& meshName, u16 maxInstance
 
   mesh->index = (u16)meshes.size();
   mesh->id = scene.runningMeshId++;
-  mesh->objects.reserve(maxInstances);
+  // Pools grow on demand, so maxInstances only serves as
+  // a hard cap on their size, if the caller asks for one.
+  // Otherwise pools keep the 24-bit ID range as their cap.
+  if (maxInstances > 0) {
+    mesh->objects.setMax(maxInstances);
+  }
 
   meshMap.emplace(meshName, mesh);
   meshes.push_back(mesh);
 
   if (mesh->type == MeshType::PARTICLE_SYSTEM) {
-    for (u16 i = 0; i < maxInstances; i++) {
-      Gm_CreateObjectFrom(context, meshName);
-    }
+    Gm_CreateObjects(context, meshName, maxInstances);
   }
 
   context->renderer->createMesh(mesh);
 }
 
+/**
+ * Creates meshes concurrently across a pool of worker threads,
+ * then adds them to the scene in request order on the current
+ * thread, so mesh indexes/IDs are the same as if they had been
+ * added one by one, and GPU resources are created on the thread
+ * owning the graphics context.
+ */
+void Gm_AddMeshes(GmContext* context, const std::vector<GmMeshRequest>& requests) {
+  struct MeshLoadTiming {
+    u64 start = 0;
+    u64 end = 0;
+    u32 thread = 0;
+  };
+
+  u32 totalRequests = requests.size();
+  u32 totalThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), totalRequests);
+  std::vector<Mesh*> meshes(totalRequests, nullptr);
+  std::vector<MeshLoadTiming> timings(totalRequests);
+  std::vector<std::thread> workers;
+  std::atomic<u32> nextRequest = 0;
+  u64 loadStart = Gm_GetMicroseconds();
+
+  // Each thread takes the next unclaimed request until none
+  // remain, balancing slow model loads against fast ones
+  auto loadMeshes = [&](u32 thread) {
+    u32 i;
+
+    while ((i = nextRequest++) < totalRequests) {
+      auto& timing = timings[i];
+
+      timing.thread = thread;
+      timing.start = Gm_GetMicroseconds();
+
+      if (requests[i].isStreamed) {
+        // Streamed meshes are added empty, and
+        // loaded once they are first retained
+        meshes[i] = new Mesh();
+        meshes[i]->isResident = false;
+      } else {
+        meshes[i] = requests[i].createMesh();
+      }
+
+      timing.end = Gm_GetMicroseconds();
+    }
+  };
+
+  for (u32 thread = 1; thread < totalThreads; thread++) {
+    workers.push_back(std::thread(loadMeshes, thread));
+  }
+
+  loadMeshes(0);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  u64 uploadStart = Gm_GetMicroseconds();
+
+  for (u32 i = 0; i < totalRequests; i++) {
+    Gm_AddMesh(context, requests[i].meshName, requests[i].maxInstances, meshes[i]);
+
+    if (requests[i].isStreamed) {
+      context->scene.streamedMeshes[meshes[i]->index].createMesh = requests[i].createMesh;
+    }
+  }
+
+  #if GAMMA_DEVELOPER_MODE
+    u64 loadEnd = Gm_GetMicroseconds();
+    u64 totalSerialTime = 0;
+
+    for (u32 i = 0; i < totalRequests; i++) {
+      auto& timing = timings[i];
+
+      totalSerialTime += timing.end - timing.start;
+
+      Console::log(
+        "[Gamma] Loaded mesh", "'" + requests[i].meshName + "'",
+        "| thread", timing.thread,
+        "|", (timing.start - loadStart) / 1000, "ms ->", (timing.end - loadStart) / 1000, "ms",
+        "(" + std::to_string((timing.end - timing.start) / 1000) + "ms)"
+      );
+    }
+
+    Console::log(
+      "[Gamma] Loaded", totalRequests, "meshes on", totalThreads, "threads in", (uploadStart - loadStart) / 1000, "ms",
+      "(" + std::to_string(totalSerialTime / 1000) + "ms serial)",
+      "| Uploaded in", (loadEnd - uploadStart) / 1000, "ms"
+    );
+  #endif
+}
+
+/**
+ * Moves the geometry of a newly-loaded mesh into its
+ * scene mesh, leaving its objects and configuration
+ * (textures, type, etc.) untouched.
+ */
+static void Gm_ApplyLoadedMesh(Mesh* mesh, Mesh* loadedMesh) {
+  mesh->vertices = std::move(loadedMesh->vertices);
+  mesh->faceElements = std::move(loadedMesh->faceElements);
+  mesh->lods = std::move(loadedMesh->lods);
+  mesh->useQuantizedVertices = loadedMesh->useQuantizedVertices;
+  mesh->minimumBounds = loadedMesh->minimumBounds;
+  mesh->maximumBounds = loadedMesh->maximumBounds;
+  mesh->boundingRadius = loadedMesh->boundingRadius;
+
+  // Objects created while the mesh was unloaded
+  // haven't been counted towards its LoDs
+  if (mesh->lods.size() > 0) {
+    mesh->lods[0].instanceCount = mesh->objects.totalActive();
+  }
+
+  mesh->isResident = true;
+
+  delete loadedMesh;
+}
+
+/**
+ * Frees a streamed mesh's geometry. Its GPU resources
+ * are freed by the renderer once it sees the mesh is
+ * no longer resident.
+ */
+static void Gm_UnloadMesh(Mesh* mesh) {
+  std::vector<Vertex>().swap(mesh->vertices);
+  std::vector<Vertex>().swap(mesh->transformedVertices);
+  std::vector<u32>().swap(mesh->faceElements);
+  std::vector<MeshLod>().swap(mesh->lods);
+
+  mesh->isResident = false;
+}
+
+/**
+ * Marks a streamed mesh as in use, loading it in the
+ * background if it isn't already resident or loading.
+ * Has no effect on meshes which aren't streamed.
+ */
+void Gm_RetainMesh(GmContext* context, Gamma::MeshHandle handle) {
+  auto& scene = context->scene;
+  auto entry = scene.streamedMeshes.find(handle.index);
+
+  if (entry == scene.streamedMeshes.end()) {
+    return;
+  }
+
+  auto& streamedMesh = entry->second;
+
+  streamedMesh.references++;
+
+  if (!scene.meshes[handle.index]->isResident && !streamedMesh.pendingMesh.valid()) {
+    streamedMesh.pendingMesh = std::async(std::launch::async, streamedMesh.createMesh);
+  }
+}
+
+/**
+ * Releases a retained streamed mesh. Once it has no
+ * remaining users, it is unloaded after gracePeriod
+ * seconds, unless retained again before then.
+ */
+void Gm_ReleaseMesh(GmContext* context, Gamma::MeshHandle handle, float gracePeriod) {
+  auto& scene = context->scene;
+  auto entry = scene.streamedMeshes.find(handle.index);
+
+  if (entry == scene.streamedMeshes.end()) {
+    return;
+  }
+
+  auto& streamedMesh = entry->second;
+
+  assert(streamedMesh.references > 0, "Released mesh was not retained");
+
+  if (--streamedMesh.references == 0) {
+    streamedMesh.unloadTime = scene.runningTime + gracePeriod;
+  }
+}
+
+/**
+ * Adds streamed meshes which have finished loading to the
+ * scene, and unloads unused ones past their grace period.
+ */
+void Gm_UpdateStreamedMeshes(GmContext* context) {
+  using namespace std::chrono_literals;
+
+  auto& scene = context->scene;
+
+  for (auto& [ index, streamedMesh ] : scene.streamedMeshes) {
+    auto* mesh = scene.meshes[index];
+
+    if (streamedMesh.pendingMesh.valid()) {
+      if (streamedMesh.pendingMesh.wait_for(0s) == std::future_status::ready) {
+        Gm_ApplyLoadedMesh(mesh, streamedMesh.pendingMesh.get());
+
+        #if GAMMA_DEVELOPER_MODE
+          Console::log("[Gamma] Streamed in mesh", index, "|", mesh->vertices.size(), "vertices");
+        #endif
+      }
+    } else if (
+      mesh->isResident &&
+      streamedMesh.references == 0 &&
+      scene.runningTime >= streamedMesh.unloadTime
+    ) {
+      Gm_UnloadMesh(mesh);
+
+      #if GAMMA_DEVELOPER_MODE
+        Console::log("[Gamma] Streamed out mesh", index);
+      #endif
+    }
+  }
+}
+
+/**
+ * Blocks until all streamed meshes being loaded have
+ * finished, e.g. so that the meshes around the starting
+ * position are present on the first frame.
+ */
+void Gm_WaitForStreamedMeshes(GmContext* context) {
+  for (auto& [ index, streamedMesh ] : context->scene.streamedMeshes) {
+    if (streamedMesh.pendingMesh.valid()) {
+      streamedMesh.pendingMesh.wait();
+    }
+  }
+
+  Gm_UpdateStreamedMeshes(context);
+}
+
+/**
+ * Replaces the geometry of a mesh in the scene with that of
+ * another mesh, e.g. one rebuilt from changed source data,
+ * leaving its objects in place. The other mesh is freed,
+ * and the renderer re-buffers the new geometry before
+ * the next frame.
+ */
+void Gm_ReplaceMeshGeometry(GmContext* context, const std::string& meshName, Gamma::Mesh* geometry) {
+  auto* mesh = Gm_GetMesh(context, meshName);
+
+  Gm_ApplyLoadedMesh(mesh, geometry);
+
+  mesh->geometryVersion++;
+}
+
+/**
+ * Groups meshes whose objects stay in place into a static
+ * batch, which the renderer draws with one multi-draw per
+ * pass once all of the meshes are resident. Each mesh can
+ * only belong to one batch.
+ */
+void Gm_AddStaticBatch(GmContext* context, const std::string& batchName, const std::vector<std::string>& meshNames) {
+  auto& staticBatches = context->scene.staticBatches;
+  auto* batch = new StaticBatch();
+
+  batch->name = batchName;
+
+  for (auto& meshName : meshNames) {
+    auto* mesh = Gm_GetMesh(context, meshName);
+
+    for (auto* staticBatch : staticBatches) {
+      assert(!Gm_VectorContains(staticBatch->meshes, (const Mesh*)mesh), "Mesh '" + meshName + "' already belongs to static batch '" + staticBatch->name + "'");
+    }
+
+    batch->meshes.push_back(mesh);
+  }
+
+  staticBatches.push_back(batch);
+
+  context->renderer->createStaticBatch(batch);
+}
+
 void Gm_AddProbe(GmContext* context, const std::string& probeName, const Gamma::Vec3f& position) {
   context->scene.probeMap.emplace(probeName, position);
 }
@@ -167,68 +509,270 @@ Gamma::Object& Gm_CreateObjectFrom(GmContext* context, const std::string& meshNa
   return object;
 }
 
+Gamma::ObjectSpan Gm_CreateObjects(GmContext* context, const std::string& meshName, u32 count) {
+  auto& meshMap = context->scene.meshMap;
+
+  assert(meshMap.find(meshName) != meshMap.end(), "Mesh '" + meshName + "' not found");
+
+  auto& mesh = *meshMap.at(meshName);
+  auto span = mesh.objects.createObjects(count);
+
+  for (auto& object : span) {
+    object._record.meshId = mesh.id;
+    object._record.meshIndex = mesh.index;
+    object.position = Vec3f(0.0f);
+    object.rotation = Vec3f(0.0f);
+    object.scale = Vec3f(1.0f);
+  }
+
+  if (mesh.lods.size() > 0) {
+    // See Gm_CreateObjectFrom()
+    mesh.lods[0].instanceCount += count;
+  }
+
+  return span;
+}
+
 void Gm_Commit(GmContext* context, const Gamma::Object& object) {
   auto& meshes = context->scene.meshes;
   auto& record = object._record;
   auto* mesh = meshes[record.meshIndex];
 
-  // @todo (?) dispatch transform commands to separate buckets for multithreading
-  mesh->objects.transformById(record.id, Matrix4f::transformation(
-    object.position,
-    object.scale,
-    object.rotation
-  ).transpose());
-
+  // Matrices are computed in Gm_UpdateTransforms()
+  mesh->objects.setTransformById(record.id, object.position, object.scale, object.rotation);
   mesh->objects.setColorById(record.id, object.color);
 }
 
+void Gm_CommitRange(GmContext* context, const Gamma::ObjectSpan& span) {
+  if (span.count == 0) {
+    return;
+  }
+
+  auto* mesh = context->scene.meshes[span[0]._record.meshIndex];
+
+  mesh->objects.commitObjects(span);
+}
+
+/**
+ * Starts the transform worker threads, leaving
+ * a core free for the main thread.
+ */
+void Gm_InitTransformWorkers() {
+  u32 totalThreads = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+
+  isTransformingStopped = false;
+
+  for (u32 i = 0; i < totalThreads; i++) {
+    transformWorkers.push_back(std::thread(Gm_RunTransformWorker));
+  }
+}
+
+void Gm_DestroyTransformWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(transformMutex);
+
+    isTransformingStopped = true;
+  }
+
+  transformCondition.notify_all();
+
+  for (auto& worker : transformWorkers) {
+    worker.join();
+  }
+
+  transformWorkers.clear();
+  transformBatches.clear();
+}
+
+/**
+ * Computes the matrices of dirty objects across all meshes.
+ * Dirty transforms are gathered into batches first, so that
+ * the transform workers are dispatched at most once a frame,
+ * and only when there's more than one batch of work.
+ */
+void Gm_UpdateTransforms(GmContext* context) {
+  transformBatches.clear();
+
+  for (auto* mesh : context->scene.meshes) {
+    auto& objects = mesh->objects;
+    u32 total = objects.collectDirtyTransforms();
+
+    for (u32 start = 0; start < total; start += TRANSFORM_BATCH_SIZE) {
+      transformBatches.push_back({ &objects, start, std::min(start + TRANSFORM_BATCH_SIZE, total) });
+    }
+  }
+
+  nextTransformBatch = 0;
+
+  if (transformBatches.size() <= 1 || transformWorkers.size() == 0) {
+    Gm_ComputeTransformBatches();
+
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(transformMutex);
+
+    totalFinishedTransformWorkers = 0;
+    transformDispatch++;
+  }
+
+  transformCondition.notify_all();
+
+  Gm_ComputeTransformBatches();
+
+  std::unique_lock<std::mutex> lock(transformMutex);
+
+  transformDoneCondition.wait(lock, []() {
+    return totalFinishedTransformWorkers == transformWorkers.size();
+  });
+}
+
+Gamma::MeshHandle Gm_GetMeshHandle(GmContext* context, const std::string& meshName) {
+  auto& meshMap = context->scene.meshMap;
+
+  assert(meshMap.find(meshName) != meshMap.end(), "Mesh '" + meshName + "' not found");
+
+  return { meshMap.at(meshName)->index };
+}
+
+/**
+ * Interns an object name, returning its handle. Handles
+ * may be resolved before an object is saved under the
+ * name, and remain valid for the lifetime of the scene.
+ */
+Gamma::ObjectHandle Gm_GetObjectHandle(GmContext* context, const std::string& objectName) {
+  auto& scene = context->scene;
+  auto entry = scene.objectHandleMap.find(objectName);
+
+  if (entry != scene.objectHandleMap.end()) {
+    return entry->second;
+  }
+
+  ObjectHandle handle = { (u32)scene.objectStore.size() };
+
+  scene.objectStore.push_back(GmSavedObject());
+  scene.objectHandleMap.emplace(objectName, handle);
+
+  return handle;
+}
+
+/**
+ * Interns a light name, returning its handle.
+ *
+ * @see Gm_GetObjectHandle()
+ */
+Gamma::LightHandle Gm_GetLightHandle(GmContext* context, const std::string& lightName) {
+  auto& scene = context->scene;
+  auto entry = scene.lightHandleMap.find(lightName);
+
+  if (entry != scene.lightHandleMap.end()) {
+    return entry->second;
+  }
+
+  LightHandle handle = { (u32)scene.lightStore.size() };
+
+  scene.lightStore.push_back(nullptr);
+  scene.lightHandleMap.emplace(lightName, handle);
+
+  return handle;
+}
+
+Gamma::Mesh* Gm_GetMesh(GmContext* context, const std::string& meshName) {
+  return Gm_GetMesh(context, Gm_GetMeshHandle(context, meshName));
+}
+
+Gamma::Mesh* Gm_GetMesh(GmContext* context, Gamma::MeshHandle handle) {
+  return context->scene.meshes[handle.index];
+}
+
 Gamma::ObjectPool& Gm_GetObjects(GmContext* context, const std::string& meshName) {
-  // @todo #if GAMMA_DEVELOPER_MODE
-  Gamma::assert(context->scene.meshMap.find(meshName) != context->scene.meshMap.end(), "Mesh '" + meshName + "' not found");
+  return Gm_GetObjects(context, Gm_GetMeshHandle(context, meshName));
+}
 
-  return context->scene.meshMap[meshName]->objects;
+Gamma::ObjectPool& Gm_GetObjects(GmContext* context, Gamma::MeshHandle handle) {
+  return context->scene.meshes[handle.index]->objects;
 }
 
 void Gm_SaveObject(GmContext* context, const std::string& objectName, const Gamma::Object& object) {
-  context->scene.objectStore[objectName] = object._record;
+  Gm_SaveObject(context, Gm_GetObjectHandle(context, objectName), object);
+}
+
+void Gm_SaveObject(GmContext* context, Gamma::ObjectHandle handle, const Gamma::Object& object) {
+  auto& entry = context->scene.objectStore[handle.index];
+
+  entry.record = object._record;
+  entry.isSaved = true;
 }
 
 void Gm_SaveLight(GmContext* context, const std::string& lightName, Gamma::Light* light) {
-  context->scene.lightStore[lightName] = light;
+  Gm_SaveLight(context, Gm_GetLightHandle(context, lightName), light);
+}
+
+void Gm_SaveLight(GmContext* context, Gamma::LightHandle handle, Gamma::Light* light) {
+  context->scene.lightStore[handle.index] = light;
 }
 
 bool Gm_HasObject(GmContext* context, const std::string& objectName) {
   return Gm_FindObject(context, objectName) != nullptr;
 }
 
+bool Gm_HasObject(GmContext* context, Gamma::ObjectHandle handle) {
+  return Gm_FindObject(context, handle) != nullptr;
+}
+
 Gamma::Object* Gm_FindObject(GmContext* context, const std::string& objectName) {
+  auto& handleMap = context->scene.objectHandleMap;
+  auto entry = handleMap.find(objectName);
+
+  if (entry == handleMap.end()) {
+    return nullptr;
+  }
+
+  return Gm_FindObject(context, entry->second);
+}
+
+Gamma::Object* Gm_FindObject(GmContext* context, Gamma::ObjectHandle handle) {
   auto& scene = context->scene;
-  auto& store = scene.objectStore;
+  auto& entry = scene.objectStore[handle.index];
 
-  if (store.find(objectName) == store.end()) {
+  if (!entry.isSaved) {
     return nullptr;
   }
 
-  auto& record = store.at(objectName);
-  auto& mesh = scene.meshes[record.meshIndex];
+  auto& mesh = scene.meshes[entry.record.meshIndex];
 
-  return mesh->objects.getByRecord(record);
+  return mesh->objects.getByRecord(entry.record);
 }
 
 Gamma::Object& Gm_GetObject(GmContext* context, const std::string& objectName) {
+  auto& handleMap = context->scene.objectHandleMap;
+
+  assert(handleMap.find(objectName) != handleMap.end(), "Object '" + objectName + "' not found");
+
+  return Gm_GetObject(context, handleMap.at(objectName));
+}
+
+Gamma::Object& Gm_GetObject(GmContext* context, Gamma::ObjectHandle handle) {
   auto& scene = context->scene;
   // @todo assert that the object exists
-  auto& record = scene.objectStore.at(objectName);
+  auto& record = scene.objectStore[handle.index].record;
   auto& mesh = scene.meshes[record.meshIndex];
 
   return *mesh->objects.getByRecord(record);
 }
 
 Gamma::Light& Gm_GetLight(GmContext* context, const std::string& lightName) {
-  auto& lightStore = context->scene.lightStore;
-  // @todo assert that the light exists
+  auto& handleMap = context->scene.lightHandleMap;
+
+  assert(handleMap.find(lightName) != handleMap.end(), "Light '" + lightName + "' not found");
+
+  return Gm_GetLight(context, handleMap.at(lightName));
+}
 
-  return *lightStore.at(lightName);
+Gamma::Light& Gm_GetLight(GmContext* context, Gamma::LightHandle handle) {
+  // @todo assert that the light exists
+  return *context->scene.lightStore[handle.index];
 }
 
 void Gm_RemoveObject(GmContext* context, const Gamma::Object& object) {
@@ -246,6 +790,13 @@ void Gm_RemoveLight(GmContext* context, Gamma::Light* light) {
 
   Gm_VectorRemove(scene.lights, light);
 
+  // Release any saved handles to the light
+  for (auto& savedLight : scene.lightStore) {
+    if (savedLight == light) {
+      savedLight = nullptr;
+    }
+  }
+
   delete light;
 }
 
@@ -298,39 +849,125 @@ void Gm_HandleFreeCameraMode(GmContext* context, float dt) {
   }
 }
 
+Frustum Gm_GetCameraFrustum(GmContext* context) {
+  auto& camera = context->scene.camera;
+
+  // Mirror the renderer's camera projection/view matrices
+  Matrix4f matProjection = Matrix4f::glPerspective(context->window.size, camera.fov, 1.0f, 10000.0f);
+
+  Matrix4f matView = (
+    camera.rotation.toMatrix4f() *
+    Matrix4f::translation(camera.position.invert().gl())
+  );
+
+  return Frustum::fromViewProjectionGL((matProjection * matView).transpose());
+}
+
+static void Gm_CullMesh(Mesh& mesh, const Frustum& frustum) {
+  u32 totalVisible = mesh.objects.computeVisibility(frustum, mesh.boundingRadius);
+
+  // Draw all visible objects at full detail
+  // unless they're subsequently grouped by LoD
+  for (u32 lodIndex = 0; lodIndex < mesh.lods.size(); lodIndex++) {
+    mesh.lods[lodIndex].instanceOffset = 0;
+    mesh.lods[lodIndex].instanceCount = lodIndex == 0 ? totalVisible : 0;
+  }
+}
+
 void Gm_UseFrustumCulling(GmContext* context, const std::initializer_list<std::string>& meshNames) {
-  auto& meshMap = context->scene.meshMap;
+  auto frustum = Gm_GetCameraFrustum(context);
 
   for (auto& meshName : meshNames) {
-    meshMap[meshName]->objects.partitionByVisibility(context->scene.camera);
+    Gm_CullMesh(*Gm_GetMesh(context, meshName), frustum);
   }
 }
 
+void Gm_UseFrustumCulling(GmContext* context, const std::initializer_list<Gamma::MeshHandle>& meshHandles) {
+  auto frustum = Gm_GetCameraFrustum(context);
+
+  for (auto handle : meshHandles) {
+    Gm_CullMesh(*Gm_GetMesh(context, handle), frustum);
+  }
+}
+
+/**
+ * Groups the visible objects of a Mesh into its LoD levels,
+ * and updates each LoD's instance range accordingly.
+ */
+static void Gm_PartitionLods(Mesh& mesh, const Vec3f& cameraPosition, const float* distances, bool useObjectScale) {
+  u32 levelCounts[MAX_LOD_LEVELS];
+  u32 totalLevels = mesh.lods.size();
+  u32 instanceOffset = 0;
+
+  mesh.objects.partitionVisibleByLod(cameraPosition, distances, totalLevels, useObjectScale, levelCounts);
+
+  for (u32 lodIndex = 0; lodIndex < totalLevels; lodIndex++) {
+    mesh.lods[lodIndex].instanceOffset = instanceOffset;
+    mesh.lods[lodIndex].instanceCount = levelCounts[lodIndex];
+
+    instanceOffset += levelCounts[lodIndex];
+  }
+}
+
+static void Gm_UseLodByDistance(GmContext* context, float distance, Mesh& mesh) {
+  float distances[MAX_LOD_LEVELS];
+
+  if (mesh.lods.size() == 0) {
+    return;
+  }
+
+  // Each LoD covers the next span of the given distance
+  for (u32 i = 0; i < MAX_LOD_LEVELS; i++) {
+    distances[i] = distance * float(i + 1);
+  }
+
+  Gm_PartitionLods(mesh, context->scene.camera.position, distances, false);
+}
+
 void Gm_UseLodByDistance(GmContext* context, float distance, const std::initializer_list<std::string>& meshNames) {
-  auto& meshMap = context->scene.meshMap;
+  for (auto& meshName : meshNames) {
+    Gm_UseLodByDistance(context, distance, *Gm_GetMesh(context, meshName));
+  }
+}
+
+void Gm_UseLodByDistance(GmContext* context, float distance, const std::initializer_list<Gamma::MeshHandle>& meshHandles) {
+  for (auto handle : meshHandles) {
+    Gm_UseLodByDistance(context, distance, *Gm_GetMesh(context, handle));
+  }
+}
+
+static void Gm_UseLodByScreenSize(GmContext* context, float screenSize, Mesh& mesh) {
   auto& camera = context->scene.camera;
+  float distances[MAX_LOD_LEVELS];
 
-  for (auto& meshName : meshNames) {
-    auto& mesh = *meshMap[meshName];
+  if (mesh.lods.size() == 0) {
+    return;
+  }
 
-    u32 instanceOffset = 0;
+  // Distance to the screen plane in pixels, such that an object of
+  // radius r at distance d spans (2 * r * focalLength / d) pixels
+  float focalLength = (float)context->window.size.height / (2.f * tanf(camera.fov / 2.f * DEGREES_TO_RADIANS));
 
-    for (u32 lodIndex = 0; lodIndex < mesh.lods.size(); lodIndex++) {
-      mesh.lods[lodIndex].instanceOffset = instanceOffset;
+  // Successive LoDs take over each time the projected size of
+  // an object halves beyond the given screen size. Distances
+  // are scaled by object size during partitioning.
+  float baseDistance = 2.f * mesh.boundingRadius * focalLength / screenSize;
 
-      if (lodIndex < mesh.lods.size() - 1) {
-        // Group all objects within the distance threshold
-        // in front of those outside it, and use the pivot
-        // defining that boundary to determine our instance
-        // count for this LoD set
-        instanceOffset = (u32)mesh.objects.partitionByDistance((u16)instanceOffset, distance * float(lodIndex + 1), camera.position);
+  for (u32 i = 0; i < MAX_LOD_LEVELS; i++) {
+    distances[i] = baseDistance * float(1 << i);
+  }
 
-        mesh.lods[lodIndex].instanceCount = instanceOffset - mesh.lods[lodIndex].instanceOffset;
-      } else {
-        // The final LoD can just use the remaining set
-        // of objects beyond the last LoD distance threshold
-        mesh.lods[lodIndex].instanceCount = (u32)mesh.objects.totalVisible() - instanceOffset;
-      }
-    }
+  Gm_PartitionLods(mesh, camera.position, distances, true);
+}
+
+void Gm_UseLodByScreenSize(GmContext* context, float screenSize, const std::initializer_list<std::string>& meshNames) {
+  for (auto& meshName : meshNames) {
+    Gm_UseLodByScreenSize(context, screenSize, *Gm_GetMesh(context, meshName));
+  }
+}
+
+void Gm_UseLodByScreenSize(GmContext* context, float screenSize, const std::initializer_list<Gamma::MeshHandle>& meshHandles) {
+  for (auto handle : meshHandles) {
+    Gm_UseLodByScreenSize(context, screenSize, *Gm_GetMesh(context, handle));
   }
 }
\ No newline at end of file
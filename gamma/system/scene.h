@@ -2,15 +2,18 @@
 
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <initializer_list>
 #include <map>
 #include <string>
 #include <vector>
 
+#include "math/frustum.h"
 #include "system/camera.h"
 #include "system/entities.h"
 #include "system/InputSystem.h"
 #include "system/Signaler.h"
+#include "system/static_batching.h"
 #include "system/traits.h"
 #include "system/type_aliases.h"
 
@@ -18,7 +21,9 @@
 #define addProbe(probeName, position) Gm_AddProbe(context, probeName, position)
 #define createLight(type) Gm_CreateLight(context, type)
 #define createObjectFrom(meshName) Gm_CreateObjectFrom(context, meshName)
+#define createObjectsFrom(meshName, count) Gm_CreateObjects(context, meshName, count)
 #define commit(object) Gm_Commit(context, object)
+#define commitRange(span) Gm_CommitRange(context, span)
 #define saveObject(objectName, object) Gm_SaveObject(context, objectName, object)
 #define saveLight(lightName, light) Gm_SaveLight(context, lightName, light)
 #define hasObject(objectName) Gm_HasObject(context, objectName)
@@ -27,11 +32,15 @@
 #define light(lightName) Gm_GetLight(context, lightName)
 #define removeObject(object) Gm_RemoveObject(context, object)
 #define removeLight(light) Gm_RemoveLight(context, light)
-#define mesh(meshName) context->scene.meshMap.at(meshName)
+#define mesh(meshName) Gm_GetMesh(context, meshName)
 #define objects(meshName) Gm_GetObjects(context, meshName)
 #define pointCameraAt(...) Gm_PointCameraAt(context, __VA_ARGS__)
 #define useFrustumCulling(...) Gm_UseFrustumCulling(context, __VA_ARGS__)
 #define useLodByDistance(distance, ...) Gm_UseLodByDistance(context, distance, __VA_ARGS__)
+#define useLodByScreenSize(screenSize, ...) Gm_UseLodByScreenSize(context, screenSize, __VA_ARGS__)
+#define meshHandle(meshName) Gm_GetMeshHandle(context, meshName)
+#define objectHandle(objectName) Gm_GetObjectHandle(context, objectName)
+#define lightHandle(lightName) Gm_GetLightHandle(context, lightName)
 
 #define getInput() context->scene.input
 #define getCamera() context->scene.camera
@@ -46,6 +55,52 @@ struct GmSceneStats {
   u32 tris = 0;
 };
 
+/**
+ * GmMeshRequest
+ * -------------
+ *
+ * A mesh to be created and added to the scene by
+ * Gm_AddMeshes(). createMesh() may be run on a worker
+ * thread, and must not touch the context or renderer.
+ * Streamed meshes are added without geometry, deferring
+ * createMesh() until they are first retained.
+ */
+struct GmMeshRequest {
+  std::string meshName;
+  // 0 for pools capped only by the object ID range
+  u32 maxInstances = 0;
+  std::function<Gamma::Mesh*()> createMesh;
+  bool isStreamed = false;
+};
+
+/**
+ * GmStreamedMesh
+ * --------------
+ *
+ * Loading state for a streamed mesh. Meshes shared by
+ * multiple zones (or other users) are reference counted,
+ * and only unloaded once every user has released them
+ * and their grace period has elapsed.
+ */
+struct GmStreamedMesh {
+  std::function<Gamma::Mesh*()> createMesh;
+  std::future<Gamma::Mesh*> pendingMesh;
+  u32 references = 0;
+  float unloadTime = 0.f;
+};
+
+/**
+ * GmSavedObject
+ * -------------
+ *
+ * An entry in the scene's saved object table,
+ * indexed by ObjectHandle.
+ */
+struct GmSavedObject {
+  Gamma::ObjectRecord record;
+  bool isSaved = false;
+};
+
 struct GmScene {
   Gamma::Camera camera;
   Gamma::InputSystem input;
@@ -53,9 +108,16 @@ struct GmScene {
   std::vector<Gamma::Light*> lights;
   std::map<std::string, Gamma::Mesh*> meshMap;
   std::map<std::string, Gamma::Vec3f> probeMap;
-  std::map<std::string, Gamma::ObjectRecord> objectStore;
-  // @todo when recycling a light, its lightStore entry should be removed
-  std::map<std::string, Gamma::Light*> lightStore;
+  // Names are interned into handles, which index into
+  // the saved object/light tables (see Gm_GetObjectHandle()
+  // and Gm_GetLightHandle())
+  std::map<std::string, Gamma::ObjectHandle> objectHandleMap;
+  std::map<std::string, Gamma::LightHandle> lightHandleMap;
+  std::vector<GmSavedObject> objectStore;
+  std::vector<Gamma::Light*> lightStore;
+  // Streamed mesh states, by mesh index
+  std::map<u16, GmStreamedMesh> streamedMeshes;
+  std::vector<Gamma::StaticBatch*> staticBatches;
   Gamma::Vec3f freeCameraVelocity = Gamma::Vec3f(0.0f);
   u16 runningMeshId = 0;
   u32 frame = 0;
@@ -63,23 +125,52 @@ struct GmScene {
 };
 
 const GmSceneStats Gm_GetSceneStats(GmContext* context);
-void Gm_AddMesh(GmContext* context, const std::string& meshName, u16 maxInstances, Gamma::Mesh* mesh);
+void Gm_AddMesh(GmContext* context, const std::string& meshName, u32 maxInstances, Gamma::Mesh* mesh);
+void Gm_AddMeshes(GmContext* context, const std::vector<GmMeshRequest>& requests);
+void Gm_RetainMesh(GmContext* context, Gamma::MeshHandle handle);
+void Gm_ReleaseMesh(GmContext* context, Gamma::MeshHandle handle, float gracePeriod = 0.f);
+void Gm_UpdateStreamedMeshes(GmContext* context);
+void Gm_WaitForStreamedMeshes(GmContext* context);
+void Gm_ReplaceMeshGeometry(GmContext* context, const std::string& meshName, Gamma::Mesh* geometry);
+void Gm_AddStaticBatch(GmContext* context, const std::string& batchName, const std::vector<std::string>& meshNames);
 void Gm_AddProbe(GmContext* context, const std::string& probeName, const Gamma::Vec3f& position);
 Gamma::Light& Gm_CreateLight(GmContext* context, Gamma::LightType type);
 void Gm_UseSceneFile(GmContext* context, const std::string& filename);
 Gamma::Object& Gm_CreateObjectFrom(GmContext* context, const std::string& meshName);
+Gamma::ObjectSpan Gm_CreateObjects(GmContext* context, const std::string& meshName, u32 count);
 void Gm_Commit(GmContext* context, const Gamma::Object& object);
+void Gm_CommitRange(GmContext* context, const Gamma::ObjectSpan& span);
+void Gm_InitTransformWorkers();
+void Gm_DestroyTransformWorkers();
+void Gm_UpdateTransforms(GmContext* context);
+Gamma::MeshHandle Gm_GetMeshHandle(GmContext* context, const std::string& meshName);
+Gamma::ObjectHandle Gm_GetObjectHandle(GmContext* context, const std::string& objectName);
+Gamma::LightHandle Gm_GetLightHandle(GmContext* context, const std::string& lightName);
+Gamma::Mesh* Gm_GetMesh(GmContext* context, const std::string& meshName);
+Gamma::Mesh* Gm_GetMesh(GmContext* context, Gamma::MeshHandle handle);
 Gamma::ObjectPool& Gm_GetObjects(GmContext* context, const std::string& meshName);
+Gamma::ObjectPool& Gm_GetObjects(GmContext* context, Gamma::MeshHandle handle);
 void Gm_SaveObject(GmContext* context, const std::string& objectName, const Gamma::Object& object);
+void Gm_SaveObject(GmContext* context, Gamma::ObjectHandle handle, const Gamma::Object& object);
 void Gm_SaveLight(GmContext* context, const std::string& lightName, Gamma::Light* light);
+void Gm_SaveLight(GmContext* context, Gamma::LightHandle handle, Gamma::Light* light);
 bool Gm_HasObject(GmContext* context, const std::string& objectName);
+bool Gm_HasObject(GmContext* context, Gamma::ObjectHandle handle);
 Gamma::Object* Gm_FindObject(GmContext* context, const std::string& objectName);
+Gamma::Object* Gm_FindObject(GmContext* context, Gamma::ObjectHandle handle);
 Gamma::Object& Gm_GetObject(GmContext* context, const std::string& objectName);
+Gamma::Object& Gm_GetObject(GmContext* context, Gamma::ObjectHandle handle);
 Gamma::Light& Gm_GetLight(GmContext* context, const std::string& lightName);
+Gamma::Light& Gm_GetLight(GmContext* context, Gamma::LightHandle handle);
 void Gm_RemoveObject(GmContext* context, const Gamma::Object& object);
 void Gm_RemoveLight(GmContext* context, Gamma::Light* light);
 void Gm_PointCameraAt(GmContext* context, const Gamma::Object& object, bool upsideDown = false);
 void Gm_PointCameraAt(GmContext* context, const Gamma::Vec3f& position, bool upsideDown = false);
 void Gm_HandleFreeCameraMode(GmContext* context, float dt);
+Gamma::Frustum Gm_GetCameraFrustum(GmContext* context);
 void Gm_UseFrustumCulling(GmContext* context, const std::initializer_list<std::string>& meshNames);
-void Gm_UseLodByDistance(GmContext* context, float distance, const std::initializer_list<std::string>& meshNames);
\ No newline at end of file
+void Gm_UseFrustumCulling(GmContext* context, const std::initializer_list<Gamma::MeshHandle>& meshHandles);
+void Gm_UseLodByDistance(GmContext* context, float distance, const std::initializer_list<std::string>& meshNames);
+void Gm_UseLodByDistance(GmContext* context, float distance, const std::initializer_list<Gamma::MeshHandle>& meshHandles);
+void Gm_UseLodByScreenSize(GmContext* context, float screenSize, const std::initializer_list<std::string>& meshNames);
+void Gm_UseLodByScreenSize(GmContext* context, float screenSize, const std::initializer_list<Gamma::MeshHandle>& meshHandles);
\ No newline at end of file
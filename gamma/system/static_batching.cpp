@@ -0,0 +1,175 @@
+#include "system/entities.h"
+#include "system/static_batching.h"
+
+namespace Gamma {
+  /**
+   * Returns the slot of a texture in a batch's textures,
+   * or -1 if the batch doesn't have it yet.
+   */
+  static s32 Gm_FindStaticBatchTexture(const StaticBatch& batch, const std::string& path, TextureType type) {
+    for (u32 slot = 0; slot < batch.textures.size(); slot++) {
+      auto& texture = batch.textures[slot];
+
+      if (texture.path == path && texture.type == type) {
+        return (s32)slot;
+      }
+    }
+
+    return -1;
+  }
+
+  /**
+   * Returns the slot for a texture in a batch's textures,
+   * adding it if the batch doesn't have it yet, or -1 for
+   * meshes without the texture.
+   */
+  static s32 Gm_UseStaticBatchTexture(StaticBatch& batch, const std::string& path, TextureType type) {
+    if (path.size() == 0) {
+      return -1;
+    }
+
+    s32 slot = Gm_FindStaticBatchTexture(batch, path, type);
+
+    if (slot == -1) {
+      slot = (s32)batch.textures.size();
+
+      batch.textures.push_back({ path, type });
+    }
+
+    return slot;
+  }
+
+  bool Gm_CanStaticBatchMesh(const Mesh* mesh) {
+    return (
+      mesh->isResident &&
+      mesh->type == MeshType::DEFAULT &&
+      mesh->transformedVertices.size() == 0 &&
+      mesh->faceElements.size() > 0
+    );
+  }
+
+  bool Gm_IsStaticBatchReady(const StaticBatch& batch) {
+    for (auto* mesh : batch.meshes) {
+      if (!mesh->isResident) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool Gm_IsStaticBatchStale(const StaticBatch& batch) {
+    for (u32 i = 0; i < batch.draws.size(); i++) {
+      auto& draw = batch.draws[i];
+      auto& mesh = *draw.mesh;
+
+      if (draw.geometryVersion != mesh.geometryVersion || draw.instanceCapacity != mesh.objects.capacity()) {
+        return true;
+      }
+
+      #if GAMMA_DEVELOPER_MODE
+        // Allow mesh textures to be changed during development
+        auto& material = batch.materials[i];
+        std::string texture = material.textureSlot == -1 ? "" : batch.textures[material.textureSlot].path;
+        std::string normalMap = material.normalMapSlot == -1 ? "" : batch.textures[material.normalMapSlot].path;
+
+        if (texture != mesh.texture || normalMap != mesh.normalMap) {
+          return true;
+        }
+      #endif
+    }
+
+    return false;
+  }
+
+  void Gm_BuildStaticBatch(StaticBatch& batch) {
+    batch.vertices.clear();
+    batch.faceElements.clear();
+    batch.draws.clear();
+    batch.materials.clear();
+    batch.textures.clear();
+    batch.totalInstances = 0;
+
+    for (auto* mesh : batch.meshes) {
+      if (!Gm_CanStaticBatchMesh(mesh)) {
+        continue;
+      }
+
+      // Make sure the mesh's textures fit alongside the
+      // batch's existing ones before committing to it
+      u32 totalNewTextures = 0;
+
+      if (mesh->texture.size() > 0 && Gm_FindStaticBatchTexture(batch, mesh->texture, TextureType::COLOR) == -1) {
+        totalNewTextures++;
+      }
+
+      if (mesh->normalMap.size() > 0 && Gm_FindStaticBatchTexture(batch, mesh->normalMap, TextureType::NORMAL) == -1) {
+        totalNewTextures++;
+      }
+
+      if (batch.textures.size() + totalNewTextures > MAX_STATIC_BATCH_TEXTURES) {
+        continue;
+      }
+
+      StaticBatchDraw draw;
+      StaticBatchMaterial material;
+      u32 elementOffset = batch.faceElements.size();
+
+      draw.mesh = mesh;
+      draw.baseVertex = batch.vertices.size();
+      draw.baseInstance = batch.totalInstances;
+      draw.instanceCapacity = mesh->objects.capacity();
+      draw.geometryVersion = mesh->geometryVersion;
+
+      if (mesh->lods.size() > 0) {
+        auto& highestLod = mesh->lods[0];
+        auto& lowestLod = mesh->lods.back();
+
+        draw.firstIndex = elementOffset + highestLod.elementOffset;
+        draw.indexCount = highestLod.elementCount;
+        draw.lowestFirstIndex = elementOffset + lowestLod.elementOffset;
+        draw.lowestIndexCount = lowestLod.elementCount;
+      } else {
+        draw.firstIndex = elementOffset;
+        draw.indexCount = mesh->faceElements.size();
+        draw.lowestFirstIndex = draw.firstIndex;
+        draw.lowestIndexCount = draw.indexCount;
+      }
+
+      material.textureSlot = Gm_UseStaticBatchTexture(batch, mesh->texture, TextureType::COLOR);
+      material.normalMapSlot = Gm_UseStaticBatchTexture(batch, mesh->normalMap, TextureType::NORMAL);
+      material.emissivity = mesh->emissivity;
+
+      batch.vertices.insert(batch.vertices.end(), mesh->vertices.begin(), mesh->vertices.end());
+      batch.faceElements.insert(batch.faceElements.end(), mesh->faceElements.begin(), mesh->faceElements.end());
+      batch.draws.push_back(draw);
+      batch.materials.push_back(material);
+      batch.totalInstances += draw.instanceCapacity;
+    }
+  }
+
+  void Gm_GenerateStaticBatchCommands(const StaticBatch& batch, const StaticBatchInstances* instances, bool useLowestLevelOfDetail, std::vector<u32>& instanceIndices, std::vector<StaticBatchCommand>& commands) {
+    for (u32 i = 0; i < batch.draws.size(); i++) {
+      auto& draw = batch.draws[i];
+      auto& drawInstances = instances[i];
+      StaticBatchCommand command;
+
+      command.count = useLowestLevelOfDetail ? draw.lowestIndexCount : draw.indexCount;
+      command.firstIndex = useLowestLevelOfDetail ? draw.lowestFirstIndex : draw.firstIndex;
+      command.baseVertex = draw.baseVertex;
+      command.baseInstance = instanceIndices.size();
+
+      if (!draw.mesh->disabled) {
+        command.instanceCount = drawInstances.count;
+
+        for (u32 j = 0; j < drawInstances.count; j++) {
+          u32 objectIndex = drawInstances.indices != nullptr ? drawInstances.indices[j] : j;
+
+          instanceIndices.push_back(draw.baseInstance + objectIndex);
+        }
+      }
+
+      commands.push_back(command);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "math/geometry.h"
+#include "system/texture_compression.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  struct Mesh;
+
+  /**
+   * The number of distinct textures (albedo and normal maps)
+   * a StaticBatch can select between. Batched textures are
+   * bound to consecutive units following those used by the
+   * rest of the renderer, so this must stay within the
+   * minimum guaranteed number of fragment texture units.
+   */
+  const static u32 MAX_STATIC_BATCH_TEXTURES = 12;
+
+  /**
+   * StaticBatchTexture
+   * ------------------
+   *
+   * A texture selectable by the draws in a StaticBatch.
+   */
+  struct StaticBatchTexture {
+    std::string path;
+    TextureType type = TextureType::COLOR;
+  };
+
+  /**
+   * StaticBatchMaterial
+   * -------------------
+   *
+   * Per-draw material parameters, indexed by draw in shaders
+   * (see shaders/utils/static-batch.glsl). Texture slots are
+   * indices into the batch's textures, or -1 for none.
+   *
+   * @size 16 bytes
+   */
+  struct StaticBatchMaterial {
+    s32 textureSlot = -1;
+    s32 normalMapSlot = -1;
+    float emissivity = 0.f;
+    u32 padding = 0;
+  };
+
+  /**
+   * StaticBatchDraw
+   * ---------------
+   *
+   * The geometry and instance storage of a batched Mesh within
+   * its StaticBatch. The lowest level of detail range is the
+   * same as the full range for meshes without levels of detail.
+   */
+  struct StaticBatchDraw {
+    const Mesh* mesh = nullptr;
+    u32 firstIndex = 0;
+    u32 indexCount = 0;
+    u32 lowestFirstIndex = 0;
+    u32 lowestIndexCount = 0;
+    u32 baseVertex = 0;
+    /**
+     * The mesh's first object slot in the batch's instance
+     * storage, which reserves the full capacity of its pool.
+     */
+    u32 baseInstance = 0;
+    u32 instanceCapacity = 0;
+    u32 geometryVersion = 0;
+  };
+
+  /**
+   * StaticBatchCommand
+   * ------------------
+   *
+   * An indexed, instanced draw within a StaticBatch, laid out
+   * to match GlDrawElementsIndirectCommand.
+   *
+   * @size 20 bytes
+   */
+  struct StaticBatchCommand {
+    u32 count = 0;
+    u32 instanceCount = 0;
+    u32 firstIndex = 0;
+    u32 baseVertex = 0;
+    u32 baseInstance = 0;
+  };
+
+  /**
+   * StaticBatchInstances
+   * --------------------
+   *
+   * The instances of a batched Mesh drawn for a given view, as
+   * a list of object indices, or as the first (count) objects
+   * in pool order when there isn't one.
+   */
+  struct StaticBatchInstances {
+    const u32* indices = nullptr;
+    u32 count = 0;
+  };
+
+  /**
+   * StaticBatch
+   * -----------
+   *
+   * A set of meshes whose objects never move after they're
+   * placed, e.g. the structures in a zone, packed together
+   * so they can be drawn with a single multi-draw per pass.
+   *
+   * Vertices and face elements of every batchable mesh are
+   * appended to a shared arena, and their objects reserve
+   * consecutive ranges of one instance storage buffer. Each
+   * batched mesh corresponds to one draw, and one material,
+   * in draw order.
+   */
+  struct StaticBatch {
+    std::string name;
+    /**
+     * The meshes to batch. Meshes which can't be batched
+     * are left out of the batch's draws, and drawn on
+     * their own as usual.
+     */
+    std::vector<const Mesh*> meshes;
+    /**
+     * Combined mesh geometry. Face elements remain
+     * relative to each draw's base vertex.
+     */
+    std::vector<Vertex> vertices;
+    std::vector<u32> faceElements;
+    std::vector<StaticBatchDraw> draws;
+    std::vector<StaticBatchMaterial> materials;
+    std::vector<StaticBatchTexture> textures;
+    u32 totalInstances = 0;
+  };
+
+  /**
+   * Gm_CanStaticBatchMesh
+   * ---------------------
+   *
+   * Determines whether a Mesh can be drawn as part of a
+   * StaticBatch: only resident meshes of the default type
+   * with fixed geometry are.
+   */
+  bool Gm_CanStaticBatchMesh(const Mesh* mesh);
+
+  /**
+   * Gm_IsStaticBatchReady
+   * ---------------------
+   *
+   * Determines whether every mesh in a StaticBatch is
+   * resident, so the batch can be built.
+   */
+  bool Gm_IsStaticBatchReady(const StaticBatch& batch);
+
+  /**
+   * Gm_IsStaticBatchStale
+   * ---------------------
+   *
+   * Determines whether a built StaticBatch no longer matches
+   * its meshes, e.g. if their geometry has been replaced or
+   * their object pools have been resized.
+   */
+  bool Gm_IsStaticBatchStale(const StaticBatch& batch);
+
+  /**
+   * Gm_BuildStaticBatch
+   * -------------------
+   *
+   * (Re)builds the arena, draws, materials and textures of a
+   * StaticBatch from its meshes. Meshes are skipped if they
+   * can't be batched, or if their textures don't fit within
+   * MAX_STATIC_BATCH_TEXTURES alongside those of the meshes
+   * before them.
+   */
+  void Gm_BuildStaticBatch(StaticBatch& batch);
+
+  /**
+   * Gm_GenerateStaticBatchCommands
+   * ------------------------------
+   *
+   * Appends one command per draw in a StaticBatch for a given
+   * view, along with the batch instance index of each visible
+   * object, which commands read starting at their baseInstance.
+   * Draws for disabled meshes, or without visible instances, are
+   * still generated with an instanceCount of 0, so command order
+   * always matches draw (and material) order.
+   */
+  void Gm_GenerateStaticBatchCommands(const StaticBatch& batch, const StaticBatchInstances* instances, bool useLowestLevelOfDetail, std::vector<u32>& instanceIndices, std::vector<StaticBatchCommand>& commands);
+}
\ No newline at end of file
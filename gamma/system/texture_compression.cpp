@@ -0,0 +1,914 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "system/texture_compression.h"
+
+/**
+ * Power iterations used to find the principal axis of
+ * the texels in a block, which endpoints are fit along
+ */
+#define PRINCIPAL_AXIS_ITERATIONS 8
+/**
+ * Rounds of least-squares endpoint refinement per block
+ */
+#define ENDPOINT_REFINEMENT_ITERATIONS 2
+
+namespace Gamma {
+  struct FloatImage {
+    u32 width;
+    u32 height;
+    std::vector<float> texels;
+  };
+
+  struct FilterTap {
+    u32 index;
+    float weight;
+  };
+
+  const static u8 BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+  inline static float Gm_SrgbToLinear(float value) {
+    return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+  }
+
+  inline static float Gm_LinearToSrgb(float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.f / 2.4f) - 0.055f;
+  }
+
+  inline static u8 Gm_ToByte(float value) {
+    return (u8)std::clamp(value * 255.f + 0.5f, 0.f, 255.f);
+  }
+
+  /**
+   * Decodes RGBA8 pixels into the space their mips are filtered
+   * in: premultiplied linear color for COLOR textures, unit
+   * vectors for NORMAL textures, and [0, 1] for LINEAR ones.
+   */
+  static void Gm_DecodeTexels(const u8* pixels, u32 width, u32 height, TextureType type, FloatImage& image) {
+    u32 totalTexels = width * height;
+
+    image.width = width;
+    image.height = height;
+    image.texels.resize(totalTexels * 4);
+
+    for (u32 i = 0; i < totalTexels; i++) {
+      const u8* pixel = &pixels[i * 4];
+      float* texel = &image.texels[i * 4];
+
+      for (u32 c = 0; c < 4; c++) {
+        texel[c] = pixel[c] / 255.f;
+      }
+
+      if (type == TextureType::COLOR) {
+        for (u32 c = 0; c < 3; c++) {
+          texel[c] = Gm_SrgbToLinear(texel[c]) * texel[3];
+        }
+      } else if (type == TextureType::NORMAL) {
+        float x = texel[0] * 2.f - 1.f;
+        float y = texel[1] * 2.f - 1.f;
+        float z = texel[2] * 2.f - 1.f;
+        float length = sqrtf(x * x + y * y + z * z);
+
+        texel[0] = length > 0.f ? x / length : 0.f;
+        texel[1] = length > 0.f ? y / length : 0.f;
+        texel[2] = length > 0.f ? z / length : 1.f;
+      }
+    }
+  }
+
+  static void Gm_EncodeTexels(const FloatImage& image, TextureType type, std::vector<u8>& pixels) {
+    u32 totalTexels = image.width * image.height;
+
+    pixels.resize(totalTexels * 4);
+
+    for (u32 i = 0; i < totalTexels; i++) {
+      const float* texel = &image.texels[i * 4];
+      u8* pixel = &pixels[i * 4];
+
+      if (type == TextureType::COLOR) {
+        float alpha = texel[3];
+
+        for (u32 c = 0; c < 3; c++) {
+          pixel[c] = alpha > 0.f ? Gm_ToByte(Gm_LinearToSrgb(texel[c] / alpha)) : 0;
+        }
+
+        pixel[3] = Gm_ToByte(alpha);
+      } else if (type == TextureType::NORMAL) {
+        float x = texel[0];
+        float y = texel[1];
+        float z = texel[2];
+        float length = sqrtf(x * x + y * y + z * z);
+
+        if (length > 0.f) {
+          x /= length;
+          y /= length;
+          z /= length;
+        } else {
+          x = y = 0.f;
+          z = 1.f;
+        }
+
+        pixel[0] = Gm_ToByte(x * 0.5f + 0.5f);
+        pixel[1] = Gm_ToByte(y * 0.5f + 0.5f);
+        pixel[2] = Gm_ToByte(z * 0.5f + 0.5f);
+        pixel[3] = Gm_ToByte(texel[3]);
+      } else {
+        for (u32 c = 0; c < 4; c++) {
+          pixel[c] = Gm_ToByte(texel[c]);
+        }
+      }
+    }
+  }
+
+  /**
+   * Computes the source texels and weights contributing to each
+   * target texel along one axis, using a tent filter as wide as
+   * the scale factor. Halving a dimension produces [1, 3, 3, 1]
+   * weights, which alias less than a 2x2 box filter.
+   */
+  static void Gm_GetFilterTaps(u32 sourceSize, u32 targetSize, std::vector<std::vector<FilterTap>>& taps) {
+    float scale = float(sourceSize) / float(targetSize);
+
+    taps.resize(targetSize);
+
+    for (u32 t = 0; t < targetSize; t++) {
+      float center = (t + 0.5f) * scale;
+      s32 start = (s32)floorf(center - scale);
+      s32 end = (s32)ceilf(center + scale);
+      float totalWeight = 0.f;
+
+      taps[t].clear();
+
+      for (s32 s = start; s < end; s++) {
+        float weight = 1.f - fabsf(s + 0.5f - center) / scale;
+
+        if (weight > 0.f) {
+          taps[t].push_back({ (u32)std::clamp(s, 0, s32(sourceSize) - 1), weight });
+
+          totalWeight += weight;
+        }
+      }
+
+      for (auto& tap : taps[t]) {
+        tap.weight /= totalWeight;
+      }
+    }
+  }
+
+  static void Gm_Downsample(const FloatImage& source, FloatImage& target) {
+    std::vector<std::vector<FilterTap>> columnTaps;
+    std::vector<std::vector<FilterTap>> rowTaps;
+    std::vector<float> intermediate;
+
+    target.width = std::max(source.width / 2, 1u);
+    target.height = std::max(source.height / 2, 1u);
+    target.texels.assign(target.width * target.height * 4, 0.f);
+    intermediate.assign(target.width * source.height * 4, 0.f);
+
+    Gm_GetFilterTaps(source.width, target.width, columnTaps);
+    Gm_GetFilterTaps(source.height, target.height, rowTaps);
+
+    // Filter horizontally
+    for (u32 y = 0; y < source.height; y++) {
+      for (u32 x = 0; x < target.width; x++) {
+        float* texel = &intermediate[(y * target.width + x) * 4];
+
+        for (auto& tap : columnTaps[x]) {
+          const float* sample = &source.texels[(y * source.width + tap.index) * 4];
+
+          for (u32 c = 0; c < 4; c++) {
+            texel[c] += sample[c] * tap.weight;
+          }
+        }
+      }
+    }
+
+    // Filter vertically
+    for (u32 y = 0; y < target.height; y++) {
+      for (u32 x = 0; x < target.width; x++) {
+        float* texel = &target.texels[(y * target.width + x) * 4];
+
+        for (auto& tap : rowTaps[y]) {
+          const float* sample = &intermediate[(tap.index * target.width + x) * 4];
+
+          for (u32 c = 0; c < 4; c++) {
+            texel[c] += sample[c] * tap.weight;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Finds the mean and the direction of greatest variance
+   * of a block's texels, across the first (channels) channels.
+   */
+  static void Gm_GetPrincipalAxis(const float (*texels)[4], u32 channels, float* mean, float* axis) {
+    float covariance[4][4] = { 0 };
+
+    for (u32 c = 0; c < channels; c++) {
+      mean[c] = 0.f;
+
+      for (u32 i = 0; i < 16; i++) {
+        mean[c] += texels[i][c];
+      }
+
+      mean[c] /= 16.f;
+    }
+
+    for (u32 i = 0; i < 16; i++) {
+      for (u32 a = 0; a < channels; a++) {
+        for (u32 b = 0; b < channels; b++) {
+          covariance[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+        }
+      }
+    }
+
+    for (u32 c = 0; c < channels; c++) {
+      axis[c] = 1.f;
+    }
+
+    for (u32 iteration = 0; iteration < PRINCIPAL_AXIS_ITERATIONS; iteration++) {
+      float next[4] = { 0 };
+      float length = 0.f;
+
+      for (u32 a = 0; a < channels; a++) {
+        for (u32 b = 0; b < channels; b++) {
+          next[a] += covariance[a][b] * axis[b];
+        }
+
+        length += next[a] * next[a];
+      }
+
+      if (length < 1e-12f) {
+        // Uniform block
+        break;
+      }
+
+      length = sqrtf(length);
+
+      for (u32 c = 0; c < channels; c++) {
+        axis[c] = next[c] / length;
+      }
+    }
+  }
+
+  /**
+   * Places a pair of endpoints at the extremes of the
+   * block's texels projected onto their principal axis.
+   */
+  static void Gm_FitEndpoints(const float (*texels)[4], u32 channels, float* e0, float* e1) {
+    float mean[4];
+    float axis[4];
+    float minimum = FLT_MAX;
+    float maximum = -FLT_MAX;
+
+    Gm_GetPrincipalAxis(texels, channels, mean, axis);
+
+    for (u32 i = 0; i < 16; i++) {
+      float t = 0.f;
+
+      for (u32 c = 0; c < channels; c++) {
+        t += (texels[i][c] - mean[c]) * axis[c];
+      }
+
+      minimum = std::min(minimum, t);
+      maximum = std::max(maximum, t);
+    }
+
+    for (u32 c = 0; c < channels; c++) {
+      e0[c] = mean[c] + axis[c] * maximum;
+      e1[c] = mean[c] + axis[c] * minimum;
+    }
+  }
+
+  /**
+   * Solves for the endpoints which best reproduce the block's
+   * texels, given the interpolation weight (towards e1) chosen
+   * for each texel. Returns false if the system is degenerate.
+   */
+  static bool Gm_RefineEndpoints(const float (*texels)[4], u32 channels, const float* weights, float* e0, float* e1) {
+    float aa = 0.f, ab = 0.f, bb = 0.f;
+    float ax[4] = { 0 };
+    float bx[4] = { 0 };
+
+    for (u32 i = 0; i < 16; i++) {
+      float a = 1.f - weights[i];
+      float b = weights[i];
+
+      aa += a * a;
+      ab += a * b;
+      bb += b * b;
+
+      for (u32 c = 0; c < channels; c++) {
+        ax[c] += a * texels[i][c];
+        bx[c] += b * texels[i][c];
+      }
+    }
+
+    float determinant = aa * bb - ab * ab;
+
+    if (fabsf(determinant) < 1e-6f) {
+      return false;
+    }
+
+    for (u32 c = 0; c < channels; c++) {
+      e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.f, 255.f);
+      e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.f, 255.f);
+    }
+
+    return true;
+  }
+
+  inline static u16 Gm_PackRgb565(const float* color) {
+    u32 r = (u32)(std::clamp(color[0], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+    u32 g = (u32)(std::clamp(color[1], 0.f, 255.f) * 63.f / 255.f + 0.5f);
+    u32 b = (u32)(std::clamp(color[2], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+
+    return u16((r << 11) | (g << 5) | b);
+  }
+
+  inline static void Gm_UnpackRgb565(u16 packed, u32* color) {
+    u32 r = (packed >> 11) & 31;
+    u32 g = (packed >> 5) & 63;
+    u32 b = packed & 31;
+
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+  }
+
+  static void Gm_GetBC1Palette(u16 c0, u16 c1, bool isAlwaysFourColor, u32 (*palette)[4]) {
+    Gm_UnpackRgb565(c0, palette[0]);
+    Gm_UnpackRgb565(c1, palette[1]);
+
+    palette[0][3] = palette[1][3] = 255;
+
+    if (c0 > c1 || isAlwaysFourColor) {
+      for (u32 c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+      }
+
+      palette[2][3] = palette[3][3] = 255;
+    } else {
+      for (u32 c = 0; c < 3; c++) {
+        palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+        palette[3][c] = 0;
+      }
+
+      palette[2][3] = 255;
+      palette[3][3] = 0;
+    }
+  }
+
+  /**
+   * Encodes the RGB channels of a block as a BC1 color block,
+   * always using its four-color mode.
+   */
+  static void Gm_EncodeBC1Block(const float (*texels)[4], u8* block) {
+    const static float weights[4] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+    float e0[4];
+    float e1[4];
+    u16 bestC0 = 0;
+    u16 bestC1 = 0;
+    u32 bestIndices = 0;
+    float bestError = FLT_MAX;
+
+    Gm_FitEndpoints(texels, 3, e0, e1);
+
+    for (u32 iteration = 0; iteration <= ENDPOINT_REFINEMENT_ITERATIONS; iteration++) {
+      u16 c0 = Gm_PackRgb565(e0);
+      u16 c1 = Gm_PackRgb565(e1);
+
+      if (c0 < c1) {
+        std::swap(c0, c1);
+      }
+
+      u32 palette[4][4];
+      u32 indices = 0;
+      float error = 0.f;
+      float texelWeights[16];
+
+      Gm_GetBC1Palette(c0, c1, true, palette);
+
+      for (u32 i = 0; i < 16; i++) {
+        u32 bestIndex = 0;
+        float bestDistance = FLT_MAX;
+
+        // Equal endpoints can only use index 0
+        for (u32 p = 0; p < (c0 == c1 ? 1 : 4); p++) {
+          float distance = 0.f;
+
+          for (u32 c = 0; c < 3; c++) {
+            float delta = texels[i][c] - palette[p][c];
+
+            distance += delta * delta;
+          }
+
+          if (distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = p;
+          }
+        }
+
+        indices |= bestIndex << (i * 2);
+        error += bestDistance;
+        texelWeights[i] = weights[bestIndex];
+      }
+
+      if (error < bestError) {
+        bestError = error;
+        bestC0 = c0;
+        bestC1 = c1;
+        bestIndices = indices;
+      }
+
+      if (bestError == 0.f || !Gm_RefineEndpoints(texels, 3, texelWeights, e0, e1)) {
+        break;
+      }
+    }
+
+    memcpy(&block[0], &bestC0, 2);
+    memcpy(&block[2], &bestC1, 2);
+    memcpy(&block[4], &bestIndices, 4);
+  }
+
+  static void Gm_DecodeBC1Block(const u8* block, bool isAlwaysFourColor, u8 (*pixels)[4]) {
+    u16 c0, c1;
+    u32 indices;
+    u32 palette[4][4];
+
+    memcpy(&c0, &block[0], 2);
+    memcpy(&c1, &block[2], 2);
+    memcpy(&indices, &block[4], 4);
+
+    Gm_GetBC1Palette(c0, c1, isAlwaysFourColor, palette);
+
+    for (u32 i = 0; i < 16; i++) {
+      u32 index = (indices >> (i * 2)) & 3;
+
+      for (u32 c = 0; c < 4; c++) {
+        pixels[i][c] = (u8)palette[index][c];
+      }
+    }
+  }
+
+  static void Gm_GetBC4Palette(u8 a0, u8 a1, float* palette) {
+    palette[0] = a0;
+    palette[1] = a1;
+
+    if (a0 > a1) {
+      for (u32 i = 2; i < 8; i++) {
+        palette[i] = float(((8 - i) * a0 + (i - 1) * a1) / 7);
+      }
+    } else {
+      for (u32 i = 2; i < 6; i++) {
+        palette[i] = float(((6 - i) * a0 + (i - 1) * a1) / 5);
+      }
+
+      palette[6] = 0.f;
+      palette[7] = 255.f;
+    }
+  }
+
+  /**
+   * Encodes one channel of a block as a BC4 block, using
+   * its eight-value mode between the channel's extremes.
+   */
+  static void Gm_EncodeBC4Block(const float (*texels)[4], u32 channel, u8* block) {
+    float minimum = 255.f;
+    float maximum = 0.f;
+
+    for (u32 i = 0; i < 16; i++) {
+      minimum = std::min(minimum, texels[i][channel]);
+      maximum = std::max(maximum, texels[i][channel]);
+    }
+
+    u8 a0 = (u8)(maximum + 0.5f);
+    u8 a1 = (u8)(minimum + 0.5f);
+    float palette[8];
+    u64 indices = 0;
+
+    Gm_GetBC4Palette(a0, a1, palette);
+
+    if (a0 > a1) {
+      for (u32 i = 0; i < 16; i++) {
+        u64 bestIndex = 0;
+        float bestDistance = FLT_MAX;
+
+        for (u32 p = 0; p < 8; p++) {
+          float distance = fabsf(texels[i][channel] - palette[p]);
+
+          if (distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = p;
+          }
+        }
+
+        indices |= bestIndex << (i * 3);
+      }
+    }
+
+    block[0] = a0;
+    block[1] = a1;
+
+    for (u32 i = 0; i < 6; i++) {
+      block[2 + i] = u8(indices >> (i * 8));
+    }
+  }
+
+  static void Gm_DecodeBC4Block(const u8* block, u32 channel, u8 (*pixels)[4]) {
+    float palette[8];
+    u64 indices = 0;
+
+    Gm_GetBC4Palette(block[0], block[1], palette);
+
+    for (u32 i = 0; i < 6; i++) {
+      indices |= u64(block[2 + i]) << (i * 8);
+    }
+
+    for (u32 i = 0; i < 16; i++) {
+      pixels[i][channel] = (u8)palette[(indices >> (i * 3)) & 7];
+    }
+  }
+
+  static void Gm_WriteBits(u8* block, u32& offset, u32 value, u32 totalBits) {
+    for (u32 i = 0; i < totalBits; i++, offset++) {
+      if ((value >> i) & 1) {
+        block[offset >> 3] |= 1 << (offset & 7);
+      }
+    }
+  }
+
+  static u32 Gm_ReadBits(const u8* block, u32& offset, u32 totalBits) {
+    u32 value = 0;
+
+    for (u32 i = 0; i < totalBits; i++, offset++) {
+      value |= ((block[offset >> 3] >> (offset & 7)) & 1) << i;
+    }
+
+    return value;
+  }
+
+  /**
+   * Quantizes a BC7 mode 6 endpoint to 7 bits per channel plus
+   * a p-bit shared by its channels, choosing the p-bit which
+   * best reproduces the endpoint.
+   */
+  static void Gm_QuantizeBC7Endpoint(const float* endpoint, u32* quantized, u32& pBit) {
+    float bestError = FLT_MAX;
+
+    for (u32 p = 0; p < 2; p++) {
+      u32 candidate[4];
+      float error = 0.f;
+
+      for (u32 c = 0; c < 4; c++) {
+        candidate[c] = (u32)std::clamp((endpoint[c] - p) / 2.f + 0.5f, 0.f, 127.f);
+
+        float delta = float(candidate[c] * 2 + p) - endpoint[c];
+
+        error += delta * delta;
+      }
+
+      if (error < bestError) {
+        bestError = error;
+        pBit = p;
+
+        memcpy(quantized, candidate, sizeof(candidate));
+      }
+    }
+  }
+
+  /**
+   * Encodes a block as BC7 mode 6: a single RGBA endpoint
+   * pair with 4-bit indices, well suited to the smooth
+   * gradients and alpha of color textures.
+   */
+  static void Gm_EncodeBC7Block(const float (*texels)[4], u8* block) {
+    float e0[4];
+    float e1[4];
+    u32 bestEndpoints[2][4];
+    u32 bestPBits[2];
+    u8 bestIndices[16];
+    float bestError = FLT_MAX;
+
+    Gm_FitEndpoints(texels, 4, e0, e1);
+
+    for (u32 iteration = 0; iteration <= ENDPOINT_REFINEMENT_ITERATIONS; iteration++) {
+      u32 endpoints[2][4];
+      u32 pBits[2];
+      u32 values[2][4];
+      u8 indices[16];
+      float texelWeights[16];
+      float error = 0.f;
+
+      Gm_QuantizeBC7Endpoint(e0, endpoints[0], pBits[0]);
+      Gm_QuantizeBC7Endpoint(e1, endpoints[1], pBits[1]);
+
+      for (u32 e = 0; e < 2; e++) {
+        for (u32 c = 0; c < 4; c++) {
+          values[e][c] = endpoints[e][c] * 2 + pBits[e];
+        }
+      }
+
+      for (u32 i = 0; i < 16; i++) {
+        u8 bestIndex = 0;
+        float bestDistance = FLT_MAX;
+
+        for (u8 w = 0; w < 16; w++) {
+          float distance = 0.f;
+
+          for (u32 c = 0; c < 4; c++) {
+            u32 value = ((64 - BC7_WEIGHTS[w]) * values[0][c] + BC7_WEIGHTS[w] * values[1][c] + 32) >> 6;
+            float delta = texels[i][c] - value;
+
+            distance += delta * delta;
+          }
+
+          if (distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = w;
+          }
+        }
+
+        indices[i] = bestIndex;
+        error += bestDistance;
+        texelWeights[i] = BC7_WEIGHTS[bestIndex] / 64.f;
+      }
+
+      if (error < bestError) {
+        bestError = error;
+
+        memcpy(bestEndpoints, endpoints, sizeof(endpoints));
+        memcpy(bestPBits, pBits, sizeof(pBits));
+        memcpy(bestIndices, indices, sizeof(indices));
+      }
+
+      if (bestError == 0.f || !Gm_RefineEndpoints(texels, 4, texelWeights, e0, e1)) {
+        break;
+      }
+    }
+
+    // The first index is stored without its high bit,
+    // so swap the endpoints if that bit would be set
+    if (bestIndices[0] & 8) {
+      std::swap(bestEndpoints[0], bestEndpoints[1]);
+      std::swap(bestPBits[0], bestPBits[1]);
+
+      for (u32 i = 0; i < 16; i++) {
+        bestIndices[i] = 15 - bestIndices[i];
+      }
+    }
+
+    u32 offset = 0;
+
+    memset(block, 0, 16);
+
+    Gm_WriteBits(block, offset, 1 << 6, 7);
+
+    for (u32 c = 0; c < 4; c++) {
+      Gm_WriteBits(block, offset, bestEndpoints[0][c], 7);
+      Gm_WriteBits(block, offset, bestEndpoints[1][c], 7);
+    }
+
+    Gm_WriteBits(block, offset, bestPBits[0], 1);
+    Gm_WriteBits(block, offset, bestPBits[1], 1);
+
+    for (u32 i = 0; i < 16; i++) {
+      Gm_WriteBits(block, offset, bestIndices[i], i == 0 ? 3 : 4);
+    }
+  }
+
+  /**
+   * Decodes a BC7 block. Only mode 6, as produced by
+   * Gm_EncodeBC7Block(), is supported; other modes
+   * decode to transparent black.
+   */
+  static void Gm_DecodeBC7Block(const u8* block, u8 (*pixels)[4]) {
+    u32 offset = 0;
+
+    if (Gm_ReadBits(block, offset, 7) != 1 << 6) {
+      memset(pixels, 0, 64);
+
+      return;
+    }
+
+    u32 values[2][4];
+
+    for (u32 c = 0; c < 4; c++) {
+      values[0][c] = Gm_ReadBits(block, offset, 7) << 1;
+      values[1][c] = Gm_ReadBits(block, offset, 7) << 1;
+    }
+
+    u32 p0 = Gm_ReadBits(block, offset, 1);
+    u32 p1 = Gm_ReadBits(block, offset, 1);
+
+    for (u32 c = 0; c < 4; c++) {
+      values[0][c] |= p0;
+      values[1][c] |= p1;
+    }
+
+    for (u32 i = 0; i < 16; i++) {
+      u32 weight = BC7_WEIGHTS[Gm_ReadBits(block, offset, i == 0 ? 3 : 4)];
+
+      for (u32 c = 0; c < 4; c++) {
+        pixels[i][c] = (u8)(((64 - weight) * values[0][c] + weight * values[1][c] + 32) >> 6);
+      }
+    }
+  }
+
+  inline static u32 Gm_GetBlockSize(BlockFormat format) {
+    return format == BlockFormat::BC1 ? 8 : 16;
+  }
+
+  /**
+   * Gm_GenerateMips
+   * ---------------
+   *
+   * Generates a full mip chain for a texture, down to 1x1.
+   * The first mip is the source texture itself, with normal
+   * maps renormalized. Each subsequent mip is filtered from
+   * the unquantized previous one.
+   */
+  void Gm_GenerateMips(const u8* pixels, u32 width, u32 height, TextureType type, std::vector<TextureMip>& mips) {
+    FloatImage level;
+    FloatImage next;
+
+    Gm_DecodeTexels(pixels, width, height, type, level);
+
+    mips.clear();
+    mips.push_back({ width, height });
+
+    if (type == TextureType::NORMAL) {
+      Gm_EncodeTexels(level, type, mips.back().pixels);
+    } else {
+      mips.back().pixels.assign(pixels, pixels + width * height * 4);
+    }
+
+    while (level.width > 1 || level.height > 1) {
+      Gm_Downsample(level, next);
+
+      std::swap(level, next);
+
+      mips.push_back({ level.width, level.height });
+
+      Gm_EncodeTexels(level, type, mips.back().pixels);
+    }
+  }
+
+  /**
+   * Gm_GetBlockFormat
+   * -----------------
+   *
+   * Chooses the block compression format for a texture,
+   * based on its type and whether it's fully opaque.
+   */
+  BlockFormat Gm_GetBlockFormat(const u8* pixels, u32 width, u32 height, TextureType type) {
+    if (type == TextureType::NORMAL) {
+      return BlockFormat::BC5;
+    }
+
+    bool isOpaque = true;
+
+    for (u32 i = 0; i < width * height; i++) {
+      if (pixels[i * 4 + 3] < 255) {
+        isOpaque = false;
+
+        break;
+      }
+    }
+
+    if (!isOpaque) {
+      // BC7 mode 6 fits color and alpha along a single line,
+      // which suits alpha-tested cutouts poorly compared to
+      // BC3's separately-encoded alpha
+      return BlockFormat::BC3;
+    }
+
+    return type == TextureType::COLOR ? BlockFormat::BC7 : BlockFormat::BC1;
+  }
+
+  u32 Gm_GetCompressedSize(BlockFormat format, u32 width, u32 height) {
+    return ((width + 3) / 4) * ((height + 3) / 4) * Gm_GetBlockSize(format);
+  }
+
+  /**
+   * Gm_CompressTexture
+   * ------------------
+   *
+   * Block-compresses RGBA8 pixels. Blocks overhanging the
+   * edges of the texture repeat its edge pixels.
+   */
+  void Gm_CompressTexture(const u8* pixels, u32 width, u32 height, BlockFormat format, u8* blocks) {
+    u32 blockSize = Gm_GetBlockSize(format);
+    u32 blocksWide = (width + 3) / 4;
+    u32 blocksHigh = (height + 3) / 4;
+    float texels[16][4];
+
+    for (u32 by = 0; by < blocksHigh; by++) {
+      for (u32 bx = 0; bx < blocksWide; bx++) {
+        u8* block = &blocks[(by * blocksWide + bx) * blockSize];
+
+        for (u32 i = 0; i < 16; i++) {
+          u32 x = std::min(bx * 4 + (i % 4), width - 1);
+          u32 y = std::min(by * 4 + (i / 4), height - 1);
+          const u8* pixel = &pixels[(y * width + x) * 4];
+
+          for (u32 c = 0; c < 4; c++) {
+            texels[i][c] = pixel[c];
+          }
+        }
+
+        switch (format) {
+          case BlockFormat::BC1:
+            Gm_EncodeBC1Block(texels, block);
+            break;
+          case BlockFormat::BC3:
+            Gm_EncodeBC4Block(texels, 3, block);
+            Gm_EncodeBC1Block(texels, block + 8);
+            break;
+          case BlockFormat::BC5:
+            Gm_EncodeBC4Block(texels, 0, block);
+            Gm_EncodeBC4Block(texels, 1, block + 8);
+            break;
+          case BlockFormat::BC7:
+            Gm_EncodeBC7Block(texels, block);
+            break;
+        }
+      }
+    }
+  }
+
+  /**
+   * Gm_DecompressTexture
+   * --------------------
+   *
+   * Decodes block-compressed data back into RGBA8 pixels, as a
+   * GPU would. BC5 textures decode with a blue channel of 255.
+   */
+  void Gm_DecompressTexture(const u8* blocks, u32 width, u32 height, BlockFormat format, u8* pixels) {
+    u32 blockSize = Gm_GetBlockSize(format);
+    u32 blocksWide = (width + 3) / 4;
+    u32 blocksHigh = (height + 3) / 4;
+    u8 decoded[16][4];
+
+    for (u32 by = 0; by < blocksHigh; by++) {
+      for (u32 bx = 0; bx < blocksWide; bx++) {
+        const u8* block = &blocks[(by * blocksWide + bx) * blockSize];
+
+        switch (format) {
+          case BlockFormat::BC1:
+            Gm_DecodeBC1Block(block, false, decoded);
+            break;
+          case BlockFormat::BC3:
+            Gm_DecodeBC1Block(block + 8, true, decoded);
+            Gm_DecodeBC4Block(block, 3, decoded);
+            break;
+          case BlockFormat::BC5:
+            memset(decoded, 255, sizeof(decoded));
+            Gm_DecodeBC4Block(block, 0, decoded);
+            Gm_DecodeBC4Block(block + 8, 1, decoded);
+            break;
+          case BlockFormat::BC7:
+            Gm_DecodeBC7Block(block, decoded);
+            break;
+        }
+
+        for (u32 i = 0; i < 16; i++) {
+          u32 x = bx * 4 + (i % 4);
+          u32 y = by * 4 + (i / 4);
+
+          if (x < width && y < height) {
+            memcpy(&pixels[(y * width + x) * 4], decoded[i], 4);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Gm_GetTextureError
+   * ------------------
+   *
+   * Returns the root-mean-square difference between two sets of
+   * RGBA8 pixels, in 8-bit units, over the channels stored by
+   * the given block format.
+   */
+  float Gm_GetTextureError(const u8* a, const u8* b, u32 width, u32 height, BlockFormat format) {
+    u32 channels = format == BlockFormat::BC1 ? 3 : format == BlockFormat::BC5 ? 2 : 4;
+    double error = 0.0;
+
+    for (u32 i = 0; i < width * height; i++) {
+      for (u32 c = 0; c < channels; c++) {
+        double delta = double(a[i * 4 + c]) - double(b[i * 4 + c]);
+
+        error += delta * delta;
+      }
+    }
+
+    return (float)sqrt(error / double(width * height * channels));
+  }
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * TextureType
+   * -----------
+   *
+   * Determines how a texture's mips are filtered, and
+   * which block compression format it's stored in.
+   */
+  enum class TextureType {
+    /**
+     * sRGB-encoded color, e.g. albedo maps. Mips are filtered in
+     * linear space, weighted by alpha. Stored as BC7, or as BC3
+     * when not fully opaque.
+     */
+    COLOR,
+    /**
+     * Tangent-space normal maps. Mips are filtered as vectors
+     * and renormalized. Stored as BC5, keeping only x/y; z is
+     * reconstructed in shaders.
+     */
+    NORMAL,
+    /**
+     * Linear data, e.g. specularity maps. Stored as BC1,
+     * or as BC3 when not fully opaque.
+     */
+    LINEAR
+  };
+
+  enum class BlockFormat {
+    BC1,
+    BC3,
+    BC5,
+    BC7
+  };
+
+  /**
+   * TextureMip
+   * ----------
+   *
+   * A single level of a mip chain, as RGBA8 pixels.
+   */
+  struct TextureMip {
+    u32 width;
+    u32 height;
+    std::vector<u8> pixels;
+  };
+
+  void Gm_GenerateMips(const u8* pixels, u32 width, u32 height, TextureType type, std::vector<TextureMip>& mips);
+  BlockFormat Gm_GetBlockFormat(const u8* pixels, u32 width, u32 height, TextureType type);
+  u32 Gm_GetCompressedSize(BlockFormat format, u32 width, u32 height);
+  void Gm_CompressTexture(const u8* pixels, u32 width, u32 height, BlockFormat format, u8* blocks);
+  void Gm_DecompressTexture(const u8* blocks, u32 width, u32 height, BlockFormat format, u8* pixels);
+  float Gm_GetTextureError(const u8* a, const u8* b, u32 width, u32 height, BlockFormat format);
+}
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "system/console.h"
+#include "system/flags.h"
+#include "system/MappedFile.h"
+#include "system/texture_cooker.h"
+
+#include "SDL.h"
+#include "SDL_image.h"
+
+/**
+ * "GTEX", as little-endian bytes
+ */
+#define GTEX_MAGIC 0x58455447
+/**
+ * Bump whenever the cooked layout, or the mip
+ * filtering/compression of textures, changes
+ */
+#define GTEX_FORMAT_VERSION 1
+
+namespace Gamma {
+  /**
+   * GtexHeader
+   * ----------
+   *
+   * Precedes the contents of a cooked texture file, which are laid out as:
+   *
+   *  [header]
+   *  [CookedTextureMip * totalMips]
+   *  [compressed blocks]
+   */
+  struct GtexHeader {
+    u32 magic = GTEX_MAGIC;
+    u32 version = GTEX_FORMAT_VERSION;
+    u64 sourceHash = 0;
+    u32 type = 0;
+    u32 format = 0;
+    u32 width = 0;
+    u32 height = 0;
+    u32 totalMips = 0;
+    u32 totalBytes = 0;
+  };
+
+  /**
+   * Hashes the contents of a source image (64-bit FNV-1a), so
+   * cooked textures are rebuilt whenever the image changes,
+   * regardless of file timestamps. Returns 0 if the source
+   * can't be read.
+   */
+  static u64 Gm_HashSourceFile(const std::string& path) {
+    MappedFile file(path.c_str());
+
+    if (!file.isOpen()) {
+      return 0;
+    }
+
+    u64 hash = 0xcbf29ce484222325ULL;
+    auto* bytes = (const u8*)file.data();
+
+    for (u64 i = 0; i < file.size(); i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+
+    return hash;
+  }
+
+  /**
+   * Gm_GetCookedTexturePath
+   * -----------------------
+   *
+   * Returns the path to the cooked texture file for
+   * a source image, alongside the source image.
+   */
+  std::string Gm_GetCookedTexturePath(const std::string& sourcePath) {
+    std::filesystem::path path = sourcePath;
+
+    path.replace_extension(".gtex");
+
+    return path.string();
+  }
+
+  /**
+   * Gm_CookTexture
+   * --------------
+   *
+   * Generates the mip chain for a set of RGBA8 pixels,
+   * and block-compresses each mip.
+   */
+  void Gm_CookTexture(const u8* pixels, u32 width, u32 height, TextureType type, CookedTexture& texture) {
+    std::vector<TextureMip> mips;
+
+    Gm_GenerateMips(pixels, width, height, type, mips);
+
+    texture.format = Gm_GetBlockFormat(pixels, width, height, type);
+    texture.width = width;
+    texture.height = height;
+    texture.mips.clear();
+    texture.data.clear();
+
+    for (auto& mip : mips) {
+      u32 offset = (u32)texture.data.size();
+      u32 size = Gm_GetCompressedSize(texture.format, mip.width, mip.height);
+
+      texture.data.resize(offset + size);
+      texture.mips.push_back({ mip.width, mip.height, offset, size });
+
+      Gm_CompressTexture(mip.pixels.data(), mip.width, mip.height, texture.format, &texture.data[offset]);
+    }
+  }
+
+  /**
+   * Gm_LoadCookedTexture
+   * --------------------
+   *
+   * Loads a cooked texture for a source image, if one exists
+   * and was cooked from the current contents of the image as
+   * the given type. Returns false otherwise.
+   */
+  bool Gm_LoadCookedTexture(const std::string& sourcePath, TextureType type, CookedTexture& texture) {
+    auto cookedPath = Gm_GetCookedTexturePath(sourcePath);
+
+    if (!std::filesystem::exists(cookedPath)) {
+      return false;
+    }
+
+    MappedFile file(cookedPath.c_str());
+
+    if (!file.isOpen() || file.size() < sizeof(GtexHeader)) {
+      return false;
+    }
+
+    GtexHeader header;
+
+    memcpy(&header, file.data(), sizeof(GtexHeader));
+
+    u64 mipsOffset = sizeof(GtexHeader);
+    u64 dataOffset = mipsOffset + u64(header.totalMips) * sizeof(CookedTextureMip);
+
+    if (
+      header.magic != GTEX_MAGIC ||
+      header.version != GTEX_FORMAT_VERSION ||
+      header.type != (u32)type ||
+      file.size() != dataOffset + header.totalBytes ||
+      header.sourceHash != Gm_HashSourceFile(sourcePath)
+    ) {
+      return false;
+    }
+
+    auto* mips = (const CookedTextureMip*)(file.data() + mipsOffset);
+    auto* data = (const u8*)(file.data() + dataOffset);
+
+    texture.format = (BlockFormat)header.format;
+    texture.width = header.width;
+    texture.height = header.height;
+    texture.mips.assign(mips, mips + header.totalMips);
+    texture.data.assign(data, data + header.totalBytes);
+
+    return true;
+  }
+
+  /**
+   * Gm_SaveCookedTexture
+   * --------------------
+   *
+   * Writes a texture cooked from a source image to
+   * a cooked texture file.
+   */
+  void Gm_SaveCookedTexture(const std::string& sourcePath, TextureType type, const CookedTexture& texture) {
+    u64 sourceHash = Gm_HashSourceFile(sourcePath);
+
+    if (sourceHash == 0 || texture.mips.size() == 0) {
+      return;
+    }
+
+    auto cookedPath = Gm_GetCookedTexturePath(sourcePath);
+    auto temporaryPath = cookedPath + ".tmp";
+    GtexHeader header;
+
+    header.sourceHash = sourceHash;
+    header.type = (u32)type;
+    header.format = (u32)texture.format;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.totalMips = (u32)texture.mips.size();
+    header.totalBytes = (u32)texture.data.size();
+
+    bool isWritten = false;
+    std::error_code error;
+
+    {
+      std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+      file.write((const char*)&header, sizeof(GtexHeader));
+      file.write((const char*)texture.mips.data(), texture.mips.size() * sizeof(CookedTextureMip));
+      file.write((const char*)texture.data.data(), texture.data.size());
+
+      isWritten = file.good();
+    }
+
+    // Swap in the complete file, so a partially-written
+    // one is never picked up by a later load
+    if (isWritten) {
+      std::filesystem::rename(temporaryPath, cookedPath, error);
+    }
+
+    if (!isWritten || error) {
+      Console::log("[Gamma] Failed to write cooked texture:", cookedPath);
+
+      std::filesystem::remove(temporaryPath, error);
+    }
+  }
+
+  /**
+   * Gm_LoadTexture
+   * --------------
+   *
+   * Loads the cooked version of a source image, cooking and
+   * saving it first if it's missing or out of date. Returns
+   * false if the source image can't be loaded.
+   */
+  bool Gm_LoadTexture(const std::string& sourcePath, TextureType type, CookedTexture& texture) {
+    if (Gm_LoadCookedTexture(sourcePath, type, texture)) {
+      return true;
+    }
+
+    SDL_Surface* source = IMG_Load(sourcePath.c_str());
+
+    if (source == nullptr) {
+      return false;
+    }
+
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+
+    SDL_FreeSurface(source);
+
+    if (surface == nullptr) {
+      return false;
+    }
+
+    u32 width = surface->w;
+    u32 height = surface->h;
+    std::vector<u8> pixels(width * height * 4);
+
+    // Surface rows may be padded
+    for (u32 y = 0; y < height; y++) {
+      memcpy(&pixels[y * width * 4], (const u8*)surface->pixels + y * surface->pitch, width * 4);
+    }
+
+    SDL_FreeSurface(surface);
+
+    Gm_CookTexture(pixels.data(), width, height, type, texture);
+    Gm_SaveCookedTexture(sourcePath, type, texture);
+
+    #if GAMMA_DEVELOPER_MODE
+      const static char* formatNames[] = { "BC1", "BC3", "BC5", "BC7" };
+      std::vector<u8> decoded(pixels.size());
+
+      Gm_DecompressTexture(texture.data.data(), width, height, texture.format, decoded.data());
+
+      Console::log(
+        "[Gamma] Cooked texture:", sourcePath, "|", formatNames[(u32)texture.format],
+        "|", texture.data.size(), "bytes | RMSE", Gm_GetTextureError(pixels.data(), decoded.data(), width, height, texture.format)
+      );
+    #endif
+
+    return true;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "system/texture_compression.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  struct CookedTextureMip {
+    u32 width;
+    u32 height;
+    /**
+     * Location of the mip's blocks within CookedTexture::data
+     */
+    u32 offset;
+    u32 size;
+  };
+
+  /**
+   * CookedTexture
+   * -------------
+   *
+   * A block-compressed texture with a full mip chain,
+   * ready for upload.
+   */
+  struct CookedTexture {
+    BlockFormat format;
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<CookedTextureMip> mips;
+    std::vector<u8> data;
+  };
+
+  std::string Gm_GetCookedTexturePath(const std::string& sourcePath);
+  void Gm_CookTexture(const u8* pixels, u32 width, u32 height, TextureType type, CookedTexture& texture);
+  bool Gm_LoadCookedTexture(const std::string& sourcePath, TextureType type, CookedTexture& texture);
+  void Gm_SaveCookedTexture(const std::string& sourcePath, TextureType type, const CookedTexture& texture);
+  bool Gm_LoadTexture(const std::string& sourcePath, TextureType type, CookedTexture& texture);
+}
\ No newline at end of file
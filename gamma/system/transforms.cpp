@@ -0,0 +1,153 @@
+#include <immintrin.h>
+
+#include "system/transforms.h"
+
+namespace Gamma {
+  /**
+   * Computes the sine and cosine of 4 angles at once. Angles are
+   * reduced to [-pi/4, pi/4] around the nearest quarter turn, and
+   * then approximated with Taylor polynomials, for an absolute
+   * error of roughly 1e-7 within the range of typical rotations.
+   */
+  static void Gm_SinCos4(__m128 angle, __m128& sin, __m128& cos) {
+    const __m128 twoOverPi = _mm_set1_ps(0.63661977f);
+    // pi/2, split into parts to limit precision loss in the reduction
+    const __m128 halfPiA = _mm_set1_ps(1.5703125f);
+    const __m128 halfPiB = _mm_set1_ps(4.8351287e-4f);
+    const __m128 halfPiC = _mm_set1_ps(3.1385570e-7f);
+
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angle, twoOverPi));
+    __m128 q = _mm_cvtepi32_ps(quadrant);
+
+    __m128 r = _mm_sub_ps(angle, _mm_mul_ps(q, halfPiA));
+
+    r = _mm_sub_ps(r, _mm_mul_ps(q, halfPiB));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, halfPiC));
+
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    // sin(r) ~ r - r^3/3! + r^5/5! - r^7/7!
+    __m128 s = _mm_set1_ps(-1.f / 5040.f);
+
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(1.f / 120.f));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(-1.f / 6.f));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(1.f));
+    s = _mm_mul_ps(s, r);
+
+    // cos(r) ~ 1 - r^2/2! + r^4/4! - r^6/6! + r^8/8!
+    __m128 c = _mm_set1_ps(1.f / 40320.f);
+
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(-1.f / 720.f));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(1.f / 24.f));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(-0.5f));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(1.f));
+
+    // Map back to the original quadrant:
+    // 0: (s, c), 1: (c, -s), 2: (-s, -c), 3: (-c, s)
+    __m128i quadrantBits = _mm_and_si128(quadrant, _mm_set1_epi32(3));
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrantBits, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(quadrantBits, 1), 31));
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_xor_si128(_mm_srli_epi32(quadrantBits, 1), _mm_and_si128(quadrantBits, _mm_set1_epi32(1))), 31));
+
+    sin = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sinSign);
+    cos = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosSign);
+  }
+
+  static inline __m128 Gm_Gather4(const float* values, const u32* i) {
+    return _mm_set_ps(values[i[3]], values[i[2]], values[i[1]], values[i[0]]);
+  }
+
+  void Gm_ComputeTransformsGL(const Vec3fStream& positions, const Vec3fStream& scales, const Vec3fStream& rotations, const u32* indices, u32 total, Matrix4f* matrices) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (u32 i = 0; i < total; i += 4) {
+      u32 lanes[4];
+
+      // Pad out the final group by repeating its last index,
+      // which just recomputes the same matrix more than once
+      for (u32 lane = 0; lane < 4; lane++) {
+        lanes[lane] = indices[i + lane < total ? i + lane : total - 1];
+      }
+
+      __m128 sinPitch, cosPitch, sinYaw, cosYaw, sinRoll, cosRoll;
+
+      Gm_SinCos4(_mm_mul_ps(Gm_Gather4(rotations.x, lanes), half), sinPitch, cosPitch);
+      Gm_SinCos4(_mm_mul_ps(Gm_Gather4(rotations.y, lanes), half), sinYaw, cosYaw);
+      Gm_SinCos4(_mm_mul_ps(Gm_Gather4(rotations.z, lanes), half), sinRoll, cosRoll);
+
+      // roll * pitch
+      __m128 rpw = _mm_mul_ps(cosRoll, cosPitch);
+      __m128 rpx = _mm_mul_ps(cosRoll, sinPitch);
+      __m128 rpy = _mm_mul_ps(sinRoll, sinPitch);
+      __m128 rpz = _mm_mul_ps(sinRoll, cosPitch);
+
+      // (roll * pitch) * yaw
+      __m128 w = _mm_sub_ps(_mm_mul_ps(rpw, cosYaw), _mm_mul_ps(rpy, sinYaw));
+      __m128 x = _mm_sub_ps(_mm_mul_ps(rpx, cosYaw), _mm_mul_ps(rpz, sinYaw));
+      __m128 y = _mm_add_ps(_mm_mul_ps(rpw, sinYaw), _mm_mul_ps(rpy, cosYaw));
+      __m128 z = _mm_add_ps(_mm_mul_ps(rpx, sinYaw), _mm_mul_ps(rpz, cosYaw));
+
+      __m128 xx = _mm_mul_ps(two, _mm_mul_ps(x, x));
+      __m128 yy = _mm_mul_ps(two, _mm_mul_ps(y, y));
+      __m128 zz = _mm_mul_ps(two, _mm_mul_ps(z, z));
+      __m128 xy = _mm_mul_ps(two, _mm_mul_ps(x, y));
+      __m128 xz = _mm_mul_ps(two, _mm_mul_ps(x, z));
+      __m128 yz = _mm_mul_ps(two, _mm_mul_ps(y, z));
+      __m128 xw = _mm_mul_ps(two, _mm_mul_ps(x, w));
+      __m128 yw = _mm_mul_ps(two, _mm_mul_ps(y, w));
+      __m128 zw = _mm_mul_ps(two, _mm_mul_ps(z, w));
+
+      __m128 sx = Gm_Gather4(scales.x, lanes);
+      __m128 sy = Gm_Gather4(scales.y, lanes);
+      __m128 sz = Gm_Gather4(scales.z, lanes);
+
+      // Columns of rotation * scale, i.e. consecutive
+      // elements of the matrix in column-major order
+      __m128 m0 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+      __m128 m1 = _mm_mul_ps(_mm_add_ps(xy, zw), sx);
+      __m128 m2 = _mm_mul_ps(_mm_sub_ps(xz, yw), sx);
+      __m128 m3 = zero;
+
+      __m128 m4 = _mm_mul_ps(_mm_sub_ps(xy, zw), sy);
+      __m128 m5 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+      __m128 m6 = _mm_mul_ps(_mm_add_ps(yz, xw), sy);
+      __m128 m7 = zero;
+
+      __m128 m8 = _mm_mul_ps(_mm_add_ps(xz, yw), sz);
+      __m128 m9 = _mm_mul_ps(_mm_sub_ps(yz, xw), sz);
+      __m128 m10 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+      __m128 m11 = zero;
+
+      __m128 m12 = Gm_Gather4(positions.x, lanes);
+      __m128 m13 = Gm_Gather4(positions.y, lanes);
+      __m128 m14 = Gm_Gather4(positions.z, lanes);
+      __m128 m15 = one;
+
+      // Transpose from one register per matrix element
+      // to one register per matrix column, per object
+      _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+      _MM_TRANSPOSE4_PS(m4, m5, m6, m7);
+      _MM_TRANSPOSE4_PS(m8, m9, m10, m11);
+      _MM_TRANSPOSE4_PS(m12, m13, m14, m15);
+
+      __m128 columns[4][4] = {
+        { m0, m4, m8, m12 },
+        { m1, m5, m9, m13 },
+        { m2, m6, m10, m14 },
+        { m3, m7, m11, m15 }
+      };
+
+      for (u32 lane = 0; lane < 4; lane++) {
+        float* m = matrices[lanes[lane]].m;
+
+        _mm_storeu_ps(m, columns[lane][0]);
+        _mm_storeu_ps(m + 4, columns[lane][1]);
+        _mm_storeu_ps(m + 8, columns[lane][2]);
+        _mm_storeu_ps(m + 12, columns[lane][3]);
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "math/matrix.h"
+#include "system/ObjectPool.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * Gm_ComputeTransformsGL
+   * ----------------------
+   *
+   * Computes object transformation matrices from position, scale
+   * and rotation streams for a list of object indices, equivalent
+   * to Matrix4f::transformation(position, scale, rotation), and
+   * writes them to the matrix array in GL (column-major) layout.
+   *
+   * Objects are processed 4 at a time with SSE, including the
+   * sines/cosines of their rotation angles. Calls operating on
+   * disjoint sets of indices can safely run in parallel.
+   */
+  void Gm_ComputeTransformsGL(const Vec3fStream& positions, const Vec3fStream& scales, const Vec3fStream& rotations, const u32* indices, u32 total, Matrix4f* matrices);
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <cstring>
+#include <math.h>
+
+#include "math/constants.h"
+#include "system/vertex_quantization.h"
+
+#define MAX_U16 65535.f
+#define MAX_S8 127.f
+/**
+ * Largest angle error permitted for octahedral-encoded
+ * vectors, in degrees. 8-bit components with best-fit
+ * rounding stay within ~0.65 degrees of the source.
+ */
+#define MAX_OCTAHEDRAL_ERROR 1.f
+/**
+ * Largest relative error permitted for half-float UVs;
+ * half floats have an 11-bit significand, so rounding
+ * introduces a relative error of at most 2^-11.
+ */
+#define MAX_HALF_FLOAT_ERROR (1.f / 2048.f)
+
+namespace Gamma {
+  inline static float Gm_SignNotZero(float value) {
+    return value >= 0.f ? 1.f : -1.f;
+  }
+
+  inline static float Gm_GetAngleBetween(const Vec3f& a, const Vec3f& b) {
+    float cosine = Vec3f::dot(a.unit(), b.unit());
+
+    return acosf(std::min(std::max(cosine, -1.f), 1.f)) / DEGREES_TO_RADIANS;
+  }
+
+  /**
+   * Converts a float to a half float, rounding to nearest even.
+   */
+  u16 Gm_FloatToHalf(float value) {
+    u32 bits;
+
+    memcpy(&bits, &value, sizeof(float));
+
+    u32 sign = (bits >> 16) & 0x8000;
+    u32 exponent = (bits >> 23) & 0xFF;
+    u32 mantissa = bits & 0x7FFFFF;
+    s32 halfExponent = s32(exponent) - 127 + 15;
+
+    if (exponent == 0xFF) {
+      // Infinity/NaN
+      return u16(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+    }
+
+    if (halfExponent >= 31) {
+      // Overflow to infinity
+      return u16(sign | 0x7C00);
+    }
+
+    if (halfExponent <= 0) {
+      // Subnormal half float, or zero
+      if (halfExponent < -10) {
+        return u16(sign);
+      }
+
+      mantissa |= 0x800000;
+
+      u32 shift = u32(14 - halfExponent);
+      u32 half = mantissa >> shift;
+      u32 remainder = mantissa & ((1 << shift) - 1);
+      u32 halfway = 1 << (shift - 1);
+
+      if (remainder > halfway || (remainder == halfway && (half & 1))) {
+        half++;
+      }
+
+      return u16(sign | half);
+    }
+
+    u32 half = (u32(halfExponent) << 10) | (mantissa >> 13);
+    u32 remainder = mantissa & 0x1FFF;
+
+    // Rounding may carry into the exponent, which
+    // correctly rounds up to the next power of two
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+      half++;
+    }
+
+    return u16(sign | half);
+  }
+
+  float Gm_HalfToFloat(u16 half) {
+    u32 sign = u32(half & 0x8000) << 16;
+    u32 exponent = (half >> 10) & 0x1F;
+    u32 mantissa = half & 0x3FF;
+    u32 bits;
+
+    if (exponent == 0) {
+      if (mantissa == 0) {
+        bits = sign;
+      } else {
+        // Normalize subnormal half floats
+        exponent = 127 - 14;
+
+        while ((mantissa & 0x400) == 0) {
+          mantissa <<= 1;
+          exponent--;
+        }
+
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+      }
+    } else if (exponent == 31) {
+      bits = sign | 0x7F800000 | (mantissa << 13);
+    } else {
+      bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float value;
+
+    memcpy(&value, &bits, sizeof(float));
+
+    return value;
+  }
+
+  /**
+   * Encodes a direction as a point on an octahedron unfolded
+   * onto a square, using 8-bit signed normalized components.
+   * Each rounding direction of the two components is tried,
+   * keeping the one which decodes closest to the source.
+   */
+  void Gm_EncodeOctahedral(const Vec3f& vector, s8* encoded) {
+    float length = fabsf(vector.x) + fabsf(vector.y) + fabsf(vector.z);
+
+    if (length == 0.f) {
+      encoded[0] = 0;
+      encoded[1] = 0;
+
+      return;
+    }
+
+    float x = vector.x / length;
+    float y = vector.y / length;
+
+    if (vector.z < 0.f) {
+      // Fold the lower hemisphere over the diagonals
+      float foldedX = (1.f - fabsf(y)) * Gm_SignNotZero(x);
+      float foldedY = (1.f - fabsf(x)) * Gm_SignNotZero(y);
+
+      x = foldedX;
+      y = foldedY;
+    }
+
+    Vec3f direction = vector.unit();
+    float bestCosine = -2.f;
+
+    for (u32 i = 0; i < 4; i++) {
+      float qx = (i & 1) ? ceilf(x * MAX_S8) : floorf(x * MAX_S8);
+      float qy = (i & 2) ? ceilf(y * MAX_S8) : floorf(y * MAX_S8);
+      s8 candidate[2] = {
+        s8(std::min(std::max(qx, -MAX_S8), MAX_S8)),
+        s8(std::min(std::max(qy, -MAX_S8), MAX_S8))
+      };
+
+      float cosine = Vec3f::dot(Gm_DecodeOctahedral(candidate), direction);
+
+      if (cosine > bestCosine) {
+        bestCosine = cosine;
+        encoded[0] = candidate[0];
+        encoded[1] = candidate[1];
+      }
+    }
+  }
+
+  /**
+   * Decodes an octahedral-encoded direction, matching
+   * the decoding in shaders/utils/vertex.glsl.
+   */
+  Vec3f Gm_DecodeOctahedral(const s8* encoded) {
+    float x = std::max(encoded[0] / MAX_S8, -1.f);
+    float y = std::max(encoded[1] / MAX_S8, -1.f);
+    Vec3f vector = Vec3f(x, y, 1.f - fabsf(x) - fabsf(y));
+
+    if (vector.z < 0.f) {
+      vector.x = (1.f - fabsf(y)) * Gm_SignNotZero(x);
+      vector.y = (1.f - fabsf(x)) * Gm_SignNotZero(y);
+    }
+
+    return vector.unit();
+  }
+
+  QuantizedVertex Gm_QuantizeVertex(const Vertex& vertex, const Vec3f& minimum, const Vec3f& extent) {
+    QuantizedVertex quantized;
+    const float* position = &vertex.position.x;
+    const float* min = &minimum.x;
+    const float* size = &extent.x;
+
+    for (u32 i = 0; i < 3; i++) {
+      float alpha = size[i] > 0.f ? (position[i] - min[i]) / size[i] : 0.f;
+
+      quantized.position[i] = u16(std::min(std::max(alpha, 0.f), 1.f) * MAX_U16 + 0.5f);
+    }
+
+    quantized.padding = 0;
+    quantized.uv[0] = Gm_FloatToHalf(vertex.uv.x);
+    quantized.uv[1] = Gm_FloatToHalf(vertex.uv.y);
+
+    Gm_EncodeOctahedral(vertex.normal, quantized.normal);
+    Gm_EncodeOctahedral(vertex.tangent, quantized.tangent);
+
+    return quantized;
+  }
+
+  Vertex Gm_DequantizeVertex(const QuantizedVertex& quantized, const Vec3f& minimum, const Vec3f& extent) {
+    Vertex vertex;
+
+    vertex.position.x = minimum.x + quantized.position[0] / MAX_U16 * extent.x;
+    vertex.position.y = minimum.y + quantized.position[1] / MAX_U16 * extent.y;
+    vertex.position.z = minimum.z + quantized.position[2] / MAX_U16 * extent.z;
+    vertex.normal = Gm_DecodeOctahedral(quantized.normal);
+    vertex.tangent = Gm_DecodeOctahedral(quantized.tangent);
+    vertex.uv.x = Gm_HalfToFloat(quantized.uv[0]);
+    vertex.uv.y = Gm_HalfToFloat(quantized.uv[1]);
+
+    return vertex;
+  }
+
+  /**
+   * Gm_QuantizeVertices
+   * -------------------
+   *
+   * Encodes vertices as QuantizedVertices, normalizing their
+   * positions to the provided bounds. Positions outside of
+   * the bounds are clamped.
+   */
+  void Gm_QuantizeVertices(const Vertex* vertices, u32 total, const Vec3f& minimum, const Vec3f& maximum, std::vector<QuantizedVertex>& quantized) {
+    Vec3f extent = maximum - minimum;
+
+    quantized.resize(total);
+
+    for (u32 i = 0; i < total; i++) {
+      quantized[i] = Gm_QuantizeVertex(vertices[i], minimum, extent);
+    }
+  }
+
+  /**
+   * Gm_MeasureQuantizationError
+   * ---------------------------
+   *
+   * Decodes quantized vertices and compares them against their
+   * sources. Zero-length normals/tangents are not measured.
+   */
+  VertexQuantizationError Gm_MeasureQuantizationError(const Vertex* vertices, const QuantizedVertex* quantized, u32 total, const Vec3f& minimum, const Vec3f& maximum) {
+    VertexQuantizationError error;
+    Vec3f extent = maximum - minimum;
+
+    for (u32 i = 0; i < total; i++) {
+      auto& source = vertices[i];
+      auto decoded = Gm_DequantizeVertex(quantized[i], minimum, extent);
+
+      error.position = std::max(error.position, fabsf(decoded.position.x - source.position.x));
+      error.position = std::max(error.position, fabsf(decoded.position.y - source.position.y));
+      error.position = std::max(error.position, fabsf(decoded.position.z - source.position.z));
+
+      if (source.normal.magnitude() > 0.f) {
+        error.normal = std::max(error.normal, Gm_GetAngleBetween(decoded.normal, source.normal));
+      }
+
+      if (source.tangent.magnitude() > 0.f) {
+        error.tangent = std::max(error.tangent, Gm_GetAngleBetween(decoded.tangent, source.tangent));
+      }
+
+      error.uv = std::max(error.uv, fabsf(decoded.uv.x - source.uv.x) / std::max(fabsf(source.uv.x), 1.f));
+      error.uv = std::max(error.uv, fabsf(decoded.uv.y - source.uv.y) / std::max(fabsf(source.uv.y), 1.f));
+    }
+
+    return error;
+  }
+
+  /**
+   * Determines whether measured quantization errors are within
+   * the expected bounds of each encoding: half a 16-bit step of
+   * the bounds on each position axis (with a margin for float
+   * rounding), the octahedral encoding limit for normals and
+   * tangents, and half-float precision for UVs.
+   */
+  bool Gm_IsWithinQuantizationBounds(const VertexQuantizationError& error, const Vec3f& minimum, const Vec3f& maximum) {
+    Vec3f extent = maximum - minimum;
+    float largestExtent = std::max(std::max(extent.x, extent.y), extent.z);
+    float largestCoordinate = std::max(minimum.magnitude(), maximum.magnitude());
+    float positionBound = largestExtent / MAX_U16 * 0.5f + largestCoordinate * 1e-6f;
+
+    return (
+      error.position <= positionBound &&
+      error.normal <= MAX_OCTAHEDRAL_ERROR &&
+      error.tangent <= MAX_OCTAHEDRAL_ERROR &&
+      error.uv <= MAX_HALF_FLOAT_ERROR
+    );
+  }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include "math/geometry.h"
+#include "math/vector.h"
+#include "system/type_aliases.h"
+
+namespace Gamma {
+  /**
+   * QuantizedVertex
+   * ---------------
+   *
+   * A compact, 16-byte encoding of a Vertex. Positions are
+   * normalized to the bounds of their mesh, normals/tangents
+   * are octahedral-encoded, and UVs are stored as half floats.
+   */
+  struct QuantizedVertex {
+    u16 position[3];
+    u16 padding;
+    s8 normal[2];
+    s8 tangent[2];
+    u16 uv[2];
+  };
+
+  /**
+   * VertexQuantizationError
+   * -----------------------
+   *
+   * The largest differences between source vertices and their
+   * decoded QuantizedVertex equivalents, for each attribute.
+   */
+  struct VertexQuantizationError {
+    /**
+     * Largest per-axis position error, in model space.
+     */
+    float position = 0.f;
+    /**
+     * Largest normal angle error, in degrees.
+     */
+    float normal = 0.f;
+    /**
+     * Largest tangent angle error, in degrees.
+     */
+    float tangent = 0.f;
+    /**
+     * Largest UV coordinate error, relative to the
+     * magnitude of the coordinate (or 1, if smaller).
+     */
+    float uv = 0.f;
+  };
+
+  u16 Gm_FloatToHalf(float value);
+  float Gm_HalfToFloat(u16 half);
+  void Gm_EncodeOctahedral(const Vec3f& vector, s8* encoded);
+  Vec3f Gm_DecodeOctahedral(const s8* encoded);
+  QuantizedVertex Gm_QuantizeVertex(const Vertex& vertex, const Vec3f& minimum, const Vec3f& extent);
+  Vertex Gm_DequantizeVertex(const QuantizedVertex& vertex, const Vec3f& minimum, const Vec3f& extent);
+  void Gm_QuantizeVertices(const Vertex* vertices, u32 total, const Vec3f& minimum, const Vec3f& maximum, std::vector<QuantizedVertex>& quantized);
+  VertexQuantizationError Gm_MeasureQuantizationError(const Vertex* vertices, const QuantizedVertex* quantized, u32 total, const Vec3f& minimum, const Vec3f& maximum);
+  bool Gm_IsWithinQuantizationBounds(const VertexQuantizationError& error, const Vec3f& minimum, const Vec3f& maximum);
+}
\ No newline at end of file